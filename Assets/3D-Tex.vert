@@ -7,7 +7,12 @@ out vec4 fColor;
 out vec2 fUV1;
 
 // Built-in uniforms
-uniform mat4 gWorldToProjMatrix;
+layout(std140) uniform FrameUniforms
+{
+    mat4 gViewMatrix;
+    mat4 gProjMatrix;
+    mat4 gWorldToProjMatrix;
+};
 uniform mat4 gObjectToWorldMatrix;
 
 void main()
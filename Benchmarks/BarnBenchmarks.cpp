@@ -0,0 +1,203 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for Barn (asset bundle) loading - reading the asset directory, and extracting/decompressing assets.
+//
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "minilzo.h"
+#include "zlib.h"
+
+#include "BarnFile.h"
+
+namespace
+{
+    const uint32_t kAssetCount = 300;
+    const uint32_t kAssetSize = 64 * 1024;
+
+    std::string GetAssetName(CompressionType compressionType, uint32_t index)
+    {
+        const char* prefix = compressionType == CompressionType::Zlib ? "ZLIB" : (compressionType == CompressionType::Lzo ? "LZO" : "RAW");
+        return prefix + std::to_string(index) + ".DAT";
+    }
+
+    // Compresses data the way it's stored in a Barn: an 8-byte header (holding the decompressed size), then the compressed data.
+    std::vector<uint8_t> Compress(const std::vector<uint8_t>& data, CompressionType compressionType, uint32_t& outCompressedSize)
+    {
+        std::vector<uint8_t> compressed(data.size() + data.size() / 16 + 64 + 3 + 8);
+        uint32_t size = static_cast<uint32_t>(data.size());
+        memcpy(compressed.data(), &size, sizeof(size));
+        if(compressionType == CompressionType::Zlib)
+        {
+            uLongf zlibSize = static_cast<uLongf>(compressed.size() - 8);
+            compress(compressed.data() + 8, &zlibSize, data.data(), data.size());
+            outCompressedSize = static_cast<uint32_t>(zlibSize);
+        }
+        else
+        {
+            static const bool initLzo = (lzo_init() == LZO_E_OK);
+            std::vector<uint8_t> workMemory(LZO1X_1_MEM_COMPRESS);
+            lzo_uint lzoSize = 0;
+            if(initLzo)
+            {
+                lzo1x_1_compress(data.data(), data.size(), compressed.data() + 8, &lzoSize, workMemory.data());
+            }
+            outCompressedSize = static_cast<uint32_t>(lzoSize);
+        }
+        compressed.resize(8 + outCompressedSize);
+        return compressed;
+    }
+
+    // Writes a Barn to disk with an equal number of uncompressed, zlib, and LZO assets. The file is deleted on exit.
+    struct TempBarn
+    {
+        std::string filePath = "Benchmark.brn";
+        std::vector<std::string> assetNames;
+
+        TempBarn()
+        {
+            // Build each asset's directory entry and stored data.
+            ByteBuilder directory;
+            ByteBuilder data;
+            const CompressionType kTypes[] = { CompressionType::None, CompressionType::Zlib, CompressionType::Lzo };
+            for(uint32_t i = 0; i < kAssetCount; ++i)
+            {
+                CompressionType compressionType = kTypes[i % 3];
+                std::vector<uint8_t> assetBytes = BenchmarkData::MakeAssetBytes(kAssetSize, i);
+                uint32_t storedSize = kAssetSize;
+                if(compressionType != CompressionType::None)
+                {
+                    assetBytes = Compress(assetBytes, compressionType, storedSize);
+                }
+
+                std::string name = GetAssetName(compressionType, i);
+                assetNames.push_back(name);
+                directory.WriteUInt(storedSize);
+                directory.WriteUInt(data.GetSize());
+                directory.WriteString("", 5);
+                directory.WriteByte(static_cast<uint8_t>(compressionType));
+                directory.WriteByte(static_cast<uint8_t>(name.size()));
+                directory.WriteString(name, static_cast<uint32_t>(name.size()) + 1);
+                for(uint8_t byte : assetBytes)
+                {
+                    data.WriteByte(byte);
+                }
+            }
+
+            // Header, with the table of contents offset filled in once known.
+            ByteBuilder barn;
+            barn.WriteUInt(0x21334B47); // GK3!
+            barn.WriteUInt(0x6E726142); // Barn
+            barn.WriteUInt(65536);
+            barn.WriteUInt(65536);
+            barn.WriteUInt(0);
+            uint32_t tocOffsetPosition = barn.GetSize();
+            barn.WriteUInt(0);
+
+            // Directory header (an empty Barn name means the assets are in this Barn), followed by the directory itself.
+            uint32_t directoryHeaderOffset = barn.GetSize();
+            barn.WriteString("", 32);
+            barn.WriteString("", 48);
+            barn.WriteUInt(kAssetCount);
+            uint32_t directoryOffset = barn.GetSize();
+            for(uint8_t byte : directory.GetBytes())
+            {
+                barn.WriteByte(byte);
+            }
+
+            // Table of contents: one directory entry, and the location of the asset data.
+            uint32_t dataOffset = barn.GetSize() + 4 + 2 * 28;
+            barn.PatchUInt(tocOffsetPosition, barn.GetSize());
+            barn.WriteUInt(2);
+            barn.WriteUInt(0x44446972); // DDir
+            barn.WriteString("", 16);
+            barn.WriteUInt(directoryHeaderOffset);
+            barn.WriteUInt(directoryOffset);
+            barn.WriteUInt(0x44617461); // Data
+            barn.WriteString("", 16);
+            barn.WriteUInt(dataOffset);
+            barn.WriteUInt(0);
+            for(uint8_t byte : data.GetBytes())
+            {
+                barn.WriteByte(byte);
+            }
+
+            std::ofstream file(filePath, std::ios::out | std::ios::binary);
+            file.write(reinterpret_cast<const char*>(barn.GetBytes().data()), barn.GetSize());
+        }
+
+        ~TempBarn()
+        {
+            std::remove(filePath.c_str());
+        }
+    };
+
+    TempBarn& GetTempBarn()
+    {
+        static TempBarn tempBarn;
+        return tempBarn;
+    }
+
+    void MeasureCreateAssetBuffer(Benchmark& bench, CompressionType compressionType)
+    {
+        BarnFile barn(GetTempBarn().filePath);
+        std::vector<std::string> names;
+        for(uint32_t i = 0; i < kAssetCount; ++i)
+        {
+            if(barn.GetAsset(GetAssetName(compressionType, i)) != nullptr)
+            {
+                names.push_back(GetAssetName(compressionType, i));
+            }
+        }
+
+        size_t index = 0;
+        bench.Measure([&]() {
+            AssetBuffer buffer = barn.CreateAssetBuffer(names[index % names.size()]);
+            Benchmark::KeepAlive(buffer.GetData());
+            ++index;
+        });
+    }
+}
+
+BENCHMARK_MACRO("Barn/Open (300 assets)")
+{
+    const std::string& filePath = GetTempBarn().filePath;
+    bench.Measure([&]() {
+        BarnFile barn(filePath);
+        Benchmark::KeepAlive(barn.GetAssets().size());
+    });
+}
+
+BENCHMARK_MICRO("Barn/CreateAssetBuffer Uncompressed 64KB")
+{
+    MeasureCreateAssetBuffer(bench, CompressionType::None);
+}
+
+BENCHMARK_MICRO("Barn/CreateAssetBuffer Zlib 64KB")
+{
+    MeasureCreateAssetBuffer(bench, CompressionType::Zlib);
+}
+
+BENCHMARK_MICRO("Barn/CreateAssetBuffer LZO 64KB")
+{
+    MeasureCreateAssetBuffer(bench, CompressionType::Lzo);
+}
+
+BENCHMARK_MACRO("Barn/ExtractMany (300 assets)")
+{
+    BarnFile barn(GetTempBarn().filePath);
+    const std::vector<std::string>& names = GetTempBarn().assetNames;
+    bench.Measure([&]() {
+        std::atomic<uint32_t> totalSize { 0 };
+        barn.ExtractMany(names, [&totalSize](const std::string& name, AssetBuffer& buffer) {
+            totalSize += buffer.GetSize();
+        });
+        Benchmark::KeepAlive(totalSize);
+    });
+}
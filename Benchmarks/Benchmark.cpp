@@ -0,0 +1,290 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+bool Benchmark::sQuick = false;
+
+namespace
+{
+    uint64_t GetTicks()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Times one sample of the operation - that is, running the operation "count" times in a row.
+    uint64_t TimeSample(const std::function<void()>& operation, uint64_t count)
+    {
+        uint64_t startTicks = GetTicks();
+        for(uint64_t i = 0; i < count; ++i)
+        {
+            operation();
+        }
+        return GetTicks() - startTicks;
+    }
+
+    const char* GetKindName(Benchmark::Kind kind)
+    {
+        return kind == Benchmark::Kind::Micro ? "micro" : "macro";
+    }
+
+    void WriteEscaped(std::stringstream& ss, const std::string& str)
+    {
+        for(char c : str)
+        {
+            if(c == '"' || c == '\\')
+            {
+                ss << '\\';
+            }
+            ss << c;
+        }
+    }
+
+    std::string ToJson(const std::vector<Benchmark::Result>& results)
+    {
+        std::stringstream ss;
+        ss << "{\n  \"benchmarks\": [";
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            const Benchmark::Result& result = results[i];
+
+            char times[128];
+            snprintf(times, sizeof(times), "\"min_ns\": %.2f, \"median_ns\": %.2f, \"mean_ns\": %.2f", result.minNs, result.medianNs, result.meanNs);
+
+            ss << (i == 0 ? "\n" : ",\n") << "    { \"name\": \"";
+            WriteEscaped(ss, result.name);
+            ss << "\", \"kind\": \"" << GetKindName(result.kind) << "\", \"samples\": " << result.sampleCount
+               << ", \"ops_per_sample\": " << result.opsPerSample << ", " << times << " }";
+        }
+        ss << "\n  ]\n}\n";
+        return ss.str();
+    }
+
+    // Reads the median time of each benchmark from a JSON file written by ToJson.
+    // This isn't a general JSON parser - it only needs to understand the files we write ourselves.
+    bool ReadBaseline(const std::string& filePath, std::unordered_map<std::string, double>& outMedians)
+    {
+        std::ifstream file(filePath);
+        if(!file.good()) { return false; }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string json = buffer.str();
+
+        const std::string kNameKey = "\"name\": \"";
+        const std::string kMedianKey = "\"median_ns\": ";
+        size_t pos = 0;
+        while((pos = json.find(kNameKey, pos)) != std::string::npos)
+        {
+            // Read the name, taking escaped characters into account.
+            pos += kNameKey.size();
+            std::string name;
+            while(pos < json.size() && json[pos] != '"')
+            {
+                if(json[pos] == '\\') { ++pos; }
+                if(pos < json.size()) { name.push_back(json[pos]); }
+                ++pos;
+            }
+
+            // The median follows the name, within the same object.
+            size_t medianPos = json.find(kMedianKey, pos);
+            size_t objectEnd = json.find('}', pos);
+            if(medianPos == std::string::npos || medianPos > objectEnd) { continue; }
+            outMedians[name] = std::strtod(json.c_str() + medianPos + kMedianKey.size(), nullptr);
+            pos = objectEnd;
+        }
+        return true;
+    }
+
+    void PrintUsage()
+    {
+        printf("Usage: benchmarks [options]\n");
+        printf("  --filter <text>      Only run benchmarks whose names contain the text.\n");
+        printf("  --list               List benchmarks without running them.\n");
+        printf("  --quick              Take far fewer samples (checks that benchmarks run, timings are rough).\n");
+        printf("  --json <file>        Write results to a JSON file.\n");
+        printf("  --baseline <file>    Compare results to a JSON file from an earlier run.\n");
+        printf("  --threshold <pct>    Percent slower than baseline that counts as a regression (default 10).\n");
+    }
+}
+
+Benchmark::Benchmark(const char* name, Kind kind, void (*function)(Benchmark&)) :
+    mName(name),
+    mKind(kind),
+    mFunction(function)
+{
+    GetAll().push_back(this);
+}
+
+void Benchmark::Measure(const std::function<void()>& operation)
+{
+    // Micro operations are batched, so a sample is long enough for timer resolution and overhead not to matter.
+    // Start with one operation per sample, and double it until a sample takes long enough.
+    uint64_t opsPerSample = 1;
+    if(mKind == Kind::Micro)
+    {
+        const uint64_t kMinSampleNs = sQuick ? 100000 : 2000000;
+        const uint64_t kMaxOpsPerSample = 1ULL << 30;
+        while(TimeSample(operation, opsPerSample) < kMinSampleNs && opsPerSample < kMaxOpsPerSample)
+        {
+            opsPerSample *= 2;
+        }
+    }
+    else
+    {
+        // Warm up caches (and any lazily initialized state) before timing.
+        TimeSample(operation, 1);
+    }
+
+    // Take samples until we have enough, or until the time budget runs out (always taking at least a few).
+    const uint32_t kMaxSamples = sQuick ? 3 : (mKind == Kind::Micro ? 30 : 20);
+    const uint32_t kMinSamples = sQuick ? 1 : 3;
+    const uint64_t kBudgetNs = sQuick ? 50000000ULL : 2000000000ULL;
+    std::vector<double> samples;
+    uint64_t totalNs = 0;
+    while(samples.size() < kMaxSamples && (samples.size() < kMinSamples || totalNs < kBudgetNs))
+    {
+        uint64_t sampleNs = TimeSample(operation, opsPerSample);
+        totalNs += sampleNs;
+        samples.push_back(static_cast<double>(sampleNs) / static_cast<double>(opsPerSample));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    mResult.name = mName;
+    mResult.kind = mKind;
+    mResult.sampleCount = static_cast<uint32_t>(samples.size());
+    mResult.opsPerSample = opsPerSample;
+    mResult.minNs = samples.front();
+    mResult.medianNs = samples[samples.size() / 2];
+    mResult.meanNs = static_cast<double>(totalNs) / static_cast<double>(opsPerSample * samples.size());
+    mMeasured = true;
+}
+
+/*static*/ int Benchmark::RunAll(int argc, char** argv)
+{
+    std::string filter;
+    std::string jsonPath;
+    std::string baselinePath;
+    double threshold = 10.0;
+    bool listOnly = false;
+    for(int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if(strcmp(argv[i], "--filter") == 0 && hasValue)
+        {
+            filter = argv[++i];
+        }
+        else if(strcmp(argv[i], "--json") == 0 && hasValue)
+        {
+            jsonPath = argv[++i];
+        }
+        else if(strcmp(argv[i], "--baseline") == 0 && hasValue)
+        {
+            baselinePath = argv[++i];
+        }
+        else if(strcmp(argv[i], "--threshold") == 0 && hasValue)
+        {
+            threshold = std::strtod(argv[++i], nullptr);
+        }
+        else if(strcmp(argv[i], "--quick") == 0)
+        {
+            sQuick = true;
+        }
+        else if(strcmp(argv[i], "--list") == 0)
+        {
+            listOnly = true;
+        }
+        else
+        {
+            PrintUsage();
+            return 2;
+        }
+    }
+
+    // Load the baseline up front, so a bad path is reported before spending time running benchmarks.
+    std::unordered_map<std::string, double> baselineMedians;
+    if(!baselinePath.empty() && !ReadBaseline(baselinePath, baselineMedians))
+    {
+        printf("Couldn't read baseline file %s\n", baselinePath.c_str());
+        return 2;
+    }
+
+    // Run each benchmark that passes the filter.
+    std::vector<Result> results;
+    int regressionCount = 0;
+    for(Benchmark* benchmark : GetAll())
+    {
+        if(!filter.empty() && strstr(benchmark->mName, filter.c_str()) == nullptr) { continue; }
+        if(listOnly)
+        {
+            printf("%s (%s)\n", benchmark->mName, GetKindName(benchmark->mKind));
+            continue;
+        }
+
+        benchmark->mMeasured = false;
+        benchmark->mFunction(*benchmark);
+        if(!benchmark->mMeasured)
+        {
+            printf("%-48s did not measure anything!\n", benchmark->mName);
+            continue;
+        }
+        const Result& result = benchmark->mResult;
+        results.push_back(result);
+        printf("%-48s %s  median %12.1f ns  min %12.1f ns  mean %12.1f ns", result.name.c_str(), GetKindName(result.kind),
+               result.medianNs, result.minNs, result.meanNs);
+
+        // Compare median time against the baseline, if the baseline has this benchmark.
+        auto it = baselineMedians.find(result.name);
+        if(it != baselineMedians.end() && it->second > 0.0)
+        {
+            double changePercent = (result.medianNs / it->second - 1.0) * 100.0;
+            bool regressed = changePercent > threshold;
+            printf("  %+6.1f%%%s", changePercent, regressed ? "  REGRESSED" : "");
+            if(regressed)
+            {
+                ++regressionCount;
+            }
+        }
+        printf("\n");
+        fflush(stdout);
+    }
+
+    // Save results, if desired.
+    if(!jsonPath.empty())
+    {
+        std::ofstream file(jsonPath);
+        file << ToJson(results);
+        if(!file.good())
+        {
+            printf("Couldn't write results to %s\n", jsonPath.c_str());
+            return 2;
+        }
+    }
+
+    if(regressionCount > 0)
+    {
+        printf("%d benchmark(s) regressed by more than %.1f%%\n", regressionCount, threshold);
+        return 1;
+    }
+    return 0;
+}
+
+/*static*/ std::vector<Benchmark*>& Benchmark::GetAll()
+{
+    // Function-local, so it exists before any benchmark registers itself during static initialization.
+    static std::vector<Benchmark*> benchmarks;
+    return benchmarks;
+}
+
+/*static*/ void Benchmark::KeepAliveImpl(const void* ptr)
+{
+    // Defined out-of-line, so the compiler can't see that the value isn't actually used.
+    static const void* volatile sink = nullptr;
+    sink = ptr;
+}
@@ -0,0 +1,89 @@
+//
+// Clark Kromenaker
+//
+// A tiny benchmark framework for timing engine subsystems outside of the game.
+//
+// Benchmarks are registered with the BENCHMARK_MICRO/BENCHMARK_MACRO macros. A benchmark's body does any setup it needs,
+// and then passes the operation being measured to Benchmark::Measure. Only the measured operation is timed.
+//
+// Micro benchmarks time small, fast operations (a matrix multiply, parsing an INI line) - the operation is run in batches,
+// so each timed sample is long enough to measure accurately. Macro benchmarks time bigger operations (extracting a Barn, finding a path),
+// one operation per sample.
+//
+// Results can be written to a JSON file, and compared against a previous JSON file (a baseline) to catch regressions.
+// Timings only mean much in an optimized (e.g. Release) build, and only against baselines from the same machine.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Benchmark
+{
+public:
+    enum class Kind
+    {
+        Micro,
+        Macro
+    };
+
+    // Timing results for one benchmark. All times are nanoseconds per operation.
+    struct Result
+    {
+        std::string name;
+        Kind kind = Kind::Micro;
+
+        // Number of timed samples, and number of operations run per sample.
+        uint32_t sampleCount = 0;
+        uint64_t opsPerSample = 0;
+
+        double minNs = 0.0;
+        double medianNs = 0.0;
+        double meanNs = 0.0;
+    };
+
+    Benchmark(const char* name, Kind kind, void (*function)(Benchmark&));
+
+    // Times the given operation. Call once from the benchmark's body, after any setup.
+    void Measure(const std::function<void()>& operation);
+
+    // Keeps the compiler from optimizing away a value that is computed, but never used.
+    template<typename T> static void KeepAlive(const T& value);
+
+    // Runs all registered benchmarks (using args from the command line). Returns the process exit code.
+    static int RunAll(int argc, char** argv);
+
+private:
+    // All registered benchmarks, in registration order.
+    static std::vector<Benchmark*>& GetAll();
+
+    const char* mName = nullptr;
+    Kind mKind = Kind::Micro;
+    void (*mFunction)(Benchmark&) = nullptr;
+
+    // The result of the last Measure call.
+    Result mResult;
+    bool mMeasured = false;
+
+    // In quick mode, each benchmark takes far fewer samples (just to make sure everything runs).
+    static bool sQuick;
+
+    static void KeepAliveImpl(const void* ptr);
+};
+
+template<typename T> void Benchmark::KeepAlive(const T& value)
+{
+    KeepAliveImpl(&value);
+}
+
+#define BENCHMARK_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_IMPL(a, b)
+
+#define BENCHMARK_REGISTER(name, kind, id)                                          \
+    static void BENCHMARK_CONCAT(BenchmarkFunc, id)(Benchmark& bench);              \
+    static Benchmark BENCHMARK_CONCAT(sBenchmark, id)(name, kind, &BENCHMARK_CONCAT(BenchmarkFunc, id)); \
+    static void BENCHMARK_CONCAT(BenchmarkFunc, id)(Benchmark& bench)
+
+#define BENCHMARK_MICRO(name) BENCHMARK_REGISTER(name, Benchmark::Kind::Micro, __LINE__)
+#define BENCHMARK_MACRO(name) BENCHMARK_REGISTER(name, Benchmark::Kind::Macro, __LINE__)
@@ -0,0 +1,203 @@
+#include "BenchmarkData.h"
+
+#include <cstring>
+
+void ByteBuilder::WriteString(const std::string& str, uint32_t size)
+{
+    for(uint32_t i = 0; i < size; ++i)
+    {
+        WriteByte(i < str.size() ? static_cast<uint8_t>(str[i]) : 0);
+    }
+}
+
+void ByteBuilder::PatchUInt(uint32_t position, uint32_t value)
+{
+    memcpy(mBytes.data() + position, &value, sizeof(value));
+}
+
+void ByteBuilder::WriteRaw(const void* data, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    mBytes.insert(mBytes.end(), bytes, bytes + size);
+}
+
+namespace
+{
+    void WriteBmpHeader(ByteBuilder& builder, uint32_t width, uint32_t height, uint16_t bitsPerPixel)
+    {
+        // BMP header: identifier, then file size, reserved values, and pixel data offset (none of which the texture loader reads).
+        builder.WriteUShort(0x4D42); // BM
+        builder.WriteUInt(0);
+        builder.WriteUInt(0);
+        builder.WriteUInt(0);
+
+        // DIB header.
+        builder.WriteUInt(40);
+        builder.WriteUInt(width);
+        builder.WriteUInt(height);
+        builder.WriteUShort(1); // color planes
+        builder.WriteUShort(bitsPerPixel);
+        builder.WriteUInt(0); // compression (none)
+        builder.WriteUInt(0); // image size
+        builder.WriteUInt(0); // horizontal resolution
+        builder.WriteUInt(0); // vertical resolution
+        builder.WriteUInt(bitsPerPixel <= 8 ? (1 << bitsPerPixel) : 0); // palette color count
+        builder.WriteUInt(0); // important color count
+    }
+
+    void WriteBmpRowPadding(ByteBuilder& builder, uint32_t rowBytes)
+    {
+        // Rows are padded to 4-byte alignment.
+        while(rowBytes % 4 != 0)
+        {
+            builder.WriteByte(0);
+            ++rowBytes;
+        }
+    }
+}
+
+namespace BenchmarkData
+{
+    std::vector<uint8_t> MakeBmp8(uint32_t width, uint32_t height, const std::function<uint8_t(uint32_t, uint32_t)>& getIndex)
+    {
+        ByteBuilder builder;
+        WriteBmpHeader(builder, width, height, 8);
+
+        // Grayscale palette (BGRA).
+        for(uint32_t i = 0; i < 256; ++i)
+        {
+            uint8_t value = static_cast<uint8_t>(i);
+            builder.WriteByte(value);
+            builder.WriteByte(value);
+            builder.WriteByte(value);
+            builder.WriteByte(0);
+        }
+
+        // Pixel rows are stored bottom-up.
+        for(uint32_t row = 0; row < height; ++row)
+        {
+            uint32_t y = height - 1 - row;
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                builder.WriteByte(getIndex(x, y));
+            }
+            WriteBmpRowPadding(builder, width);
+        }
+        return builder.GetBytes();
+    }
+
+    std::vector<uint8_t> MakeBmp24(uint32_t width, uint32_t height)
+    {
+        ByteBuilder builder;
+        WriteBmpHeader(builder, width, height, 24);
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                builder.WriteByte(static_cast<uint8_t>(x));
+                builder.WriteByte(static_cast<uint8_t>(y));
+                builder.WriteByte(static_cast<uint8_t>(x ^ y));
+            }
+            WriteBmpRowPadding(builder, width * 3);
+        }
+        return builder.GetBytes();
+    }
+
+    std::vector<uint8_t> MakeCompressedTexture(uint32_t width, uint32_t height)
+    {
+        ByteBuilder builder;
+        builder.WriteUShort(0x3136); // 16
+        builder.WriteUShort(0x4D6E); // Mn
+        builder.WriteUShort(static_cast<uint16_t>(height));
+        builder.WriteUShort(static_cast<uint16_t>(width));
+        for(uint32_t y = 0; y < height; ++y)
+        {
+            for(uint32_t x = 0; x < width; ++x)
+            {
+                builder.WriteUShort(static_cast<uint16_t>((x * 31 + y * 17) & 0xFFFF));
+            }
+
+            // Rows with an odd number of pixels are padded.
+            if((width & 1) != 0)
+            {
+                builder.WriteUShort(0);
+            }
+        }
+        return builder.GetBytes();
+    }
+
+    std::vector<uint8_t> MakeVertexAnimation(uint32_t meshCount, uint32_t frameCount, uint32_t vertexCount, uint32_t vertexInterval)
+    {
+        ByteBuilder builder;
+        builder.WriteString("HTCA", 4);
+        builder.WriteUInt(258);
+        builder.WriteUInt(frameCount);
+        builder.WriteUInt(meshCount);
+        builder.WriteUInt(0); // contents size (unused)
+        builder.WriteString("BENCHMARK.MOD", 32);
+
+        // Offsets to each frame are filled in as frames are written.
+        uint32_t offsetsPosition = builder.GetSize();
+        for(uint32_t i = 0; i < frameCount; ++i)
+        {
+            builder.WriteUInt(0);
+        }
+
+        const uint32_t kTransformBlockBytes = 1 + 4 + 48;
+        const uint32_t kVertexBlockBytes = 2 + 2 + vertexCount * 12;
+        for(uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            builder.PatchUInt(offsetsPosition + frame * 4, builder.GetSize());
+            bool hasVertices = (frame % vertexInterval) == 0;
+            for(uint32_t mesh = 0; mesh < meshCount; ++mesh)
+            {
+                builder.WriteUShort(static_cast<uint16_t>(mesh));
+                builder.WriteUInt(kTransformBlockBytes + (hasVertices ? 1 + 4 + kVertexBlockBytes : 0));
+
+                // Transform: i/j/k basis vectors, then position.
+                float angle = frame * 0.05f + mesh;
+                builder.WriteByte(2);
+                builder.WriteUInt(48);
+                builder.WriteFloat(1.0f); builder.WriteFloat(0.0f); builder.WriteFloat(0.0f);
+                builder.WriteFloat(0.0f); builder.WriteFloat(1.0f); builder.WriteFloat(0.0f);
+                builder.WriteFloat(0.0f); builder.WriteFloat(0.0f); builder.WriteFloat(1.0f);
+                builder.WriteFloat(angle); builder.WriteFloat(mesh * 10.0f); builder.WriteFloat(-angle);
+
+                // Uncompressed vertex positions for submesh 0.
+                if(hasVertices)
+                {
+                    builder.WriteByte(0);
+                    builder.WriteUInt(kVertexBlockBytes);
+                    builder.WriteUShort(0);
+                    builder.WriteUShort(static_cast<uint16_t>(vertexCount));
+                    for(uint32_t vertex = 0; vertex < vertexCount; ++vertex)
+                    {
+                        builder.WriteFloat(vertex * 0.1f);
+                        builder.WriteFloat(frame * 0.2f);
+                        builder.WriteFloat(mesh + vertex * 0.3f);
+                    }
+                }
+            }
+        }
+        return builder.GetBytes();
+    }
+
+    std::vector<uint8_t> MakeAssetBytes(uint32_t size, uint32_t seed)
+    {
+        // Runs of repeated values, with lengths and values from a small linear congruential generator.
+        std::vector<uint8_t> bytes;
+        bytes.reserve(size);
+        uint32_t state = seed * 2654435761u + 1;
+        while(bytes.size() < size)
+        {
+            state = state * 1664525u + 1013904223u;
+            uint8_t value = static_cast<uint8_t>(state >> 24);
+            uint32_t runLength = 1 + ((state >> 8) & 0x7);
+            for(uint32_t i = 0; i < runLength && bytes.size() < size; ++i)
+            {
+                bytes.push_back(value);
+            }
+        }
+        return bytes;
+    }
+}
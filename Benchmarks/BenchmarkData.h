@@ -0,0 +1,56 @@
+//
+// Clark Kromenaker
+//
+// Generates synthetic asset data for benchmarks to chew on.
+//
+// Benchmarks can't rely on having the game's data files around, so they build assets in the same formats in memory.
+// Data is deterministic, so results are comparable from run to run.
+//
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Appends little-endian values to a byte buffer - like BinaryWriter, but the buffer grows as needed.
+class ByteBuilder
+{
+public:
+    void WriteByte(uint8_t value) { mBytes.push_back(value); }
+    void WriteUShort(uint16_t value) { WriteRaw(&value, sizeof(value)); }
+    void WriteUInt(uint32_t value) { WriteRaw(&value, sizeof(value)); }
+    void WriteFloat(float value) { WriteRaw(&value, sizeof(value)); }
+
+    // Writes exactly "size" bytes - the string is truncated or padded with zeros to fit.
+    void WriteString(const std::string& str, uint32_t size);
+
+    // Overwrites a previously written value.
+    void PatchUInt(uint32_t position, uint32_t value);
+
+    uint32_t GetSize() const { return static_cast<uint32_t>(mBytes.size()); }
+    std::vector<uint8_t>& GetBytes() { return mBytes; }
+
+private:
+    std::vector<uint8_t> mBytes;
+
+    void WriteRaw(const void* data, size_t size);
+};
+
+namespace BenchmarkData
+{
+    // BMP with an 8-bit palette. The function gives the palette index for each pixel (with 0,0 being top-left).
+    std::vector<uint8_t> MakeBmp8(uint32_t width, uint32_t height, const std::function<uint8_t(uint32_t, uint32_t)>& getIndex);
+
+    // BMP with 24-bit color.
+    std::vector<uint8_t> MakeBmp24(uint32_t width, uint32_t height);
+
+    // GK3's own 16-bit (RGB565) texture format.
+    std::vector<uint8_t> MakeCompressedTexture(uint32_t width, uint32_t height);
+
+    // Vertex animation (ACT) with the given number of meshes and frames.
+    // Each mesh has a single submesh, with a transform on every frame and uncompressed vertex positions every "vertexInterval" frames.
+    std::vector<uint8_t> MakeVertexAnimation(uint32_t meshCount, uint32_t frameCount, uint32_t vertexCount, uint32_t vertexInterval);
+
+    // Deterministic pseudo-random bytes, with some repetition (so they compress somewhat, like real asset data).
+    std::vector<uint8_t> MakeAssetBytes(uint32_t size, uint32_t seed);
+}
@@ -0,0 +1,21 @@
+//
+// Clark Kromenaker
+//
+// The main function for running engine benchmarks.
+// Benchmarks run headless - no window, renderer, or game data is needed.
+//
+#include "Benchmark.h"
+#include "ThreadPool.h"
+#include "ThreadUtil.h"
+
+int main(int argc, char** argv)
+{
+    // Some systems (e.g. Barn extraction) spread work across the thread pool, same as in the game.
+    ThreadUtil::Init();
+    ThreadPool::Init(4);
+
+    int result = Benchmark::RunAll(argc, argv);
+
+    ThreadPool::Shutdown();
+    return result;
+}
@@ -0,0 +1,36 @@
+//
+// Clark Kromenaker
+//
+// Stand-ins for the few engine pieces that benchmarked code touches, but which would otherwise drag in the whole engine
+// (renderer, console, scene management). None of these do anything interesting - benchmarks never rely on them.
+//
+#include <cstdio>
+
+#include "Debug.h"
+#include "ReportStream.h"
+#include "SheepManager.h"
+
+// Sheep system functions refer to the global Sheep manager. It's only needed for its VM's execution state.
+SheepManager gSheepManager;
+
+ReportStream::ReportStream(std::string name) :
+    mName(name),
+    mFilename(name + ".log")
+{
+
+}
+
+void ReportStream::Log(std::string content)
+{
+    // No console here - just print anything that would have been visible in the debugger or console.
+    if(!mEnabled) { return; }
+    if((mOutput & (ReportOutput::Console | ReportOutput::Debugger)) != ReportOutput::None)
+    {
+        printf("[%s] %s\n", mName.c_str(), content.c_str());
+    }
+}
+
+/*static*/ void Debug::DrawRectXZ(const Rect& rect, float height, const Color32& color, float duration, const Matrix4* transformMatrix)
+{
+    // Nothing to draw to.
+}
@@ -0,0 +1,85 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for IniParser, which parses many text assets (animations, scene info, models, and so on) at load time.
+//
+#include "Benchmark.h"
+
+#include <string>
+
+#include "IniParser.h"
+
+namespace
+{
+    // Builds INI text resembling a GK3 animation file: a header, and a long list of comma-separated action lines.
+    std::string MakeAnimationIni(int lineCount)
+    {
+        std::string ini = "[HEADER]\n" + std::to_string(lineCount) + "\n\n[ACTIONS]\n" + std::to_string(lineCount) + "\n";
+        for(int i = 0; i < lineCount; ++i)
+        {
+            ini += std::to_string(i) + ", GAB_ACTION_" + std::to_string(i % 17) + ", 12.5, -3.25, 100.0, 90, 0.0, 0.0, 0.0, 180\n";
+        }
+        ini += "\n[GK3]\n";
+        for(int i = 0; i < lineCount / 4; ++i)
+        {
+            ini += std::to_string(i * 4) + ", FACE, GAB, EYES=0.5, EXPRESSION=Smile\n";
+        }
+        return ini;
+    }
+
+    // Builds INI text resembling a preferences file: many sections, each with one key/value pair per line.
+    std::string MakeSettingsIni(int sectionCount)
+    {
+        std::string ini;
+        for(int i = 0; i < sectionCount; ++i)
+        {
+            ini += "[Section" + std::to_string(i) + "]\n";
+            ini += "Name=Setting Number " + std::to_string(i) + "\n";
+            ini += "Enabled=true\n";
+            ini += "Position={1.5, 2.5, 3.5}\n";
+            ini += "Scale=0.75\n";
+            ini += "; A comment that should be skipped over.\n\n";
+        }
+        return ini;
+    }
+}
+
+BENCHMARK_MICRO("IniParser/ParseAll Animation (500 lines)")
+{
+    std::string ini = MakeAnimationIni(500);
+    bench.Measure([&]() {
+        IniParser parser(reinterpret_cast<const uint8_t*>(ini.data()), static_cast<uint32_t>(ini.size()));
+        parser.ParseAll();
+        IniSection section = parser.GetSection("ACTIONS");
+        Benchmark::KeepAlive(section);
+    });
+}
+
+BENCHMARK_MICRO("IniParser/ReadNextSection Animation (500 lines)")
+{
+    std::string ini = MakeAnimationIni(500);
+    bench.Measure([&]() {
+        IniParser parser(reinterpret_cast<const uint8_t*>(ini.data()), static_cast<uint32_t>(ini.size()));
+        IniSection section;
+        int frameSum = 0;
+        while(parser.ReadNextSection(section))
+        {
+            for(const IniLine& line : section.lines)
+            {
+                frameSum += line.entries.front().GetValueAsInt();
+            }
+        }
+        Benchmark::KeepAlive(frameSum);
+    });
+}
+
+BENCHMARK_MICRO("IniParser/ParseAllAsMap Settings (200 sections)")
+{
+    std::string ini = MakeSettingsIni(200);
+    bench.Measure([&]() {
+        IniParser parser(reinterpret_cast<const uint8_t*>(ini.data()), static_cast<uint32_t>(ini.size()));
+        parser.SetMultipleKeyValuePairsPerLine(false);
+        auto map = parser.ParseAllAsMap();
+        Benchmark::KeepAlive(map);
+    });
+}
@@ -0,0 +1,131 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for Matrix4 and Quaternion math, which run many times per frame for every animated/moving object.
+//
+#include "Benchmark.h"
+
+#include <vector>
+
+#include "GMath.h"
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Vector3.h"
+
+namespace
+{
+    // A batch of arbitrary (but repeatable) transforms to operate on, so we aren't just timing the same values over and over.
+    const size_t kBatchSize = 256;
+
+    std::vector<Matrix4> MakeTransforms()
+    {
+        std::vector<Matrix4> transforms;
+        for(size_t i = 0; i < kBatchSize; ++i)
+        {
+            float f = static_cast<float>(i);
+            Quaternion rotation(Vector3(f, 1.0f, 0.5f * f).Normalize(), f * 0.1f);
+            transforms.push_back(Matrix4::MakeTranslate(Vector3(f, -f, 2.0f * f)) * Matrix4::MakeRotate(rotation) * Matrix4::MakeScale(1.0f + f * 0.01f));
+        }
+        return transforms;
+    }
+
+    std::vector<Quaternion> MakeRotations()
+    {
+        std::vector<Quaternion> rotations;
+        for(size_t i = 0; i < kBatchSize; ++i)
+        {
+            float f = static_cast<float>(i);
+            rotations.emplace_back(Vector3(0.5f, f, 1.0f).Normalize(), f * 0.05f);
+        }
+        return rotations;
+    }
+}
+
+BENCHMARK_MICRO("Math/Matrix4 Multiply")
+{
+    std::vector<Matrix4> transforms = MakeTransforms();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Matrix4 result = transforms[index % kBatchSize] * transforms[(index + 1) % kBatchSize];
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Matrix4 TransformPoint")
+{
+    std::vector<Matrix4> transforms = MakeTransforms();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Vector3 result = transforms[index % kBatchSize].TransformPoint(Vector3(1.0f, 2.0f, 3.0f));
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Matrix4 Inverse")
+{
+    std::vector<Matrix4> transforms = MakeTransforms();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Matrix4 result = Matrix4::Inverse(transforms[index % kBatchSize]);
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Matrix4 InverseTransform")
+{
+    std::vector<Matrix4> transforms = MakeTransforms();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Matrix4 result = Matrix4::InverseTransform(transforms[index % kBatchSize]);
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Matrix4 MakeRotate")
+{
+    std::vector<Quaternion> rotations = MakeRotations();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Matrix4 result = Matrix4::MakeRotate(rotations[index % kBatchSize]);
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Quaternion Multiply")
+{
+    std::vector<Quaternion> rotations = MakeRotations();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Quaternion result = rotations[index % kBatchSize] * rotations[(index + 1) % kBatchSize];
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Quaternion Rotate")
+{
+    std::vector<Quaternion> rotations = MakeRotations();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Vector3 result = rotations[index % kBatchSize].Rotate(Vector3(1.0f, 2.0f, 3.0f));
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
+
+BENCHMARK_MICRO("Math/Quaternion Slerp")
+{
+    std::vector<Quaternion> rotations = MakeRotations();
+    size_t index = 0;
+    bench.Measure([&]() {
+        Quaternion result;
+        Quaternion::Slerp(result, rotations[index % kBatchSize], rotations[(index + 1) % kBatchSize], 0.3f);
+        Benchmark::KeepAlive(result);
+        ++index;
+    });
+}
@@ -0,0 +1,77 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for compiling and executing Sheep scripts.
+//
+#include "Benchmark.h"
+
+#include <memory>
+
+#include "SheepCompiler.h"
+#include "SheepScript.h"
+#include "SheepVM.h"
+
+namespace
+{
+    // Loops many times, doing integer/float arithmetic and branching - exercises the VM's core instructions without any system functions.
+    const char* kLoopSheep =
+        "symbols { int i$ = 0; int sum$ = 0; float f$ = 0.0; }\n"
+        "code\n"
+        "{\n"
+        "    Loop$()\n"
+        "    {\n"
+        "        i$ = 0;\n"
+        "        sum$ = 0;\n"
+        "        f$ = 0.0;\n"
+        "    top$:\n"
+        "        sum$ = sum$ + i$ * 3 - (i$ / 7) * 2;\n"
+        "        f$ = f$ + 0.5 * i$;\n"
+        "        if(sum$ > 1000 && i$ != 5)\n"
+        "        {\n"
+        "            sum$ = sum$ - 1000;\n"
+        "        }\n"
+        "        i$ = i$ + 1;\n"
+        "        if(i$ < 1000)\n"
+        "        {\n"
+        "            goto top$;\n"
+        "        }\n"
+        "    }\n"
+        "}\n";
+
+    // Like a typical NVC condition: a small expression evaluated for true/false (see SheepManager::CompileEval).
+    const char* kEvalSheep = "symbols { int n$ = 0; int v$ = 0; } code { X$() { n$ == 12 && (v$ > 3 || v$ == 0) } }";
+}
+
+BENCHMARK_MICRO("Sheep/Compile Loop Script")
+{
+    bench.Measure([&]() {
+        SheepCompiler compiler;
+        std::unique_ptr<SheepScript> script(compiler.CompileToAsset("Loop", kLoopSheep));
+        Benchmark::KeepAlive(script);
+    });
+}
+
+BENCHMARK_MICRO("Sheep/Execute Loop (1000 iterations)")
+{
+    SheepCompiler compiler;
+    std::unique_ptr<SheepScript> script(compiler.CompileToAsset("Loop", kLoopSheep));
+    if(script == nullptr) { return; }
+    SheepVM vm;
+    bench.Measure([&]() {
+        vm.Execute(script.get(), "Loop$", nullptr);
+    });
+}
+
+BENCHMARK_MICRO("Sheep/Evaluate Condition")
+{
+    SheepCompiler compiler;
+    std::unique_ptr<SheepScript> script(compiler.CompileToAsset("Condition", kEvalSheep));
+    if(script == nullptr) { return; }
+    SheepVM vm;
+    int n = 0;
+    bench.Measure([&]() {
+        bool result = vm.Evaluate(script.get(), n % 16, n % 5);
+        Benchmark::KeepAlive(result);
+        ++n;
+    });
+}
@@ -0,0 +1,46 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for parsing texture data (on the CPU only - nothing is uploaded to a GPU).
+//
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+
+#include "AssetBuffer.h"
+#include "Texture.h"
+
+namespace
+{
+    void MeasureTextureLoad(Benchmark& bench, const std::vector<uint8_t>& data)
+    {
+        AssetBuffer buffer = AssetBuffer::MakeBorrowed(data.data(), static_cast<uint32_t>(data.size()));
+        bench.Measure([&]() {
+            Texture texture("Benchmark.BMP", AssetScope::Manual);
+            texture.Load(buffer);
+            Benchmark::KeepAlive(texture.GetPixelData());
+        });
+    }
+}
+
+BENCHMARK_MICRO("Texture/Load BMP 8-bit 256x256")
+{
+    MeasureTextureLoad(bench, BenchmarkData::MakeBmp8(256, 256, [](uint32_t x, uint32_t y) {
+        return static_cast<uint8_t>(x ^ y);
+    }));
+}
+
+BENCHMARK_MICRO("Texture/Load BMP 24-bit 512x512")
+{
+    MeasureTextureLoad(bench, BenchmarkData::MakeBmp24(512, 512));
+}
+
+BENCHMARK_MICRO("Texture/Load Compressed 16-bit 512x512")
+{
+    MeasureTextureLoad(bench, BenchmarkData::MakeCompressedTexture(512, 512));
+}
+
+BENCHMARK_MICRO("Texture/Load Compressed 16-bit 257x255")
+{
+    // Odd width, so each row has padding.
+    MeasureTextureLoad(bench, BenchmarkData::MakeCompressedTexture(257, 255));
+}
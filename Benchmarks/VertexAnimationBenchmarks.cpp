@@ -0,0 +1,70 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for loading and sampling vertex animations, which are sampled every frame for every animating model.
+//
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+
+#include "AssetBuffer.h"
+#include "VertexAnimation.h"
+
+namespace
+{
+    // Roughly the size of a character animation: a couple dozen meshes, a few seconds long.
+    const uint32_t kMeshCount = 24;
+    const uint32_t kFrameCount = 150;
+    const uint32_t kVertexCount = 200;
+    const uint32_t kVertexInterval = 5;
+    const int kFramesPerSecond = 15;
+}
+
+BENCHMARK_MICRO("VertexAnimation/Load (24 meshes, 150 frames)")
+{
+    std::vector<uint8_t> data = BenchmarkData::MakeVertexAnimation(kMeshCount, kFrameCount, kVertexCount, kVertexInterval);
+    AssetBuffer buffer = AssetBuffer::MakeBorrowed(data.data(), static_cast<uint32_t>(data.size()));
+    bench.Measure([&]() {
+        VertexAnimation animation("Benchmark.ACT", AssetScope::Manual);
+        animation.Load(buffer);
+        Benchmark::KeepAlive(animation.GetFrameCount());
+    });
+}
+
+BENCHMARK_MICRO("VertexAnimation/SampleTransformPose (all meshes)")
+{
+    std::vector<uint8_t> data = BenchmarkData::MakeVertexAnimation(kMeshCount, kFrameCount, kVertexCount, kVertexInterval);
+    VertexAnimation animation("Benchmark.ACT", AssetScope::Manual);
+    animation.Load(AssetBuffer::MakeBorrowed(data.data(), static_cast<uint32_t>(data.size())));
+
+    // Step through the animation a little each time, as if playing it back.
+    float duration = animation.GetDuration(kFramesPerSecond);
+    float time = 0.0f;
+    bench.Measure([&]() {
+        for(uint32_t mesh = 0; mesh < kMeshCount; ++mesh)
+        {
+            VertexAnimationTransformPose pose = animation.SampleTransformPose(time, kFramesPerSecond, mesh);
+            Benchmark::KeepAlive(pose);
+        }
+        time += 0.033f;
+        if(time > duration) { time = 0.0f; }
+    });
+}
+
+BENCHMARK_MICRO("VertexAnimation/SampleVertexPose (all meshes)")
+{
+    std::vector<uint8_t> data = BenchmarkData::MakeVertexAnimation(kMeshCount, kFrameCount, kVertexCount, kVertexInterval);
+    VertexAnimation animation("Benchmark.ACT", AssetScope::Manual);
+    animation.Load(AssetBuffer::MakeBorrowed(data.data(), static_cast<uint32_t>(data.size())));
+
+    float duration = animation.GetDuration(kFramesPerSecond);
+    float time = 0.0f;
+    bench.Measure([&]() {
+        for(uint32_t mesh = 0; mesh < kMeshCount; ++mesh)
+        {
+            VertexAnimationVertexPose pose = animation.SampleVertexPose(time, kFramesPerSecond, mesh, 0);
+            Benchmark::KeepAlive(pose);
+        }
+        time += 0.033f;
+        if(time > duration) { time = 0.0f; }
+    });
+}
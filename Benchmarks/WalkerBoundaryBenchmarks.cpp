@@ -0,0 +1,86 @@
+//
+// Clark Kromenaker
+//
+// Benchmarks for walker boundary pathfinding, which runs whenever an actor walks somewhere.
+//
+#include "Benchmark.h"
+#include "BenchmarkData.h"
+
+#include <cstdlib>
+#include <memory>
+
+#include "AssetBuffer.h"
+#include "Texture.h"
+#include "WalkerBoundary.h"
+
+namespace
+{
+    const uint32_t kWidth = 320;
+    const uint32_t kHeight = 240;
+
+    // Vertical walls every so often, with a gap alternating between the bottom and top - so paths have to snake back and forth.
+    // Like real walker boundaries, areas near walls are "less walkable" (higher palette index).
+    uint8_t GetMazeIndex(uint32_t x, uint32_t y)
+    {
+        const uint32_t kWallSpacing = 40;
+        const uint32_t kGapSize = 24;
+        uint32_t wall = (x + kWallSpacing / 2) / kWallSpacing;
+        if(wall == 0 || wall * kWallSpacing >= kWidth) { return 0; }
+
+        int distance = std::abs(static_cast<int>(x) - static_cast<int>(wall * kWallSpacing));
+        bool inGap = (wall % 2 == 0) ? (y < kGapSize) : (y >= kHeight - kGapSize);
+        if(inGap) { return 0; }
+        if(distance <= 1) { return 255; }
+        if(distance <= 6) { return static_cast<uint8_t>(8 - distance); }
+        return 0;
+    }
+
+    struct Maze
+    {
+        std::vector<uint8_t> data;
+        std::unique_ptr<Texture> texture;
+        WalkerBoundary walkerBoundary;
+
+        Maze()
+        {
+            data = BenchmarkData::MakeBmp8(kWidth, kHeight, &GetMazeIndex);
+            texture.reset(new Texture("Benchmark.BMP", AssetScope::Manual));
+            texture->Load(AssetBuffer::MakeBorrowed(data.data(), static_cast<uint32_t>(data.size())));
+
+            // One world unit per pixel.
+            walkerBoundary.SetTexture(texture.get());
+            walkerBoundary.SetSize(Vector2(static_cast<float>(kWidth), static_cast<float>(kHeight)));
+            walkerBoundary.SetOffset(Vector2::Zero);
+        }
+    };
+}
+
+BENCHMARK_MACRO("WalkerBoundary/FindPath Across Maze")
+{
+    Maze maze;
+    std::vector<Vector3> path;
+    bench.Measure([&]() {
+        maze.walkerBoundary.FindPath(Vector3(5.0f, 0.0f, 120.0f), Vector3(315.0f, 0.0f, 120.0f), path);
+        Benchmark::KeepAlive(path);
+    });
+}
+
+BENCHMARK_MICRO("WalkerBoundary/FindPath Short")
+{
+    Maze maze;
+    std::vector<Vector3> path;
+    bench.Measure([&]() {
+        maze.walkerBoundary.FindPath(Vector3(50.0f, 0.0f, 100.0f), Vector3(70.0f, 0.0f, 130.0f), path);
+        Benchmark::KeepAlive(path);
+    });
+}
+
+BENCHMARK_MICRO("WalkerBoundary/FindNearestWalkablePosition")
+{
+    Maze maze;
+    bench.Measure([&]() {
+        // Inside a wall, so the nearest walkable spot must be searched for.
+        Vector3 position = maze.walkerBoundary.FindNearestWalkablePosition(Vector3(120.0f, 0.0f, 120.0f));
+        Benchmark::KeepAlive(position);
+    });
+}
@@ -1,7 +1,18 @@
 #include "Asset.h"
 
+#include <condition_variable>
+#include <mutex>
+
 #include "FileSystem.h"
 
+namespace
+{
+    // Used to wake threads waiting on pending assets.
+    // Loads complete rarely enough that one condition variable for all assets is fine - waiters just recheck their own asset.
+    std::mutex sLoadStateMutex;
+    std::condition_variable sLoadStateCondVar;
+}
+
 Asset::Asset(const std::string& name, AssetScope scope) :
     mName(name),
     mScope(scope)
@@ -13,3 +24,20 @@ std::string Asset::GetNameNoExtension() const
 {
     return Path::RemoveExtension(mName);
 }
+
+void Asset::SetLoadState(AssetLoadState loadState)
+{
+    // Change state while holding the mutex, so a waiter can't miss the notification between checking state and waiting.
+    {
+        std::lock_guard<std::mutex> lock(sLoadStateMutex);
+        mLoadState.store(loadState, std::memory_order_release);
+    }
+    sLoadStateCondVar.notify_all();
+}
+
+bool Asset::WaitForPendingLoad() const
+{
+    std::unique_lock<std::mutex> lock(sLoadStateMutex);
+    sLoadStateCondVar.wait(lock, [this]() { return GetLoadState() != AssetLoadState::Pending; });
+    return GetLoadState() == AssetLoadState::Ready;
+}
@@ -7,9 +7,15 @@
 // Usually loaded from the disk, but could be created at runtime as well.
 //
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <string>
 
+#include "AssetBuffer.h"
+
+class BinaryReader;
+class BinaryWriter;
+
 // Assets can have an assigned scope, which helps to inform memory management.
 enum class AssetScope
 {
@@ -19,6 +25,14 @@ enum class AssetScope
     Manual      // An asset with manual scope is not tracked by the system, so the creator of the asset is responsible for its lifetime.
 };
 
+// Assets loaded asynchronously may not be usable right away.
+enum class AssetLoadState
+{
+    Pending,    // The asset's data is still being loaded on a background thread.
+    Ready,      // The asset's data is loaded and the asset can be used.
+    Failed      // The asset's data couldn't be loaded.
+};
+
 class Asset
 {
 public:
@@ -29,6 +43,33 @@ public:
 
     void SetScope(AssetScope scope) { mScope = scope; }
     AssetScope GetScope() const { return mScope; }
+
+    // Assets are Ready by default. Async loads mark an asset Pending until its data is loaded.
+    void SetLoadState(AssetLoadState loadState);
+    AssetLoadState GetLoadState() const { return mLoadState.load(std::memory_order_acquire); }
+    bool IsLoaded() const { return GetLoadState() == AssetLoadState::Ready; }
+
+    // Blocks until the asset is no longer pending. Returns true if the asset loaded successfully.
+    // Cheap if the asset is already loaded, so it's fine to call before every use of async-loaded data.
+    bool WaitForLoad() const
+    {
+        AssetLoadState loadState = GetLoadState();
+        return loadState == AssetLoadState::Ready || (loadState == AssetLoadState::Pending && WaitForPendingLoad());
+    }
+
+    // Some assets can be changed after they're loaded (e.g. a texture that gameplay draws into), so they no longer match their source data.
+    // A changed asset isn't kept around for reuse once unloaded - reloading it is the only way to get back to the original.
+    virtual bool IsChanged() const { return false; }
+
+    // Some assets can be "cooked" - saved to disk in a load-ready binary format, so later loads can skip parsing entirely.
+    // The cooked version must change whenever an asset's cooked format changes. Zero means the asset can't be cooked.
+    virtual uint32_t GetCookedVersion() const { return 0; }
+
+    // Loads the asset from cooked data. If this returns false, the asset must be left as-is, so it can be loaded normally.
+    virtual bool LoadCooked(BinaryReader& reader) { return false; }
+
+    // Writes a loaded asset's cooked data. Returns false if the asset has nothing to cook.
+    virtual bool WriteCooked(BinaryWriter& writer) const { return false; }
     
 protected:
     // You should not be able to create an instance of this class - only subclasses are allowed.
@@ -39,4 +80,10 @@ protected:
 
     // Asset's scope.
     AssetScope mScope = AssetScope::Global;
+
+private:
+    // Asset's load state - may be changed by a background thread.
+    std::atomic<AssetLoadState> mLoadState { AssetLoadState::Ready };
+
+    bool WaitForPendingLoad() const;
 };
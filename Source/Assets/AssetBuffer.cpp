@@ -0,0 +1,103 @@
+#include "AssetBuffer.h"
+
+#include <cstring>
+#include <utility>
+
+#include "MappedFile.h"
+
+/*static*/ AssetBuffer AssetBuffer::MakeOwned(uint8_t* data, uint32_t size)
+{
+    AssetBuffer buffer;
+    buffer.mData = data;
+    buffer.mSize = data != nullptr ? size : 0;
+    buffer.mOwned = data != nullptr;
+    return buffer;
+}
+
+/*static*/ AssetBuffer AssetBuffer::MakeBorrowed(const uint8_t* data, uint32_t size)
+{
+    AssetBuffer buffer;
+    buffer.mData = data;
+    buffer.mSize = data != nullptr ? size : 0;
+    return buffer;
+}
+
+/*static*/ AssetBuffer AssetBuffer::MakeFromFile(const std::string& filePath)
+{
+    AssetBuffer buffer;
+    MappedFile* file = new MappedFile(filePath);
+    if(!file->OK())
+    {
+        delete file;
+        return buffer;
+    }
+    buffer.mMappedFile = file;
+    buffer.mData = file->GetData();
+    buffer.mSize = static_cast<uint32_t>(file->GetSize());
+    return buffer;
+}
+
+AssetBuffer::~AssetBuffer()
+{
+    Clear();
+}
+
+AssetBuffer::AssetBuffer(AssetBuffer&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+AssetBuffer& AssetBuffer::operator=(AssetBuffer&& other) noexcept
+{
+    if(this != &other)
+    {
+        Clear();
+
+        mData = other.mData;
+        mSize = other.mSize;
+        mOwned = other.mOwned;
+        mMappedFile = other.mMappedFile;
+
+        other.mData = nullptr;
+        other.mSize = 0;
+        other.mOwned = false;
+        other.mMappedFile = nullptr;
+    }
+    return *this;
+}
+
+void AssetBuffer::MakeOwnedCopy(bool nullTerminate)
+{
+    // Already own the data, and it either doesn't need a null terminator or already has one? Nothing to do.
+    if(mData == nullptr) { return; }
+    if(mOwned && (!nullTerminate || (mSize > 0 && mData[mSize - 1] == '\0'))) { return; }
+
+    // Copy the data into a new buffer, with room for a null terminator if desired.
+    uint8_t* copy = new uint8_t[mSize + (nullTerminate ? 1 : 0)];
+    memcpy(copy, mData, mSize);
+    if(nullTerminate)
+    {
+        copy[mSize] = '\0';
+    }
+
+    // Release the old data and switch over to the copy.
+    uint32_t size = mSize;
+    Clear();
+    mData = copy;
+    mSize = size;
+    mOwned = true;
+}
+
+void AssetBuffer::Clear()
+{
+    if(mOwned)
+    {
+        delete[] mData;
+    }
+    delete mMappedFile;
+
+    mData = nullptr;
+    mSize = 0;
+    mOwned = false;
+    mMappedFile = nullptr;
+}
@@ -0,0 +1,61 @@
+//
+// Clark Kromenaker
+//
+// A handle to an asset's raw data, as passed to an asset's Load function.
+//
+// The data may be owned by the buffer (e.g. decompressed data), or borrowed from somewhere else (e.g. an uncompressed
+// region of a memory-mapped Barn, or a memory-mapped loose file). Either way, the buffer cleans up after itself.
+// Most assets just parse the data during Load. Assets that need the data to stick around can take it by moving the buffer.
+//
+#pragma once
+#include <cstdint>
+#include <string>
+
+class MappedFile;
+
+class AssetBuffer
+{
+public:
+    // Takes ownership of heap memory (allocated with new[]).
+    static AssetBuffer MakeOwned(uint8_t* data, uint32_t size);
+
+    // Refers to memory owned by someone else - that memory must outlive the buffer.
+    static AssetBuffer MakeBorrowed(const uint8_t* data, uint32_t size);
+
+    // Maps a file on disk into memory. Returns an invalid buffer if the file can't be read.
+    static AssetBuffer MakeFromFile(const std::string& filePath);
+
+    AssetBuffer() = default;
+    ~AssetBuffer();
+
+    // Buffers may own memory, so don't allow copying!
+    AssetBuffer(const AssetBuffer& other) = delete;
+    AssetBuffer& operator=(const AssetBuffer& other) = delete;
+
+    // Buffers can be moved to/from.
+    AssetBuffer(AssetBuffer&& other) noexcept;
+    AssetBuffer& operator=(AssetBuffer&& other) noexcept;
+
+    bool IsValid() const { return mData != nullptr; }
+    bool IsOwned() const { return mOwned; }
+
+    const uint8_t* GetData() const { return mData; }
+    uint32_t GetSize() const { return mSize; }
+
+    // Copies borrowed or mapped data into memory owned by this buffer.
+    // Optionally appends a null terminator (not included in size), which is handy for text data.
+    void MakeOwnedCopy(bool nullTerminate = false);
+
+private:
+    // The data and its size.
+    const uint8_t* mData = nullptr;
+    uint32_t mSize = 0;
+
+    // If true, this buffer allocated the data and must delete it.
+    bool mOwned = false;
+
+    // If the data comes from a mapped file, the buffer owns the mapping.
+    MappedFile* mMappedFile = nullptr;
+
+    void Clear();
+};
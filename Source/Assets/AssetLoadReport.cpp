@@ -0,0 +1,158 @@
+#include "AssetLoadReport.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include "StringUtil.h"
+
+namespace
+{
+    // Combined stats for a group of asset loads (e.g. all textures, or all assets from one Barn).
+    struct LoadTotals
+    {
+        std::string name;
+        int count = 0;
+        float lookupMs = 0.0f;
+        float ioMs = 0.0f;
+        float decompressMs = 0.0f;
+        float parseMs = 0.0f;
+        uint64_t bytesIn = 0;
+        uint64_t bytesOut = 0;
+
+        void Add(const AssetLoadRecord& record)
+        {
+            ++count;
+            lookupMs += record.lookupMs;
+            ioMs += record.ioMs;
+            decompressMs += record.decompressMs;
+            parseMs += record.parseMs;
+            bytesIn += record.bytesIn;
+            bytesOut += record.bytesOut;
+        }
+
+        float GetTotalMs() const { return lookupMs + ioMs + decompressMs + parseMs; }
+    };
+
+    void WriteTotals(std::stringstream& ss, const char* heading, const std::map<std::string, LoadTotals>& groups)
+    {
+        // Output the most expensive groups first.
+        std::vector<const LoadTotals*> sortedGroups;
+        for(auto& entry : groups)
+        {
+            sortedGroups.push_back(&entry.second);
+        }
+        std::sort(sortedGroups.begin(), sortedGroups.end(), [](const LoadTotals* a, const LoadTotals* b){
+            return a->GetTotalMs() > b->GetTotalMs();
+        });
+
+        ss << std::endl << heading << std::endl;
+        ss << StringUtil::Format("  %-16s %6s %10s %10s %10s %10s %10s %10s %10s", "Name", "Count", "Total ms", "Lookup ms",
+                                 "I/O ms", "Decomp ms", "Parse ms", "In KB", "Out KB") << std::endl;
+        for(const LoadTotals* totals : sortedGroups)
+        {
+            ss << StringUtil::Format("  %-16s %6d %10.2f %10.2f %10.2f %10.2f %10.2f %10.1f %10.1f", totals->name.c_str(), totals->count,
+                                     totals->GetTotalMs(), totals->lookupMs, totals->ioMs, totals->decompressMs, totals->parseMs,
+                                     totals->bytesIn / 1024.0f, totals->bytesOut / 1024.0f) << std::endl;
+        }
+    }
+}
+
+void AssetLoadReport::Begin(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mName = name;
+    mStopwatch.Reset();
+    mElapsedMs = -1.0f;
+    mRecords.clear();
+}
+
+void AssetLoadReport::End()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mElapsedMs = mStopwatch.GetMilliseconds();
+}
+
+void AssetLoadReport::AddRecord(const AssetLoadRecord& record)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRecords.push_back(record);
+}
+
+std::string AssetLoadReport::ToString(size_t slowestCount) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Group records by asset type (extension), source, and thread.
+    LoadTotals allTotals;
+    std::map<std::string, LoadTotals> typeTotals;
+    std::map<std::string, LoadTotals> sourceTotals;
+    std::map<std::string, LoadTotals> threadTotals;
+    std::vector<std::thread::id> workerThreadIds;
+    for(const AssetLoadRecord& record : mRecords)
+    {
+        allTotals.Add(record);
+
+        std::size_t dotIndex = record.assetName.find_last_of('.');
+        std::string type = dotIndex != std::string::npos ? record.assetName.substr(dotIndex + 1) : "(none)";
+        typeTotals[type].name = type;
+        typeTotals[type].Add(record);
+
+        sourceTotals[record.source].name = record.source;
+        sourceTotals[record.source].Add(record);
+
+        // Number worker threads in the order they show up, so they're easy to tell apart.
+        std::string thread = "Main";
+        if(!record.mainThread)
+        {
+            auto it = std::find(workerThreadIds.begin(), workerThreadIds.end(), record.threadId);
+            if(it == workerThreadIds.end())
+            {
+                it = workerThreadIds.insert(workerThreadIds.end(), record.threadId);
+            }
+            thread = "Worker " + std::to_string(it - workerThreadIds.begin() + 1);
+        }
+        threadTotals[thread].name = thread;
+        threadTotals[thread].Add(record);
+    }
+
+    std::stringstream ss;
+    ss << "Asset load report for " << mName << std::endl;
+    if(mElapsedMs >= 0.0f)
+    {
+        ss << StringUtil::Format("Load took %.2f ms", mElapsedMs) << std::endl;
+    }
+    else
+    {
+        ss << StringUtil::Format("Load in progress for %.2f ms", mStopwatch.GetMilliseconds()) << std::endl;
+    }
+    ss << StringUtil::Format("%d assets loaded in %.2f ms (lookup %.2f, I/O %.2f, decompress %.2f, parse %.2f), %.1f KB in, %.1f KB out",
+                             allTotals.count, allTotals.GetTotalMs(), allTotals.lookupMs, allTotals.ioMs, allTotals.decompressMs,
+                             allTotals.parseMs, allTotals.bytesIn / 1024.0f, allTotals.bytesOut / 1024.0f) << std::endl;
+
+    WriteTotals(ss, "By type:", typeTotals);
+    WriteTotals(ss, "By source:", sourceTotals);
+    WriteTotals(ss, "By thread:", threadTotals);
+
+    // List the slowest individual asset loads.
+    std::vector<const AssetLoadRecord*> slowestRecords;
+    for(const AssetLoadRecord& record : mRecords)
+    {
+        slowestRecords.push_back(&record);
+    }
+    slowestCount = std::min(slowestCount, slowestRecords.size());
+    std::partial_sort(slowestRecords.begin(), slowestRecords.begin() + slowestCount, slowestRecords.end(),
+                      [](const AssetLoadRecord* a, const AssetLoadRecord* b){
+        return a->GetTotalMs() > b->GetTotalMs();
+    });
+
+    ss << std::endl << "Slowest assets:" << std::endl;
+    for(size_t i = 0; i < slowestCount; ++i)
+    {
+        const AssetLoadRecord* record = slowestRecords[i];
+        ss << StringUtil::Format("  %-24s %-16s %10.2f ms (lookup %.2f, I/O %.2f, decompress %.2f, parse %.2f)", record->assetName.c_str(),
+                                 record->source.c_str(), record->GetTotalMs(), record->lookupMs, record->ioMs, record->decompressMs,
+                                 record->parseMs) << std::endl;
+    }
+    return ss.str();
+}
@@ -0,0 +1,72 @@
+//
+// Clark Kromenaker
+//
+// Timing and size info for every asset load, collected into a report (usually, one per scene load).
+// Shows which asset types, Barns, and threads dominate startup and scene change times.
+//
+#pragma once
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Profiler.h"
+
+struct AssetLoadRecord
+{
+    // The asset that was loaded.
+    std::string assetName;
+
+    // Where the asset's data came from: a Barn name, "Loose" file, "Cooked" file, or "Prefetched" by a manifest.
+    std::string source;
+
+    // Milliseconds spent finding the asset, reading/mapping its data, decompressing it, and parsing it.
+    // Parse time doesn't include other assets loaded while parsing - those have records of their own.
+    // Mapped data is only read from disk when first touched, so some I/O time may show up as parse time.
+    float lookupMs = 0.0f;
+    float ioMs = 0.0f;
+    float decompressMs = 0.0f;
+    float parseMs = 0.0f;
+
+    // Size of the asset's data as stored (possibly compressed), and as passed to the asset for parsing.
+    uint32_t bytesIn = 0;
+    uint32_t bytesOut = 0;
+
+    // The thread that loaded the asset.
+    std::thread::id threadId;
+    bool mainThread = false;
+
+    float GetTotalMs() const { return lookupMs + ioMs + decompressMs + parseMs; }
+};
+
+class AssetLoadReport
+{
+public:
+    // Clears out any previous records and starts timing a new report.
+    void Begin(const std::string& name);
+
+    // Marks the end of the process being reported on (e.g. the scene is loaded).
+    // Assets loaded after this (e.g. async loads still in progress) are still added to the report.
+    void End();
+
+    // Adds a record - safe to call from any thread.
+    void AddRecord(const AssetLoadRecord& record);
+
+    // Outputs totals by asset type, source, and thread, along with the slowest individual loads.
+    std::string ToString(size_t slowestCount = 10) const;
+
+private:
+    // Name of the report (e.g. the scene being loaded).
+    std::string mName = "Startup";
+
+    // Measures how long the reported process took, from Begin to End.
+    Stopwatch mStopwatch;
+    float mElapsedMs = -1.0f;
+
+    // Records for every asset loaded since the report began.
+    std::vector<AssetLoadRecord> mRecords;
+
+    // Assets are loaded on many threads, so records need protection.
+    mutable std::mutex mMutex;
+};
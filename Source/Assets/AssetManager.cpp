@@ -1,18 +1,27 @@
 #include "AssetManager.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
+#include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include "FileSystem.h"
 #include "Loader.h"
+#include "MemoryTracker.h"
 #include "mstream.h"
+#include "Paths.h"
 #include "Renderer.h"
 #include "SheepManager.h"
 #include "StringUtil.h"
 #include "ThreadPool.h"
+#include "ThreadUtil.h"
 
 // Includes for all asset types
 #include "Animation.h"
@@ -36,14 +45,44 @@
 
 AssetManager gAssetManager;
 
+namespace
+{
+    // Assets currently being loaded on this thread, innermost last.
+    // If an asset loads other assets while loading, it depends on those assets.
+    thread_local std::vector<Asset*> sLoadingAssets;
+
+    // Load records for assets currently being loaded on this thread, innermost last.
+    thread_local std::vector<AssetLoadRecord*> sLoadRecords;
+
+    // Identifies a cooked asset file ("COOK").
+    const uint32_t kCookedAssetMagic = 0x4B4F4F43;
+
+    // Cooked files being written get a unique temporary name, so assets loading at the same time don't clobber each other's files.
+    std::atomic<unsigned int> sCookedTempFileIndex { 0 };
+
+    // 64-bit FNV-1a hash - fast, and plenty good enough to tell whether an asset's data has changed.
+    uint64_t HashData(const uint8_t* data, uint32_t dataSize)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for(uint32_t i = 0; i < dataSize; ++i)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
 void AssetManager::Init()
 {
     // Load GK3.ini from the root directory so we can bootstrap asset search paths.
     mSearchPaths.push_back("");
+    RescanSearchPaths();
     Config* config = LoadConfig("GK3.ini");
     mSearchPaths.clear();
 
     // The config should be present, but is technically optional.
+    bool cookAssets = true;
     if(config != nullptr)
     {
         // Load "high priority" custom paths, if any.
@@ -55,6 +94,24 @@ void AssetManager::Init()
             std::vector<std::string> paths = StringUtil::Split(customPaths, ';');
             mSearchPaths.insert(mSearchPaths.end(), paths.begin(), paths.end());
         }
+
+        // Amount of memory (in MB) to keep unused assets loaded between scenes.
+        int residencyBudgetMB = config->GetInt("Asset Cache Size", static_cast<int>(mResidencyBudget / (1024 * 1024)));
+        mResidencyBudget = static_cast<size_t>(residencyBudgetMB) * 1024 * 1024;
+
+        // Whether to save cooked versions of assets, so they load faster next time.
+        cookAssets = config->GetBool("Cook Assets", cookAssets);
+    }
+
+    // Cooked assets live with save data, since the data path may not be writable.
+    if(cookAssets)
+    {
+        std::string cookedAssetsPath = Paths::GetSaveDataPath("Cooked");
+        if(Directory::Create(cookedAssetsPath))
+        {
+            mCookedAssetsPath = cookedAssetsPath;
+            FindCookedFiles();
+        }
     }
 
     // Add hard-coded default paths *after* any custom paths specified in .INI file.
@@ -63,6 +120,9 @@ void AssetManager::Init()
 
     // Data: content shipped with the original game; lowest priority so assets can be easily overridden.
     mSearchPaths.push_back("Data");
+
+    // Index all files on the search paths, so we don't need to hit the file system on every asset load.
+    RescanSearchPaths();
 }
 
 void AssetManager::Shutdown()
@@ -71,6 +131,10 @@ void AssetManager::Shutdown()
     UnloadAssets(AssetScope::Global);
 
     // Clear all loaded barns.
+    WaitForBarns();
+    std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+    mAssetDirectory.clear();
+    mUnindexedSearchPaths.clear();
     mLoadedBarns.clear();
 }
 
@@ -81,22 +145,54 @@ void AssetManager::AddSearchPath(const std::string& searchPath)
     {
         return;
     }
-    mSearchPaths.push_back(searchPath);
+
+    // Add the search path and index its files.
+    {
+        std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+        mSearchPaths.push_back(searchPath);
+        IndexSearchPath(mSearchPaths.size() - 1);
+    }
+
+    // Some assets may now come from this path, so their cooked files may differ.
+    ForgetCookedAssets();
 }
 
-std::string AssetManager::GetAssetPath(const std::string& fileName)
+void AssetManager::RescanSearchPaths()
 {
-    // We have a set of paths, at which we should search for the specified filename.
-    // So, iterate each search path and see if the file is in that folder.
-    std::string assetPath;
-    for(auto& searchPath : mSearchPaths)
+    std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+
+    // Forget all loose files. Entries that only existed as loose files can be removed entirely.
+    for(auto it = mAssetDirectory.begin(); it != mAssetDirectory.end();)
     {
-        if(Path::FindFullPath(fileName, searchPath, assetPath))
+        if(it->second.barn == nullptr && it->second.missingBarnName == nullptr)
         {
-            return assetPath;
+            it = mAssetDirectory.erase(it);
+        }
+        else
+        {
+            it->second.filePath.clear();
+            it->second.searchPathIndex = SIZE_MAX;
+            ++it;
         }
     }
-    return std::string();
+    mUnindexedSearchPaths.clear();
+
+    // Index each search path again.
+    for(size_t i = 0; i < mSearchPaths.size(); ++i)
+    {
+        IndexSearchPath(i);
+    }
+
+    // Files may have been added, removed, or replaced - so cooked files may differ too.
+    ForgetCookedAssets();
+}
+
+std::string AssetManager::GetAssetPath(const std::string& fileName)
+{
+    // The asset directory knows the path to any loose file on any search path.
+    AssetLocation location;
+    FindAssetLocation(fileName, location);
+    return location.filePath;
 }
 
 std::string AssetManager::GetAssetPath(const std::string& fileName, std::initializer_list<std::string> extensions)
@@ -123,6 +219,7 @@ std::string AssetManager::GetAssetPath(const std::string& fileName, std::initial
 bool AssetManager::LoadBarn(const std::string& barnName)
 {
     // If the barn is already in the map, then we don't need to load it again.
+    WaitForBarns();
     if(mLoadedBarns.find(barnName) != mLoadedBarns.end()) { return true; }
     
     // Find path to barn file.
@@ -132,19 +229,32 @@ bool AssetManager::LoadBarn(const std::string& barnName)
 		return false;
     }
     
-    // Load barn file.
-    mLoadedBarns.emplace(barnName, assetPath);
+    // Load barn file, and add its assets to the asset directory.
+    std::unique_ptr<BarnFile> barn(new BarnFile(assetPath));
+    {
+        std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+        auto result = mLoadedBarns.emplace(barnName, std::move(barn));
+        IndexBarn(*result.first->second);
+    }
+    ForgetCookedAssets();
 	return true;
 }
 
 void AssetManager::UnloadBarn(const std::string& barnName)
 {
     // If the barn isn't in the map, we can't unload it!
+    WaitForBarns();
     auto iter = mLoadedBarns.find(barnName);
     if(iter == mLoadedBarns.end()) { return; }
     
     // Remove from map.
-    mLoadedBarns.erase(iter);
+    // Assets in other Barns may point to this Barn, so it's simplest to just rebuild the index of Barn assets.
+    {
+        std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+        mLoadedBarns.erase(iter);
+        RebuildBarnIndex();
+    }
+    ForgetCookedAssets();
 }
 
 void AssetManager::WriteBarnAssetToFile(const std::string& assetName)
@@ -169,20 +279,75 @@ void AssetManager::WriteAllBarnAssetsToFile(const std::string& search)
 void AssetManager::WriteAllBarnAssetsToFile(const std::string& search, const std::string& outputDir)
 {
 	// Pass the buck to all loaded barn files.
+    WaitForBarns();
 	for(auto& entry : mLoadedBarns)
 	{
-		entry.second.WriteAllToFile(search, outputDir);
+		entry.second->WriteAllToFile(search, outputDir);
 	}
 }
 
+void AssetManager::LoadBarnsAsync(const std::vector<std::string>& barnNames)
+{
+    // Only one batch of Barns loads at a time.
+    WaitForBarns();
+
+    // Find each Barn's path up front. Skip any that are already loaded or can't be found.
+    std::shared_ptr<LoadingBarns> loadingBarns = std::make_shared<LoadingBarns>();
+    for(const std::string& barnName : barnNames)
+    {
+        if(mLoadedBarns.find(barnName) != mLoadedBarns.end()) { continue; }
+
+        std::string assetPath = GetAssetPath(barnName);
+        if(!assetPath.empty())
+        {
+            loadingBarns->names.push_back(barnName);
+            loadingBarns->paths.push_back(assetPath);
+        }
+    }
+    if(loadingBarns->names.empty()) { return; }
+    loadingBarns->barns.resize(loadingBarns->names.size());
+
+    // From here on, asset lookups know to wait for these Barns.
+    {
+        std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+        mLoadingBarns = loadingBarns;
+    }
+
+    // One task per Barn, so all Barns can be parsed at once.
+    // Any thread waiting on the Barns pitches in too, so waiting never depends on a free thread pool thread.
+    for(size_t i = 0; i < loadingBarns->names.size(); ++i)
+    {
+        ThreadPool::AddTask([this, loadingBarns](){
+            ParseLoadingBarns(loadingBarns);
+        });
+    }
+}
+
+void AssetManager::WaitForBarns()
+{
+    std::shared_ptr<LoadingBarns> loadingBarns;
+    {
+        std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+        loadingBarns = mLoadingBarns;
+    }
+    if(loadingBarns == nullptr) { return; }
+
+    // Rather than sit idle, help parse any Barns that haven't been claimed yet. Then wait for the rest to finish.
+    ParseLoadingBarns(loadingBarns);
+    std::unique_lock<std::mutex> lock(mAssetDirectoryMutex);
+    mBarnsLoadedCondition.wait(lock, [this, &loadingBarns](){
+        return mLoadingBarns != loadingBarns;
+    });
+}
+
 Audio* AssetManager::LoadAudio(const std::string& name, AssetScope scope)
 {
-    return LoadAsset<Audio>(SanitizeAssetName(name, ".WAV"), scope, &mAudioCache, false);
+    return LoadAsset<Audio>(SanitizeAssetName(name, ".WAV"), scope, &mAudioCache);
 }
 
 Audio* AssetManager::LoadAudioAsync(const std::string& name, AssetScope scope)
 {
-    return LoadAssetAsync<Audio>(SanitizeAssetName(name, ".WAV"), scope, &mAudioCache, false);
+    return LoadAssetAsync<Audio>(SanitizeAssetName(name, ".WAV"), scope, &mAudioCache);
 }
 
 Soundtrack* AssetManager::LoadSoundtrack(const std::string& name, AssetScope scope)
@@ -303,8 +468,7 @@ Font* AssetManager::LoadFont(const std::string& name, AssetScope scope)
 
 TextAsset* AssetManager::LoadText(const std::string& name, AssetScope scope)
 {
-    // Specifically DO NOT delete the asset buffer when creating TextAssets, since they take direct ownership of it.
-    return LoadAsset<TextAsset>(name, scope, &mTextAssetCache, false);
+    return LoadAsset<TextAsset>(name, scope, &mTextAssetCache);
 }
 
 Config* AssetManager::LoadConfig(const std::string& name)
@@ -337,8 +501,8 @@ Shader* AssetManager::LoadShader(const std::string& vertName, const std::string&
 
     // Ok, we have to actually load this shader...
     // Load the vertex and fragment shader files from the disk.
-    TextAsset* vertShader = LoadAsset<TextAsset>(vertName + ".vert", AssetScope::Global, &mShaderFileCache, false);
-    TextAsset* fragShader = LoadAsset<TextAsset>(fragName + ".frag", AssetScope::Global, &mShaderFileCache, false);
+    TextAsset* vertShader = LoadAsset<TextAsset>(vertName + ".vert", AssetScope::Global, &mShaderFileCache);
+    TextAsset* fragShader = LoadAsset<TextAsset>(fragName + ".frag", AssetScope::Global, &mShaderFileCache);
 
     // Create the shader from the text assets.
     Shader* shader = new Shader(shaderName, vertShader, fragShader);
@@ -350,35 +514,250 @@ Shader* AssetManager::LoadShader(const std::string& vertName, const std::string&
 
 void AssetManager::UnloadAssets(AssetScope scope)
 {
-    mShaderCache.Unload(scope);
+    // Unloading at global scope deletes everything.
+    // Otherwise, assets at the scope are retained, and only deleted if the residency budget is exceeded.
+    auto unload = [this, scope](auto& cache) {
+        if(scope == AssetScope::Global)
+        {
+            cache.Unload(scope);
+        }
+        else
+        {
+            RetainAssets(&cache, scope);
+        }
+    };
+
+    // Some assets are changed at runtime by gameplay: BSP objects are hidden or retextured, and model meshes are posed by vertex animations.
+    // Reviving one of those would show the changes from its last use, rather than its parsed state. So, those are deleted rather than retained.
+    auto unloadMutable = [this, scope](auto& cache) {
+        if(scope == AssetScope::Global)
+        {
+            cache.Unload(scope);
+        }
+        else
+        {
+            DeleteAssets(&cache, scope);
+        }
+    };
+
+    unload(mShaderCache);
+
+    unload(mConfigCache);
+    unload(mTextAssetCache);
+
+    unload(mFontCache);
+    unload(mCursorCache);
+
+    unload(mSheepCache);
+
+    unload(mBspLightmapCache);
+    unloadMutable(mBspCache);
+
+    unload(mNvcCache);
+    unload(mSceneAssetCache);
+    unload(mSifCache);
+
+    unload(mSequenceCache);
+    unload(mVertexAnimationCache);
+    unload(mMomAnimationCache);
+    unload(mAnimationCache);
+    unload(mGasCache);
+
+    unload(mTextureCache);
+    unloadMutable(mModelCache);
+
+    unload(mYakCache);
+    unload(mSoundtrackCache);
+    unload(mAudioCache);
+
+    if(scope == AssetScope::Global)
+    {
+        // Everything was deleted, so no residency info is needed anymore.
+        std::lock_guard<std::mutex> lock(mResidencyMutex);
+        mResidency.clear();
+        mRetainedAssets.clear();
+        mRetainedBytes = 0;
+    }
+    else
+    {
+        // Retaining assets may have put us over budget.
+        EvictRetainedAssets();
+    }
+}
+
+void AssetManager::SetResidencyBudget(size_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mResidencyMutex);
+        mResidencyBudget = bytes;
+    }
+    EvictRetainedAssets();
+}
 
-    mConfigCache.Unload(scope);
-    mTextAssetCache.Unload(scope);
+AssetManager::ResidencyStats AssetManager::GetResidencyStats()
+{
+    std::lock_guard<std::mutex> lock(mResidencyMutex);
+    ResidencyStats stats;
+    stats.residentCount = mResidency.size();
+    for(auto& entry : mResidency)
+    {
+        stats.residentBytes += entry.second.size;
+    }
+    stats.retainedCount = mRetainedAssets.size();
+    stats.retainedBytes = mRetainedBytes;
+    stats.budgetBytes = mResidencyBudget;
+    return stats;
+}
 
-    mFontCache.Unload(scope);
-    mCursorCache.Unload(scope);
+void AssetManager::BeginManifest(const std::string& manifestName)
+{
+    // Read in the list of assets recorded last time this manifest was used, if any.
+    std::vector<std::string> assetNames;
+    std::ifstream manifestFile(Paths::GetSaveDataPath(Path::Combine({ "Manifests", manifestName + ".txt" })));
+    std::string line;
+    while(std::getline(manifestFile, line))
+    {
+        StringUtil::Trim(line);
+        if(!line.empty())
+        {
+            assetNames.push_back(line);
+        }
+    }
 
-    mSheepCache.Unload(scope);
+    // Only compressed Barn assets are worth prefetching - other assets are mapped into memory, with nothing to decompress.
+    // Assets with a cooked file are skipped too, since they'll load from that file instead.
+    // Group these by Barn, so each Barn can extract its assets in one batch.
+    std::unordered_map<BarnFile*, std::vector<std::string>> barnAssetNames;
+    for(const std::string& assetName : assetNames)
+    {
+        AssetLocation location;
+        if(FindAssetLocation(assetName, location) && location.filePath.empty() &&
+           location.barnAsset->compressionType != CompressionType::None && !GetCookedAsset(assetName).exists)
+        {
+            barnAssetNames[location.barn].push_back(assetName);
+        }
+    }
+
+    // Start recording assets loaded from here on out.
+    {
+        std::lock_guard<std::mutex> lock(mManifestMutex);
+        mManifestName = manifestName;
+        mManifestAssets.clear();
+    }
+
+    // Decompress everything in the background, holding onto the data until the assets are loaded.
+    // This doesn't hold up the scene load - if an asset is needed before it's prefetched, it's just loaded as normal.
+    // One task per Barn, which extracts all of that Barn's assets as a batch - spread across the thread pool, rather than one at a time on a loader thread.
+    for(auto& entry : barnAssetNames)
+    {
+        BarnFile* barn = entry.first;
+        std::vector<std::string> assetNames = std::move(entry.second);
+        Loader::Load([this, barn, assetNames, manifestName](){
+            // No point in prefetching if the asset was already loaded, or the manifest has ended. Caller must hold the manifest mutex.
+            // Assets still in memory from an earlier scene (cached or retained) won't be loaded again, so their data would never be claimed.
+            auto isNeeded = [this, &manifestName](const std::string& assetName){
+                return mManifestName == manifestName && mManifestAssets.find(assetName) == mManifestAssets.end();
+            };
+
+            std::vector<std::string> neededAssetNames;
+            {
+                std::lock_guard<std::mutex> lock(mManifestMutex);
+                for(const std::string& assetName : assetNames)
+                {
+                    if(isNeeded(assetName))
+                    {
+                        neededAssetNames.push_back(assetName);
+                    }
+                }
+            }
+            neededAssetNames.erase(std::remove_if(neededAssetNames.begin(), neededAssetNames.end(), [this](const std::string& assetName){
+                return IsAssetCached(assetName);
+            }), neededAssetNames.end());
+
+            // Assets may have been loaded while they were being decompressed, so check again before holding onto the data.
+            barn->ExtractMany(neededAssetNames, [this, &isNeeded](const std::string& assetName, AssetBuffer& buffer){
+                if(!buffer.IsValid() || IsAssetCached(assetName)) { return; }
+                std::lock_guard<std::mutex> lock(mManifestMutex);
+                if(isNeeded(assetName))
+                {
+                    mPrefetchedAssets[assetName] = std::move(buffer);
+                }
+            });
+        }, LoadPriority::Prefetch, manifestName);
+    }
+}
 
-    mBspLightmapCache.Unload(scope);
-    mBspCache.Unload(scope);
+bool AssetManager::IsAssetCached(const std::string& assetName)
+{
+    // Retained assets stay in their cache until evicted, so this covers those as well.
+    bool cached = false;
+    auto check = [&assetName, &cached](auto& cache) {
+        if(cached) { return; }
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cached = cache.cache.find(assetName) != cache.cache.end();
+    };
+    check(mAudioCache);
+    check(mSoundtrackCache);
+    check(mYakCache);
+
+    check(mModelCache);
+    check(mTextureCache);
+
+    check(mAnimationCache);
+    check(mMomAnimationCache);
+    check(mSequenceCache);
+    check(mVertexAnimationCache);
+    check(mGasCache);
+
+    check(mSifCache);
+    check(mSceneAssetCache);
+    check(mNvcCache);
+
+    check(mBspCache);
+    check(mBspLightmapCache);
+
+    check(mSheepCache);
+
+    check(mCursorCache);
+    check(mFontCache);
+
+    check(mTextAssetCache);
+    check(mConfigCache);
+
+    check(mShaderFileCache);
+    check(mShaderCache);
+    return cached;
+}
 
-    mNvcCache.Unload(scope);
-    mSceneAssetCache.Unload(scope);
-    mSifCache.Unload(scope);
+void AssetManager::EndManifest()
+{
+    // Any prefetches that haven't started yet are no longer useful.
+    std::string manifestName;
+    {
+        std::lock_guard<std::mutex> lock(mManifestMutex);
+        manifestName = mManifestName;
+    }
+    if(manifestName.empty()) { return; }
+    Loader::Cancel(manifestName);
 
-    mSequenceCache.Unload(scope);
-    mVertexAnimationCache.Unload(scope);
-    mMomAnimationCache.Unload(scope);
-    mAnimationCache.Unload(scope);
-    mGasCache.Unload(scope);
+    std::lock_guard<std::mutex> lock(mManifestMutex);
+    if(mManifestName.empty()) { return; }
 
-    mTextureCache.Unload(scope);
-    mModelCache.Unload(scope);
+    // Save the recorded asset list, replacing any previous version of this manifest.
+    std::string manifestsPath = Paths::GetSaveDataPath("Manifests");
+    if(Directory::Create(manifestsPath))
+    {
+        std::ofstream manifestFile(Path::Combine({ manifestsPath, mManifestName + ".txt" }));
+        for(const std::string& assetName : mManifestAssets)
+        {
+            manifestFile << assetName << std::endl;
+        }
+    }
+    mManifestName.clear();
+    mManifestAssets.clear();
 
-    mYakCache.Unload(scope);
-    mSoundtrackCache.Unload(scope);
-    mAudioCache.Unload(scope);
+    // Any prefetched data that wasn't used (e.g. asset was already loaded, or isn't needed this time) can be freed.
+    mPrefetchedAssets.clear();
 }
 
 BarnFile* AssetManager::GetBarn(const std::string& barnName)
@@ -387,7 +766,7 @@ BarnFile* AssetManager::GetBarn(const std::string& barnName)
 	auto iter = mLoadedBarns.find(barnName);
 	if(iter != mLoadedBarns.end())
 	{
-		return &iter->second;
+		return iter->second.get();
 	}
 	
 	//TODO: Maybe load barn if not loaded?
@@ -396,32 +775,166 @@ BarnFile* AssetManager::GetBarn(const std::string& barnName)
 
 BarnFile* AssetManager::GetBarnContainingAsset(const std::string& fileName)
 {
-	// Iterate over all loaded barn files to find the asset.
-	for(auto& entry : mLoadedBarns)
-	{
-		BarnAsset* asset = entry.second.GetAsset(fileName);
-		if(asset != nullptr)
-		{
-			// If the asset is a pointer, we need to redirect to the correct BarnFile.
-			// If the correct Barn isn't available, spit out an error and fail.
-			if(asset->IsPointer())
-			{
-                BarnFile* barn = GetBarn(*asset->barnFileName);
-                if(barn == nullptr)
-                {
-                    std::cout << "Asset " << fileName << " exists in Barn " << (*asset->barnFileName) << ", but that Barn is not loaded!" << std::endl;
-                }
-                return barn;
-			}
-			else
-			{
-				return &entry.second;
-			}
-		}
-	}
-	
-	// Didn't find the Barn containing this asset.
-	return nullptr;
+    // Pointer assets were already resolved when the Barn was indexed.
+    AssetLocation location;
+    FindAssetLocation(fileName, location);
+    return location.barn;
+}
+
+void AssetManager::IndexSearchPath(size_t searchPathIndex)
+{
+    // Get all files in the search path directory.
+    const std::string& searchPath = mSearchPaths[searchPathIndex];
+    std::vector<std::string> fileNames;
+    if(!Directory::GetFiles(searchPath, fileNames))
+    {
+        #if defined(PLATFORM_MAC)
+        // On Mac, search paths may refer to resources in the app bundle, which aren't relative to the working directory.
+        // These can't be listed as a plain directory, so they must be checked on disk during lookup instead.
+        mUnindexedSearchPaths.push_back(searchPathIndex);
+        #endif
+        return;
+    }
+
+    // Record each file, unless it was already found on a higher priority search path.
+    for(const std::string& fileName : fileNames)
+    {
+        AssetLocation& location = mAssetDirectory[fileName];
+        if(searchPathIndex < location.searchPathIndex)
+        {
+            location.filePath = Path::Combine({ searchPath, fileName });
+            location.searchPathIndex = searchPathIndex;
+        }
+    }
+}
+
+void AssetManager::IndexBarn(BarnFile& barn)
+{
+    for(auto& entry : barn.GetAssets())
+    {
+        // If another loaded Barn already contains this asset, stick with that one.
+        AssetLocation& location = mAssetDirectory[entry.first];
+        if(location.barn != nullptr) { continue; }
+
+        // If the asset is a pointer, resolve it to the Barn that actually contains the data.
+        // If that Barn isn't loaded yet, its assets will fill in this entry once it is loaded.
+        const BarnAsset& asset = entry.second;
+        if(asset.IsPointer())
+        {
+            BarnFile* pointedBarn = GetBarn(*asset.barnFileName);
+            if(pointedBarn == nullptr)
+            {
+                location.missingBarnName = asset.barnFileName;
+                continue;
+            }
+
+            BarnAsset* pointedAsset = pointedBarn->GetAsset(entry.first);
+            if(pointedAsset != nullptr && !pointedAsset->IsPointer())
+            {
+                location.barn = pointedBarn;
+                location.barnAsset = pointedAsset;
+                location.missingBarnName = nullptr;
+            }
+        }
+        else
+        {
+            location.barn = &barn;
+            location.barnAsset = &asset;
+            location.missingBarnName = nullptr;
+        }
+    }
+}
+
+void AssetManager::RebuildBarnIndex()
+{
+    // Forget all Barn assets. Entries that only existed in Barns can be removed entirely.
+    for(auto it = mAssetDirectory.begin(); it != mAssetDirectory.end();)
+    {
+        if(it->second.filePath.empty())
+        {
+            it = mAssetDirectory.erase(it);
+        }
+        else
+        {
+            it->second.barn = nullptr;
+            it->second.barnAsset = nullptr;
+            it->second.missingBarnName = nullptr;
+            ++it;
+        }
+    }
+
+    // Index each loaded Barn again.
+    for(auto& entry : mLoadedBarns)
+    {
+        IndexBarn(*entry.second);
+    }
+}
+
+void AssetManager::ParseLoadingBarns(const std::shared_ptr<LoadingBarns>& loadingBarns)
+{
+    size_t barnCount = loadingBarns->barns.size();
+    size_t index = 0;
+    while((index = loadingBarns->nextIndex++) < barnCount)
+    {
+        {
+            TIMER_SCOPED_VAR(loadingBarns->names[index].c_str(), barnTimer);
+            loadingBarns->barns[index].reset(new BarnFile(loadingBarns->paths[index]));
+        }
+
+        // Once the last Barn is parsed, add all the Barns to the asset directory.
+        if(++loadingBarns->doneCount == barnCount)
+        {
+            // Index Barns in the order they were requested, so the same Barn wins if an asset exists in several Barns.
+            std::lock_guard<std::mutex> lock(mAssetDirectoryMutex);
+            for(size_t i = 0; i < barnCount; ++i)
+            {
+                auto result = mLoadedBarns.emplace(loadingBarns->names[i], std::move(loadingBarns->barns[i]));
+                IndexBarn(*result.first->second);
+            }
+            mLoadingBarns.reset();
+            mBarnsLoadedCondition.notify_all();
+            ForgetCookedAssets();
+        }
+    }
+}
+
+bool AssetManager::FindAssetLocation(const std::string& assetName, AssetLocation& outLocation)
+{
+    std::unique_lock<std::mutex> lock(mAssetDirectoryMutex);
+
+    // Find the asset in the directory.
+    auto it = mAssetDirectory.find(assetName);
+    outLocation = (it != mAssetDirectory.end()) ? it->second : AssetLocation();
+
+    // Any unindexed search paths with higher priority than the found file (if any) must be checked on disk.
+    for(size_t searchPathIndex : mUnindexedSearchPaths)
+    {
+        if(searchPathIndex >= outLocation.searchPathIndex) { break; }
+
+        std::string assetPath;
+        if(Path::FindFullPath(assetName, mSearchPaths[searchPathIndex], assetPath))
+        {
+            outLocation.filePath = assetPath;
+            outLocation.searchPathIndex = searchPathIndex;
+            break;
+        }
+    }
+
+    // Loose files take precedence over Barn assets. But if there's no loose file, the asset may be in a Barn that's still loading.
+    // In that case, wait for the Barns to load and try again.
+    if(outLocation.filePath.empty() && mLoadingBarns != nullptr)
+    {
+        lock.unlock();
+        WaitForBarns();
+        return FindAssetLocation(assetName, outLocation);
+    }
+
+    // If the asset only exists as a pointer to an unloaded Barn, spit out an error and fail.
+    if(outLocation.filePath.empty() && outLocation.barn == nullptr && outLocation.missingBarnName != nullptr)
+    {
+        std::cout << "Asset " << assetName << " exists in Barn " << (*outLocation.missingBarnName) << ", but that Barn is not loaded!" << std::endl;
+    }
+    return !outLocation.filePath.empty() || outLocation.barn != nullptr;
 }
 
 std::string AssetManager::SanitizeAssetName(const std::string& assetName, const std::string& expectedExtension)
@@ -442,143 +955,731 @@ std::string AssetManager::SanitizeAssetName(const std::string& assetName, const
 }
 
 template<typename T>
-T* AssetManager::LoadAsset(const std::string& assetName, AssetScope scope, AssetCache<T>* cache, bool deleteBuffer)
+T* AssetManager::LoadAsset(const std::string& assetName, AssetScope scope, AssetCache<T>* cache)
 {
+    MemoryTagScope memoryTag(MemoryTag::Assets);
+
     // If already present in cache, return existing asset right away.
-    if(cache != nullptr && scope != AssetScope::Manual)
+    bool useCache = cache != nullptr && scope != AssetScope::Manual;
+    if(useCache)
     {
-        T* cachedAsset = cache->Get(assetName);
+        T* cachedAsset = GetCachedAsset(assetName, cache);
         if(cachedAsset != nullptr)
         {
-            // One caveat: if the cached asset has a narrower scope than what's being requested, we must PROMOTE the scope.
-            // For example, a cached asset with SCENE scope being requested at GLOBAL scope must convert to GLOBAL scope.
-            if(cachedAsset->GetScope() == AssetScope::Scene && scope == AssetScope::Global)
-            {
-                cachedAsset->SetScope(AssetScope::Global);
-            }
-            return cachedAsset;
+            return UseCachedAsset(assetName, scope, cache, cachedAsset, true);
         }
     }
     //printf("Loading asset %s\n", assetName.c_str());
     
-    // Create buffer containing this asset's data. If this fails, the asset doesn't exist, so we can't load it.
-    uint32_t bufferSize = 0;
-    uint8_t* buffer = CreateAssetBuffer(assetName, bufferSize);
-    if(buffer == nullptr) { return nullptr; }
+    // If the asset doesn't exist, we can't load it.
+    AssetLocation location;
+    if(!FindAssetLocation(assetName, location))
+    {
+        return nullptr;
+    }
 
-    // Create asset from asset buffer.
+    // Create the asset.
     std::string upperName = StringUtil::ToUpperCopy(assetName);
     T* asset = new T(upperName, scope);
 
-    // Add entry in cache, if we have a cache.
-    if(asset != nullptr && cache != nullptr && scope != AssetScope::Manual)
+    // Without a cache, nobody else knows about this asset - just load it on this thread. If its data couldn't be read after all, get rid of it.
+    if(!useCache)
     {
-        cache->Set(assetName, asset);
+        if(LoadAssetData(asset) != AssetLoadState::Ready)
+        {
+            delete asset;
+            return nullptr;
+        }
+        return asset;
     }
 
-    // Load the asset on the main thread.
-    asset->Load(buffer, bufferSize);
-
-    // Delete the buffer after use (or it'll leak).
-    if(deleteBuffer)
+    // Otherwise, other threads may ask for this asset while it loads.
+    // So, it's loaded just like an async asset (but right here): pending until loaded, and only then moved into the cache.
+    // If another thread started loading this asset first, use its asset instead.
+    asset->SetLoadState(AssetLoadState::Pending);
+    T* cachedAsset = GetCachedAsset(assetName, cache, asset);
+    if(cachedAsset != asset)
     {
-        delete[] buffer;
+        delete asset;
     }
-	return asset;
+    return UseCachedAsset(assetName, scope, cache, cachedAsset, true);
 }
 
 template<typename T>
-T* AssetManager::LoadAssetAsync(const std::string& assetName, AssetScope scope, AssetCache<T>* cache, bool deleteBuffer, std::function<void(T*)> callback)
+T* AssetManager::LoadAssetAsync(const std::string& assetName, AssetScope scope, AssetCache<T>* cache, std::function<void(T*)> callback)
 {
-    #if defined(PLATFORM_LINUX)
-    //TEMP(?): Linux doesn't like this multithreading code, and I don't really blame it!
-    //TODO: Revisit async asset loading - probably need to wrap caches in mutexes I'd think? Or some other issue?
-    T* asset = LoadAsset<T>(assetName, scope, cache, deleteBuffer);
-    if(callback != nullptr) { callback(asset); }
-    return asset;
-    #else
+    MemoryTagScope memoryTag(MemoryTag::Assets);
+
     // If already present in cache, return existing asset right away.
-    if(cache != nullptr && scope != AssetScope::Manual)
+    // This may be an asset that is still loading - callers can check or wait on its load state.
+    bool useCache = cache != nullptr && scope != AssetScope::Manual;
+    if(useCache)
     {
-        T* cachedAsset = cache->Get(assetName);
+        T* cachedAsset = GetCachedAsset(assetName, cache);
         if(cachedAsset != nullptr)
         {
-            // One caveat: if the cached asset has a narrower scope than what's being requested, we must PROMOTE the scope.
-            // For example, a cached asset with SCENE scope being requested at GLOBAL scope must convert to GLOBAL scope.
-            if(cachedAsset->GetScope() == AssetScope::Scene && scope == AssetScope::Global)
-            {
-                cachedAsset->SetScope(AssetScope::Global);
-            }
-            return cachedAsset;
+            return UseCachedAsset(assetName, scope, cache, cachedAsset, false);
         }
     }
     //printf("Loading asset %s\n", assetName.c_str());
 
-    // Create asset from asset buffer.
+    // Make sure the asset exists before creating it.
+    // Thanks to the asset directory, this is cheap - and it means we never create or cache an asset that can't be loaded.
+    AssetLocation location;
+    if(!FindAssetLocation(assetName, location))
+    {
+        return nullptr;
+    }
+
+    // Create the asset, which is pending until its data has been loaded.
     std::string upperName = StringUtil::ToUpperCopy(assetName);
     T* asset = new T(upperName, scope);
+    asset->SetLoadState(AssetLoadState::Pending);
 
-    // Add entry in cache, if we have a cache.
-    //TODO: This inserts the asset into the cache *even if* it is not a valid asset (CreateAssetBuffer returns nullptr).
-    //TODO: Ideally, we shouldn't do this - I guess we need to check if it exists before creating it???
-    if(asset != nullptr && cache != nullptr && scope != AssetScope::Manual)
+    // Add a pending entry in cache, if we have a cache.
+    // The asset only moves into the cache proper once it is loaded.
+    // If another thread started loading this asset first, use its asset instead.
+    if(useCache)
     {
-        cache->Set(assetName, asset);
+        T* cachedAsset = GetCachedAsset(assetName, cache, asset);
+        if(cachedAsset != asset)
+        {
+            delete asset;
+            return UseCachedAsset(assetName, scope, cache, cachedAsset, false);
+        }
     }
     
     // Load in background.
+    // Cached assets are referred to by name, since the asset may be loaded by another thread (or unloaded) before this task runs.
     Loader::AddLoadingTask();
-    ThreadPool::AddTask([this, deleteBuffer](void* arg){
-        T* asset = static_cast<T*>(arg);
-        //printf("Loading asset: %s\n", asset->GetName().c_str());
-
-        // Create buffer containing this asset's data. If this fails, the asset doesn't exist, so we can't load it.
-        uint32_t bufferSize = 0;
-        uint8_t* buffer = CreateAssetBuffer(asset->GetName(), bufferSize);
-        if(buffer == nullptr) { return; }
-
-        // Ok, now we can load the asset's data.
-        asset->Load(buffer, bufferSize);
-
-        // Delete the buffer after use (or it'll leak).
-        if(deleteBuffer)
+    ThreadPool::AddTask([this, assetName, asset, cache, useCache](){
+        //printf("Loading asset: %s\n", assetName.c_str());
+        if(useCache)
         {
-            delete[] buffer;
+            LoadPendingAsset(assetName, cache);
         }
-    }, asset, [this, asset, callback](){
-        //printf("Loaded asset: %s\n", asset->GetName().c_str());
-        if(callback != nullptr)
+        else
         {
-            callback(asset);
+            asset->SetLoadState(LoadAssetData(asset));
+        }
+    }, [assetName, asset, cache, useCache, callback](){
+        // Likewise, a cached asset may have been unloaded (and deleted) before this callback runs - in that case, there's nothing to report.
+        T* loadedAsset = useCache ? cache->Get(assetName) : asset;
+        if(callback != nullptr && loadedAsset != nullptr)
+        {
+            callback(loadedAsset);
         }
         Loader::RemoveLoadingTask();
     });
 
     // Return the created asset.
     return asset;
-    #endif
 }
 
-uint8_t* AssetManager::CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize)
+template<typename T>
+T* AssetManager::UseCachedAsset(const std::string& assetName, AssetScope scope, AssetCache<T>* cache, T* cachedAsset, bool wait)
 {
-	// First, see if the asset exists at any asset search path.
-	// If so, we load the asset directly from file.
+    // If the asset is still pending and we need it right now, it must be loaded before it can be used.
+    if(wait)
+    {
+        if(cachedAsset->GetLoadState() == AssetLoadState::Pending)
+        {
+            // An asset being loaded further up this thread's stack is loading itself, through some circular dependency.
+            // Waiting would never finish, so it's used as-is - this is why such assets have a separate load function.
+            if(std::find(sLoadingAssets.begin(), sLoadingAssets.end(), cachedAsset) != sLoadingAssets.end())
+            {
+                return cachedAsset;
+            }
+
+            // If no thread has started loading it yet, load it on this thread. Otherwise, wait for the other thread to finish.
+            LoadPendingAsset(assetName, cache);
+        }
+        if(!cachedAsset->WaitForLoad())
+        {
+            return nullptr;
+        }
+    }
+    OnAssetUsed(cachedAsset);
+
+    // Assets already in memory are still part of whatever is being loaded. The manifest must list them too, or a later cold load won't prefetch them.
+    RecordManifestAsset(assetName);
+
+    // One caveat: if the cached asset has a narrower scope than what's being requested, we must PROMOTE the scope.
+    // For example, a cached asset with SCENE scope being requested at GLOBAL scope must convert to GLOBAL scope.
+    if(cachedAsset->GetScope() == AssetScope::Scene && scope == AssetScope::Global)
+    {
+        cachedAsset->SetScope(AssetScope::Global);
+    }
+    return cachedAsset;
+}
+
+template<typename T>
+void AssetManager::LoadPendingAsset(const std::string& assetName, AssetCache<T>* cache)
+{
+    // If the asset was already claimed by another thread (or unloaded), nothing to do.
+    T* asset = cache->ClaimPending(assetName);
+    if(asset == nullptr) { return; }
+
+    // Load the data, and move the asset into the cache if it loaded successfully.
+    AddResident(asset, assetName, cache, 0);
+    AssetLoadState loadState = LoadAssetData(asset);
+    if(loadState != AssetLoadState::Ready)
+    {
+        RemoveResident(asset);
+    }
+    cache->FinishPending(assetName, loadState);
+}
+
+template<typename T>
+AssetLoadState AssetManager::LoadAssetData(T* asset)
+{
+    MemoryTagScope memoryTag(MemoryTag::Assets);
+    PROFILER_SCOPED_NAMED("Load Asset Data");
+
+    // Keep track of where this asset's load time goes, for the load report.
+    Stopwatch stopwatch;
+    AssetLoadRecord record;
+    record.assetName = asset->GetName();
+    record.threadId = std::this_thread::get_id();
+    record.mainThread = ThreadUtil::OnMainThread();
+
+    sLoadRecords.push_back(&record);
+    AssetLoadState loadState = LoadAssetData(asset, record);
+    sLoadRecords.pop_back();
+
+    // If this asset was loaded while parsing another asset, that time shouldn't count as parse time for the other asset.
+    if(!sLoadRecords.empty())
+    {
+        sLoadRecords.back()->parseMs -= stopwatch.GetMilliseconds();
+    }
+    if(loadState == AssetLoadState::Ready)
+    {
+        mLoadReport.AddRecord(record);
+    }
+    return loadState;
+}
+
+template<typename T>
+AssetLoadState AssetManager::LoadAssetData(T* asset, AssetLoadRecord& record)
+{
+    // If a cooked version of this asset exists, load that instead - no parsing required.
+    // The asset counts towards the manifest either way, even though its source data isn't needed.
+    CookedAssetInfo cookedAsset = GetCookedAsset(asset, record);
+    const std::string& cookedAssetPath = cookedAsset.path;
+    if(cookedAsset.exists && LoadCookedAsset(asset, cookedAssetPath, record))
+    {
+        RecordManifestAsset(asset->GetName());
+        return AssetLoadState::Ready;
+    }
+
+    // Create buffer containing this asset's data. If this fails, the asset can't be loaded.
+    AssetBuffer buffer = CreateAssetBuffer(asset->GetName(), &record);
+    if(!buffer.IsValid()) { return AssetLoadState::Failed; }
+
+    // Now that we know the size of the asset's data, we know (roughly) how much memory it uses.
+    SetResidentSize(asset, buffer.GetSize());
+
+    // Ok, now we can load the asset's data.
+    // The buffer cleans itself up afterwards, unless the asset took ownership of it.
+    Stopwatch parseStopwatch;
+    sLoadingAssets.push_back(asset);
+    asset->Load(buffer);
+    sLoadingAssets.pop_back();
+    record.parseMs += parseStopwatch.GetMilliseconds();
+
+    // Cook the asset, so it loads faster next time.
+    if(!cookedAssetPath.empty())
+    {
+        Stopwatch cookStopwatch;
+        WriteCookedAsset(asset, cookedAssetPath);
+        record.ioMs += cookStopwatch.GetMilliseconds();
+    }
+    return AssetLoadState::Ready;
+}
+
+template<typename T>
+void AssetManager::AddResident(T* asset, const std::string& assetName, AssetCache<T>* cache, uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(mResidencyMutex);
+    ResidencyInfo& info = mResidency[asset];
+    info.size = size;
+    info.evict = [cache, assetName](){
+        return cache->Take(assetName);
+    };
+}
+
+template<typename T>
+T* AssetManager::GetCachedAsset(const std::string& assetName, AssetCache<T>* cache, T* newPendingAsset)
+{
+    std::lock_guard<std::mutex> lock(mResidencyMutex);
+    T* cachedAsset = newPendingAsset != nullptr ? cache->GetOrSetPending(assetName, newPendingAsset) : cache->Get(assetName);
+    if(cachedAsset != nullptr)
+    {
+        MarkAssetUsed(cachedAsset);
+    }
+    return cachedAsset;
+}
+
+void AssetManager::RemoveResident(Asset* asset)
+{
+    std::lock_guard<std::mutex> lock(mResidencyMutex);
+    auto it = mResidency.find(asset);
+    if(it == mResidency.end()) { return; }
+
+    // This asset no longer holds onto its dependencies.
+    for(Asset* dependency : it->second.dependencies)
+    {
+        auto dependencyIt = mResidency.find(dependency);
+        if(dependencyIt != mResidency.end())
+        {
+            --dependencyIt->second.refCount;
+        }
+    }
+
+    if(it->second.retained)
+    {
+        mRetainedAssets.erase(it->second.lruIt);
+        mRetainedBytes -= it->second.size;
+    }
+    mResidency.erase(it);
+}
+
+void AssetManager::SetResidentSize(Asset* asset, uint32_t size)
+{
+    std::lock_guard<std::mutex> lock(mResidencyMutex);
+    auto it = mResidency.find(asset);
+    if(it != mResidency.end())
+    {
+        it->second.size = size;
+    }
+}
+
+void AssetManager::OnAssetUsed(Asset* asset)
+{
+    std::lock_guard<std::mutex> lock(mResidencyMutex);
+    MarkAssetUsed(asset);
+}
+
+void AssetManager::MarkAssetUsed(Asset* asset)
+{
+    auto it = mResidency.find(asset);
+    if(it == mResidency.end()) { return; }
+
+    // If this asset (or anything it depends on) was retained, it's in use again.
+    std::vector<Asset*> usedAssets = { asset };
+    while(!usedAssets.empty())
+    {
+        auto usedIt = mResidency.find(usedAssets.back());
+        usedAssets.pop_back();
+        if(usedIt != mResidency.end() && usedIt->second.retained)
+        {
+            usedIt->second.retained = false;
+            mRetainedAssets.erase(usedIt->second.lruIt);
+            mRetainedBytes -= usedIt->second.size;
+            usedAssets.insert(usedAssets.end(), usedIt->second.dependencies.begin(), usedIt->second.dependencies.end());
+        }
+    }
+
+    // If another asset is loading on this thread, that asset depends on this one.
+    if(!sLoadingAssets.empty() && sLoadingAssets.back() != asset)
+    {
+        auto parentIt = mResidency.find(sLoadingAssets.back());
+        if(parentIt != mResidency.end())
+        {
+            std::vector<Asset*>& dependencies = parentIt->second.dependencies;
+            if(std::find(dependencies.begin(), dependencies.end(), asset) == dependencies.end())
+            {
+                dependencies.push_back(asset);
+                ++it->second.refCount;
+            }
+        }
+    }
+}
+
+template<typename T>
+void AssetManager::RetainAssets(AssetCache<T>* cache, AssetScope scope)
+{
+    // Pending assets at this scope are cancelled, or waited on if already loading.
+    cache->UnloadPending(scope);
+
+    // Find cached assets at this scope.
+    std::vector<std::pair<std::string, T*>> assets;
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        for(auto& entry : cache->cache)
+        {
+            if(entry.second->GetScope() == scope)
+            {
+                assets.emplace_back(entry.first, entry.second);
+            }
+        }
+    }
+
+    // Rather than deleting these assets, keep them around in case they're used again.
+    // Assets with no residency info (not loaded via LoadAsset) are simply deleted, as before.
+    std::vector<std::string> untrackedAssets;
+    {
+        std::lock_guard<std::mutex> lock(mResidencyMutex);
+        for(auto& entry : assets)
+        {
+            auto it = mResidency.find(entry.second);
+            if(it == mResidency.end())
+            {
+                untrackedAssets.push_back(entry.first);
+            }
+            else if(!it->second.retained)
+            {
+                it->second.retained = true;
+                it->second.lruIt = mRetainedAssets.insert(mRetainedAssets.begin(), entry.second);
+                mRetainedBytes += it->second.size;
+            }
+        }
+    }
+    for(auto& assetName : untrackedAssets)
+    {
+        cache->Remove(assetName);
+    }
+}
+
+template<typename T>
+void AssetManager::DeleteAssets(AssetCache<T>* cache, AssetScope scope)
+{
+    // Pending assets at this scope are cancelled, or waited on if already loading.
+    cache->UnloadPending(scope);
+
+    // Find cached assets at this scope.
+    std::vector<std::pair<std::string, T*>> assets;
+    {
+        std::lock_guard<std::mutex> lock(cache->mutex);
+        for(auto& entry : cache->cache)
+        {
+            if(entry.second->GetScope() == scope)
+            {
+                assets.emplace_back(entry.first, entry.second);
+            }
+        }
+    }
+
+    // Residency info must go before the asset does, so nothing refers to a deleted asset.
+    for(auto& entry : assets)
+    {
+        RemoveResident(entry.second);
+        cache->Remove(entry.first);
+    }
+}
+
+void AssetManager::EvictRetainedAssets()
+{
+    // Assets are taken out of their caches while holding the lock, so no load can find an asset that's about to be deleted.
+    // But they're deleted afterwards - deleting an asset could conceivably load/unload others.
+    std::vector<Asset*> evictedAssets;
+    {
+        std::lock_guard<std::mutex> lock(mResidencyMutex);
+        while(true)
+        {
+            // Changed assets must be reloaded if used again, so they're evicted as soon as no other resident asset depends on them.
+            // Otherwise, evict the least recently used asset that no other resident asset depends on, until within budget.
+            bool overBudget = mRetainedBytes > mResidencyBudget;
+            auto candidateIt = mRetainedAssets.end();
+            for(auto it = mRetainedAssets.rbegin(); it != mRetainedAssets.rend(); ++it)
+            {
+                if(mResidency.at(*it).refCount == 0 && (overBudget || (*it)->IsChanged()))
+                {
+                    candidateIt = std::prev(it.base());
+                    break;
+                }
+            }
+
+            // If every retained asset is depended on by some other asset (or nothing needs evicting), we're done.
+            if(candidateIt == mRetainedAssets.end()) { break; }
+
+            // Remove residency info for the asset. Its dependencies lose a reference, and may be evicted next.
+            auto infoIt = mResidency.find(*candidateIt);
+            mRetainedAssets.erase(candidateIt);
+            mRetainedBytes -= infoIt->second.size;
+            for(Asset* dependency : infoIt->second.dependencies)
+            {
+                auto dependencyIt = mResidency.find(dependency);
+                if(dependencyIt != mResidency.end())
+                {
+                    --dependencyIt->second.refCount;
+                }
+            }
+            Asset* evictedAsset = infoIt->second.evict();
+            if(evictedAsset != nullptr)
+            {
+                evictedAssets.push_back(evictedAsset);
+            }
+            mResidency.erase(infoIt);
+        }
+    }
+
+    for(Asset* asset : evictedAssets)
+    {
+        delete asset;
+    }
+}
+
+AssetManager::CookedAssetInfo AssetManager::GetCookedAsset(const Asset* asset, AssetLoadRecord& record)
+{
+    // Nothing to do if cooking is disabled, or this type of asset can't be cooked.
+    if(mCookedAssetsPath.empty() || asset->GetCookedVersion() == 0) { return CookedAssetInfo(); }
+
+    Stopwatch stopwatch;
+    CookedAssetInfo info = GetCookedAsset(asset->GetName());
+    record.ioMs += stopwatch.GetMilliseconds();
+    return info;
+}
+
+AssetManager::CookedAssetInfo AssetManager::GetCookedAsset(const std::string& assetName)
+{
+    if(mCookedAssetsPath.empty()) { return CookedAssetInfo(); }
+
+    // If this asset was already looked up this session, no need to hit the file system again.
+    uint32_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(mCookedAssetsMutex);
+        auto it = mCookedAssets.find(assetName);
+        if(it != mCookedAssets.end()) { return it->second; }
+        generation = mCookedAssetsGeneration;
+    }
+
+    // Find where the asset's source data lives.
+    CookedAssetInfo info;
+    AssetLocation location;
+    if(FindAssetLocation(assetName, location))
+    {
+        // Identify the source data by where it's stored, rather than its contents - no need to read (or decompress) the data at all.
+        // Replacing the file (e.g. a modded asset or a patched Barn) changes its modified time, so the cooked file no longer matches.
+        std::string sourceKey;
+        if(!location.filePath.empty())
+        {
+            sourceKey = StringUtil::Format("%s|%llu|%llu", location.filePath.c_str(),
+                                           static_cast<unsigned long long>(File::Size(location.filePath)),
+                                           static_cast<unsigned long long>(File::ModifiedTime(location.filePath)));
+        }
+        else
+        {
+            uint32_t storedSize = 0;
+            if(location.barn->GetStoredAssetData(*location.barnAsset, storedSize) != nullptr)
+            {
+                sourceKey = StringUtil::Format("%s|%u|%u|%llu", location.barn->GetName().c_str(), location.barnAsset->offset, storedSize,
+                                               static_cast<unsigned long long>(File::ModifiedTime(location.barn->GetName())));
+            }
+        }
+
+        if(!sourceKey.empty())
+        {
+            char hash[17];
+            snprintf(hash, sizeof(hash), "%016llx",
+                     static_cast<unsigned long long>(HashData(reinterpret_cast<const uint8_t*>(sourceKey.data()), static_cast<uint32_t>(sourceKey.size()))));
+            info.path = Path::Combine({ mCookedAssetsPath, StringUtil::ToUpperCopy(assetName) + "." + hash });
+            info.exists = File::ModifiedTime(info.path) != 0;
+        }
+    }
+
+    // Remember this for next time - unless the asset directory changed in the meantime, in which case this may already be out of date.
+    std::lock_guard<std::mutex> lock(mCookedAssetsMutex);
+    if(generation == mCookedAssetsGeneration)
+    {
+        mCookedAssets[assetName] = info;
+    }
+    return info;
+}
+
+void AssetManager::ForgetCookedAssets()
+{
+    std::lock_guard<std::mutex> lock(mCookedAssetsMutex);
+    mCookedAssets.clear();
+    ++mCookedAssetsGeneration;
+}
+
+bool AssetManager::LoadCookedAsset(Asset* asset, const std::string& cookedAssetPath, AssetLoadRecord& record)
+{
+    // No cooked file yet? Asset must be loaded normally.
+    Stopwatch stopwatch;
+    AssetBuffer buffer = AssetBuffer::MakeFromFile(cookedAssetPath);
+    record.ioMs += stopwatch.GetMilliseconds();
+    if(!buffer.IsValid()) { return false; }
+
+    // Make sure the cooked file is in the format the asset currently expects.
+    stopwatch.Reset();
+    BinaryReader reader(buffer.GetData(), buffer.GetSize());
+    bool loaded = reader.ReadUInt() == kCookedAssetMagic && reader.ReadUInt() == asset->GetCookedVersion() && asset->LoadCooked(reader);
+    record.parseMs += stopwatch.GetMilliseconds();
+    if(!loaded) { return false; }
+
+    record.source = "Cooked";
+    record.bytesIn = record.bytesOut = buffer.GetSize();
+    SetResidentSize(asset, buffer.GetSize());
+    return true;
+}
+
+void AssetManager::WriteCookedAsset(const Asset* asset, const std::string& cookedAssetPath)
+{
+    // Write to a temporary file, and only move it into place once complete.
+    // That way, a partially written cooked file is never loaded (e.g. if the game quits mid-write).
+    std::string tempPath = cookedAssetPath + "." + std::to_string(sCookedTempFileIndex++) + ".tmp";
+    bool cooked = false;
+    {
+        BinaryWriter writer(tempPath.c_str());
+        if(!writer.OK()) { return; }
+
+        writer.WriteUInt(kCookedAssetMagic);
+        writer.WriteUInt(asset->GetCookedVersion());
+        cooked = asset->WriteCooked(writer) && writer.OK();
+    }
+
+    // Replace any existing cooked file (e.g. an old cooked version).
+    if(cooked)
+    {
+        std::remove(cookedAssetPath.c_str());
+        cooked = std::rename(tempPath.c_str(), cookedAssetPath.c_str()) == 0;
+    }
+    if(!cooked)
+    {
+        std::remove(tempPath.c_str());
+        return;
+    }
+
+    // The cooked file exists now, so later loads (and prefetches) know to use it.
+    {
+        std::lock_guard<std::mutex> lock(mCookedAssetsMutex);
+        auto it = mCookedAssets.find(asset->GetName());
+        if(it != mCookedAssets.end() && it->second.path == cookedAssetPath)
+        {
+            it->second.exists = true;
+        }
+    }
+
+    // Delete cooked files for older versions of this asset's source data - they'll never be used again.
+    // From now on, the file just written is the only one for this asset, so it's the one deleted if the asset is cooked again.
+    std::string cookedFileName = Path::GetFileName(cookedAssetPath);
+    std::vector<std::string> staleFileNames;
+    {
+        std::lock_guard<std::mutex> lock(mCookedAssetsMutex);
+        std::vector<std::string>& fileNames = mCookedFiles[asset->GetName()];
+        for(const std::string& fileName : fileNames)
+        {
+            if(!StringUtil::EqualsIgnoreCase(fileName, cookedFileName))
+            {
+                staleFileNames.push_back(fileName);
+            }
+        }
+        fileNames.assign(1, cookedFileName);
+    }
+    for(const std::string& fileName : staleFileNames)
+    {
+        std::remove(Path::Combine({ mCookedAssetsPath, fileName }).c_str());
+    }
+}
+
+void AssetManager::FindCookedFiles()
+{
+    // Called once at startup, before anything is cooked. So, any temporary files are left over from writes that never finished.
+    std::vector<std::string> fileNames;
+    Directory::GetFiles(mCookedAssetsPath, fileNames);
+    for(const std::string& fileName : fileNames)
+    {
+        if(StringUtil::EndsWithIgnoreCase(fileName, ".tmp"))
+        {
+            std::remove(Path::Combine({ mCookedAssetsPath, fileName }).c_str());
+            continue;
+        }
+
+        // Cooked files are named "<asset name>.<hash>", where the hash is 16 hex digits.
+        std::size_t hashIndex = fileName.find_last_of('.');
+        if(hashIndex != std::string::npos && fileName.size() - hashIndex - 1 == 16)
+        {
+            mCookedFiles[fileName.substr(0, hashIndex)].push_back(fileName);
+        }
+    }
+}
+
+void AssetManager::RecordManifestAsset(const std::string& assetName)
+{
+    std::lock_guard<std::mutex> lock(mManifestMutex);
+    if(!mManifestName.empty())
+    {
+        mManifestAssets.insert(assetName);
+    }
+}
+
+AssetBuffer AssetManager::CreateAssetBuffer(const std::string& assetName, AssetLoadRecord* record)
+{
+    // If recording a manifest, note that this asset was loaded.
+    // If this asset's data was already prefetched, hand it off.
+    Stopwatch stopwatch;
+    RecordManifestAsset(assetName);
+    AssetBuffer prefetchedBuffer;
+    {
+        std::lock_guard<std::mutex> lock(mManifestMutex);
+        auto it = mPrefetchedAssets.find(assetName);
+        if(it != mPrefetchedAssets.end())
+        {
+            prefetchedBuffer = std::move(it->second);
+            mPrefetchedAssets.erase(it);
+        }
+    }
+    if(prefetchedBuffer.IsValid())
+    {
+        // The time spent decompressing prefetched data is part of beginning the manifest, not this load.
+        if(record != nullptr)
+        {
+            record->source = "Prefetched";
+            record->lookupMs += stopwatch.GetMilliseconds();
+            record->bytesOut = prefetchedBuffer.GetSize();
+        }
+        return prefetchedBuffer;
+    }
+
+    // Find where this asset lives.
+    AssetLocation location;
+    bool found = FindAssetLocation(assetName, location);
+    if(record != nullptr)
+    {
+        record->lookupMs += stopwatch.GetMilliseconds();
+        stopwatch.Reset();
+    }
+    if(!found)
+    {
+        // Couldn't find this asset!
+        return AssetBuffer();
+    }
+
+	// If the asset exists at any asset search path, we load the asset directly from file.
 	// Loose files take precedence over packaged barn assets.
-	std::string assetPath = GetAssetPath(assetName);
-	if(!assetPath.empty())
+	if(!location.filePath.empty())
 	{
-        return File::ReadIntoBuffer(assetPath, outBufferSize);
+        AssetBuffer buffer = AssetBuffer::MakeFromFile(location.filePath);
+        if(record != nullptr)
+        {
+            record->source = "Loose";
+            record->ioMs += stopwatch.GetMilliseconds();
+            record->bytesIn = record->bytesOut = buffer.GetSize();
+        }
+        return buffer;
 	}
 	
 	// If no file to load, we'll get the asset from a barn.
-	BarnFile* barn = GetBarnContainingAsset(assetName);
-	if(barn != nullptr)
-	{
-        return barn->CreateAssetBuffer(assetName, outBufferSize);
-	}
-	
-	// Couldn't find this asset!
-	return nullptr;
+    AssetBuffer buffer = location.barn->CreateAssetBuffer(*location.barnAsset);
+    if(record != nullptr)
+    {
+        // Compressed assets spend their time decompressing. Uncompressed assets are just borrowed from the mapped Barn.
+        float elapsedMs = stopwatch.GetMilliseconds();
+        if(location.barnAsset->compressionType != CompressionType::None)
+        {
+            record->decompressMs += elapsedMs;
+        }
+        else
+        {
+            record->ioMs += elapsedMs;
+        }
+        record->source = location.barn->GetName();
+        record->bytesIn = location.barnAsset->size;
+        record->bytesOut = buffer.GetSize();
+    }
+    return buffer;
 }
 
 template<class T>
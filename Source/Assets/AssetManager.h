@@ -4,12 +4,20 @@
 // Manages loading and caching of assets.
 //
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Asset.h"
+#include "AssetLoadReport.h"
 #include "BarnFile.h"
 #include "StringUtil.h"
 
@@ -43,6 +51,10 @@ public:
     // Loose Files
 	// Adds a filesystem path to search for assets and bundles at.
     void AddSearchPath(const std::string& searchPath);
+
+    // Rebuilds the index of loose files on all search paths.
+    // Only needed if files are added to or removed from a search path while the game is running.
+    void RescanSearchPaths();
     
     // Given a filename, finds the path to the file if it exists on one of the search paths.
     // Returns empty string if file is not found.
@@ -53,6 +65,12 @@ public:
 	// Load or unload a barn bundle.
     bool LoadBarn(const std::string& barnName);
     void UnloadBarn(const std::string& barnName);
+
+    // Loads several Barns at once - each Barn's asset directory is parsed in parallel on background threads.
+    // Until all the Barns are loaded, looking up any asset that isn't a loose file waits for them.
+    // Barns that can't be found are skipped, so check for them beforehand (e.g. with GetAssetPath) if they're required.
+    void LoadBarnsAsync(const std::vector<std::string>& barnNames);
+    void WaitForBarns();
 	
 	// Write an asset from a bundle to a file.
     void WriteBarnAssetToFile(const std::string& assetName);
@@ -63,6 +81,8 @@ public:
 	void WriteAllBarnAssetsToFile(const std::string& search, const std::string& outputDir);
 
     // Loading (or Getting) Assets
+    // Async variants return right away, with an asset that may still be pending - use the asset's load state to poll or wait.
+    // Async variants return null if the asset doesn't exist.
     Audio* LoadAudio(const std::string& name, AssetScope scope = AssetScope::Global);
     Audio* LoadAudioAsync(const std::string& name, AssetScope scope = AssetScope::Global);
     Soundtrack* LoadSoundtrack(const std::string& name, AssetScope scope = AssetScope::Global);
@@ -100,7 +120,36 @@ public:
     Shader* LoadShader(const std::string& vertName, const std::string& fragName);
 
     // Unloading Assets
+    // Scene assets aren't deleted right away - they are retained in case the next scene uses them too.
+    // The exception is assets that gameplay changes at runtime (BSPs, models, and any changed textures), which must be reloaded to get back to their parsed state.
+    // Retained assets are deleted (least recently used first) once their combined size exceeds the residency budget.
     void UnloadAssets(AssetScope scope);
+    void SetResidencyBudget(size_t bytes);
+    size_t GetRetainedBytes() const { return mRetainedBytes; }
+
+    struct ResidencyStats
+    {
+        // All cached assets (in use or retained), and just the retained ones.
+        size_t residentCount = 0;
+        size_t residentBytes = 0;
+        size_t retainedCount = 0;
+        size_t retainedBytes = 0;
+        size_t budgetBytes = 0;
+    };
+    ResidencyStats GetResidencyStats();
+
+    // Asset Manifests
+    // A manifest lists the assets loaded during some process (e.g. loading a scene).
+    // Beginning a manifest fetches/decompresses all assets listed from the last time that manifest was recorded - in parallel, up front.
+    // Any assets loaded (or found already loaded) until the manifest ends are recorded, and the manifest is saved for next time.
+    void BeginManifest(const std::string& manifestName);
+    void EndManifest();
+
+    // Asset Load Reports
+    // Every asset load is timed and measured. Loads are collected into a report, which restarts with each scene load.
+    void BeginLoadReport(const std::string& reportName) { mLoadReport.Begin(reportName); }
+    void EndLoadReport() { mLoadReport.End(); }
+    const AssetLoadReport& GetLoadReport() const { return mLoadReport; }
     
 private:
     // A list of paths to search for assets.
@@ -109,23 +158,93 @@ private:
     
     // A map of loaded barn files. If an asset isn't found on any search path,
     // we then search each loaded barn file for the asset.
-    std::string_map_ci<BarnFile> mLoadedBarns;
+    std::string_map_ci<std::unique_ptr<BarnFile>> mLoadedBarns;
+
+    // Barns being loaded in the background. Any thread can claim and parse the next Barn.
+    struct LoadingBarns
+    {
+        std::vector<std::string> names;
+        std::vector<std::string> paths;
+        std::vector<std::unique_ptr<BarnFile>> barns;
+        std::atomic<size_t> nextIndex { 0 };
+        std::atomic<size_t> doneCount { 0 };
+    };
+    std::shared_ptr<LoadingBarns> mLoadingBarns;
+
+    // Signaled once all loading Barns have been added to the asset directory.
+    std::condition_variable mBarnsLoadedCondition;
+
+    // Where an asset's data can be found.
+    struct AssetLocation
+    {
+        // If the asset exists as a loose file on a search path, the path to that file.
+        // Loose files take precedence over Barn assets.
+        std::string filePath;
+
+        // Index of the search path containing the loose file (lower is higher priority).
+        size_t searchPathIndex = SIZE_MAX;
+
+        // If the asset exists in a loaded Barn, the Barn and asset handle.
+        // Pointer assets are resolved up front, so this is always the Barn that actually contains the data.
+        BarnFile* barn = nullptr;
+        const BarnAsset* barnAsset = nullptr;
+
+        // If the asset is a pointer to a Barn that isn't loaded, the name of that Barn (for error reporting).
+        const std::string* missingBarnName = nullptr;
+    };
+
+    // A single directory of every known asset, built as search paths are scanned and Barns are loaded.
+    // Finding where an asset lives is a single lookup - no iterating Barns, and no file system calls.
+    std::string_map_ci<AssetLocation> mAssetDirectory;
+
+    // Search paths that couldn't be scanned (e.g. not a plain directory on this platform).
+    // These are still checked on disk for each lookup, to preserve search path priority.
+    std::vector<size_t> mUnindexedSearchPaths;
+
+    // Assets may be looked up on any thread, but the directory is modified on the main thread.
+    std::mutex mAssetDirectoryMutex;
+
+    // The name of the manifest being recorded, if any, and the assets loaded since it began.
+    std::string mManifestName;
+    std::string_set_ci mManifestAssets;
+
+    // Asset data prefetched from a manifest. Handed off to the asset when it is actually loaded.
+    std::string_map_ci<AssetBuffer> mPrefetchedAssets;
+
+    // Assets are loaded on many threads, so manifest data needs protection.
+    std::mutex mManifestMutex;
     
     // A list of loaded assets, so we can just return existing assets if already loaded.
     template<typename T>
     struct AssetCache
     {
+        // Assets that are fully loaded and ready to use.
         std::string_map_ci<T*> cache;
 
+        // Assets being loaded (or whose load failed).
+        // These only move to the cache once loaded, so the cache never contains half-loaded assets.
+        struct PendingAsset
+        {
+            T* asset = nullptr;
+
+            // Set once some thread has started loading the asset, so it's only loaded once.
+            bool claimed = false;
+        };
+        std::string_map_ci<PendingAsset> pending;
+
         // A mutex is required since we allow loading assets on any thread.
         // We don't want multiple threads modifying the cache at the same time.
         std::mutex mutex;
 
+        // Gets a cached asset - this may be pending, if it's being loaded asynchronously.
         T* Get(const std::string& name)
         {
             std::lock_guard<std::mutex> lock(mutex);
             auto it = cache.find(name);
-            return it != cache.end() ? it->second : nullptr;
+            if(it != cache.end()) { return it->second; }
+
+            auto pendingIt = pending.find(name);
+            return pendingIt != pending.end() ? pendingIt->second.asset : nullptr;
         }
 
         void Set(const std::string& name, T* asset)
@@ -134,8 +253,77 @@ private:
             cache[name] = asset;
         }
 
+        // Adds an asset as pending, unless an asset with this name is already cached or pending - in which case, that asset is returned instead.
+        // Checking and adding at once means that if two threads load the same asset, only one of them creates it.
+        T* GetOrSetPending(const std::string& name, T* asset)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(name);
+            if(it != cache.end()) { return it->second; }
+
+            PendingAsset& pendingAsset = pending[name];
+            if(pendingAsset.asset == nullptr)
+            {
+                pendingAsset.asset = asset;
+            }
+            return pendingAsset.asset;
+        }
+
+        // Claims a pending asset for loading. Returns null if the asset isn't pending, or another thread already claimed it.
+        T* ClaimPending(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = pending.find(name);
+            if(it == pending.end() || it->second.claimed) { return nullptr; }
+            it->second.claimed = true;
+            return it->second.asset;
+        }
+
+        // Removes a cached asset, without deleting it. Returns null if the asset isn't cached.
+        T* Take(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(name);
+            if(it == cache.end()) { return nullptr; }
+            T* asset = it->second;
+            cache.erase(it);
+            return asset;
+        }
+
+        // Removes and deletes a cached asset.
+        void Remove(const std::string& name)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = cache.find(name);
+            if(it != cache.end())
+            {
+                delete it->second;
+                cache.erase(it);
+            }
+        }
+
+        // Called after a pending asset's data is loaded (or fails to load). Ready assets move into the cache.
+        void FinishPending(const std::string& name, AssetLoadState loadState)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = pending.find(name);
+            if(it == pending.end()) { return; }
+
+            T* asset = it->second.asset;
+            if(loadState == AssetLoadState::Ready)
+            {
+                cache[name] = asset;
+                pending.erase(it);
+            }
+
+            // Setting the state wakes any waiting threads, so do it last.
+            asset->SetLoadState(loadState);
+        }
+
         void Unload(AssetScope scope = AssetScope::Global)
         {
+            UnloadPending(scope);
+
             std::lock_guard<std::mutex> lock(mutex);
             if(scope == AssetScope::Global)
             {
@@ -163,6 +351,61 @@ private:
                 }
             }
         }
+
+        void UnloadPending(AssetScope scope)
+        {
+            // Pending assets may be loading on other threads - can't delete those out from under them!
+            // Any that haven't started loading are cancelled. Any that have started must finish before we continue.
+            std::vector<T*> loadingAssets;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for(auto& entry : pending)
+                {
+                    if(scope == AssetScope::Global || entry.second.asset->GetScope() == scope)
+                    {
+                        if(!entry.second.claimed)
+                        {
+                            entry.second.claimed = true;
+                            entry.second.asset->SetLoadState(AssetLoadState::Failed);
+                        }
+                        else
+                        {
+                            loadingAssets.push_back(entry.second.asset);
+                        }
+                    }
+                }
+            }
+            for(T* asset : loadingAssets)
+            {
+                asset->WaitForLoad();
+            }
+
+            // Any assets that finished loading moved to the cache. The rest failed or were cancelled, and can be deleted.
+            std::lock_guard<std::mutex> lock(mutex);
+            if(scope == AssetScope::Global)
+            {
+                for(auto& entry : pending)
+                {
+                    delete entry.second.asset;
+                }
+                pending.clear();
+            }
+            else
+            {
+                for(auto it = pending.begin(); it != pending.end();)
+                {
+                    if((*it).second.asset->GetScope() == scope)
+                    {
+                        delete (*it).second.asset;
+                        it = pending.erase(it);
+                    }
+                    else
+                    {
+                        ++it;
+                    }
+                }
+            }
+        }
     };
     AssetCache<Audio> mAudioCache;
     AssetCache<Soundtrack> mSoundtrackCache;
@@ -194,10 +437,79 @@ private:
 
     AssetCache<TextAsset> mShaderFileCache;
     AssetCache<Shader> mShaderCache;
+
+    // Residency info for each cached asset, used to decide when unused assets can be deleted.
+    struct ResidencyInfo
+    {
+        // Approximate memory used by the asset (size of its source data).
+        uint32_t size = 0;
+
+        // Assets this asset loaded while loading itself (e.g. a cursor's texture).
+        // These must stay in memory for as long as this asset does.
+        std::vector<Asset*> dependencies;
+
+        // Number of resident assets depending on this asset.
+        int refCount = 0;
+
+        // If true, no scene is using this asset, but it's being kept around in case it's needed again.
+        // It can be evicted once no other resident assets depend on it.
+        bool retained = false;
+        std::list<Asset*>::iterator lruIt;
+
+        // Removes the asset from its cache, returning it so it can be deleted.
+        std::function<Asset*()> evict;
+    };
+    std::unordered_map<Asset*, ResidencyInfo> mResidency;
+
+    // Retained assets, with the most recently used at the front.
+    std::list<Asset*> mRetainedAssets;
+
+    // Combined size of all retained assets, and the budget for that size.
+    size_t mRetainedBytes = 0;
+    size_t mResidencyBudget = 256 * 1024 * 1024;
+
+    // Assets are loaded on many threads, so residency info needs protection.
+    // Evicted assets are taken out of their cache while holding this lock, so finding a cached asset under this lock means it won't be evicted out from under us.
+    std::mutex mResidencyMutex;
+
+    // Timing info for assets loaded during the current (or most recent) scene load.
+    AssetLoadReport mLoadReport;
+
+    // Directory containing cooked assets - load-ready binary versions of assets, so later loads can skip parsing.
+    // Empty if cooking is disabled.
+    std::string mCookedAssetsPath;
+
+    // Where each asset's cooked file goes, and whether it exists.
+    // Working this out hits the file system, so it's only done once per asset per session - or again if search paths or Barns change.
+    struct CookedAssetInfo
+    {
+        // Empty if the asset's source data couldn't be found.
+        std::string path;
+        bool exists = false;
+    };
+    std::string_map_ci<CookedAssetInfo> mCookedAssets;
+
+    // Incremented whenever cooked asset info is forgotten, so info worked out from old source locations isn't saved.
+    uint32_t mCookedAssetsGeneration = 0;
+
+    // Cooked files on disk for each asset, found once at startup. Used to delete an asset's older cooked files when it's cooked again.
+    std::string_map_ci<std::vector<std::string>> mCookedFiles;
+    std::mutex mCookedAssetsMutex;
 	
 	// Retrieve a barn bundle by name, or by contained asset.
 	BarnFile* GetBarn(const std::string& barnName);
 	BarnFile* GetBarnContainingAsset(const std::string& assetName);
+
+    // Parses loading Barns until none are left. Whoever parses the last Barn adds them all to the asset directory.
+    void ParseLoadingBarns(const std::shared_ptr<LoadingBarns>& loadingBarns);
+
+    // Adds loose files/Barn assets to the asset directory. Caller must hold the directory mutex.
+    void IndexSearchPath(size_t searchPathIndex);
+    void IndexBarn(BarnFile& barn);
+    void RebuildBarnIndex();
+
+    // Looks up where an asset lives. Returns false if the asset doesn't exist anywhere.
+    bool FindAssetLocation(const std::string& assetName, AssetLocation& outLocation);
     
     std::string SanitizeAssetName(const std::string& assetName, const std::string& expectedExtension);
 
@@ -205,10 +517,54 @@ private:
     // The first uses a single constructor (name, data, size).
     // The second uses a constructor (name) and a separate load function (data, size).
     // The latter is necessary if two assets can potentially attempt to load one another (circular dependency).
-    template<typename T> T* LoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache, bool deleteBuffer = true);
-    template<typename T> T* LoadAssetAsync(const std::string& name, AssetScope scope, AssetCache<T>* cache, bool deleteBuffer = true, std::function<void(T*)> callback = nullptr);
+    template<typename T> T* LoadAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache);
+    template<typename T> T* LoadAssetAsync(const std::string& name, AssetScope scope, AssetCache<T>* cache, std::function<void(T*)> callback = nullptr);
+
+    // Called when a load finds an asset in the cache (or pending). Promotes the asset's scope if needed, and marks it used.
+    // If wait is true, the asset is loaded on this thread if no other thread has started loading it, and waited on otherwise.
+    // Returns null if the asset failed to load.
+    template<typename T> T* UseCachedAsset(const std::string& name, AssetScope scope, AssetCache<T>* cache, T* cachedAsset, bool wait);
+
+    // Loads data for a pending asset. Safe to call from any thread.
+    // Pending assets are only loaded if not already claimed by another thread.
+    template<typename T> void LoadPendingAsset(const std::string& name, AssetCache<T>* cache);
+    template<typename T> AssetLoadState LoadAssetData(T* asset);
+    template<typename T> AssetLoadState LoadAssetData(T* asset, AssetLoadRecord& record);
+
+    // Residency tracking.
+    template<typename T> void AddResident(T* asset, const std::string& name, AssetCache<T>* cache, uint32_t size);
+    void RemoveResident(Asset* asset);
+    void SetResidentSize(Asset* asset, uint32_t size);
+    void OnAssetUsed(Asset* asset);
+    void MarkAssetUsed(Asset* asset); // Caller must hold the residency mutex.
+
+    // Finds an asset in the cache (or pending), and marks it used, so it can't be evicted before the caller gets to use it.
+    // If a new pending asset is provided, it's added to the cache if no asset with this name exists yet.
+    template<typename T> T* GetCachedAsset(const std::string& name, AssetCache<T>* cache, T* newPendingAsset = nullptr);
+    template<typename T> void RetainAssets(AssetCache<T>* cache, AssetScope scope);
+    template<typename T> void DeleteAssets(AssetCache<T>* cache, AssetScope scope);
+    void EvictRetainedAssets();
+
+    // Cooked assets. A cooked file is named for its asset and a hash of where its source data lives (file path, size, offset, modified time).
+    // If the source changes, so does the name, so stale cooked files are never used - and they're deleted once a new one is written.
+    // The path is empty if the asset can't be cooked.
+    CookedAssetInfo GetCookedAsset(const Asset* asset, AssetLoadRecord& record);
+    CookedAssetInfo GetCookedAsset(const std::string& assetName);
+    void ForgetCookedAssets();
+    bool LoadCookedAsset(Asset* asset, const std::string& cookedAssetPath, AssetLoadRecord& record);
+    void WriteCookedAsset(const Asset* asset, const std::string& cookedAssetPath);
+    void FindCookedFiles();
+
+    // Is an asset with this name loaded (or retained) in any cache?
+    bool IsAssetCached(const std::string& assetName);
+
+    // If recording a manifest, notes that an asset was loaded.
+    void RecordManifestAsset(const std::string& assetName);
 
-    uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize);
+    // Creates a buffer containing an asset's data. The buffer is invalid if the asset doesn't exist.
+    // Loose files are mapped from disk, uncompressed Barn assets are borrowed from the mapped Barn - only compressed assets are copied.
+    // If a load record is provided, the time spent and bytes read are added to it.
+    AssetBuffer CreateAssetBuffer(const std::string& assetName, AssetLoadRecord* record = nullptr);
 
     template<class T> void UnloadAsset(T* asset, std::unordered_map_ci<std::string, T*>* cache = nullptr);
 };
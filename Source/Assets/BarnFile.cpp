@@ -1,31 +1,59 @@
 #include "BarnFile.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "minilzo.h"
 #include "zlib.h"
 
+#include "BinaryReader.h"
 #include "FileSystem.h"
 #include "SheepScript.h"
 #include "Texture.h"
+#include "ThreadPool.h"
+
+namespace
+{
+    // A zlib stream, ready for inflating.
+    // Initializing a stream allocates zlib's internal state - much cheaper to init once and reset per asset than to init/end every time.
+    struct ZlibInflater
+    {
+        z_stream stream {};
+        bool initialized = false;
+
+        ZlibInflater() { initialized = (inflateInit(&stream) == Z_OK); }
+        ~ZlibInflater() { if(initialized) { inflateEnd(&stream); } }
+    };
+
+    // Each thread that decompresses assets gets its own stream, so decompression never needs to lock.
+    thread_local ZlibInflater sInflater;
+}
 
 BarnFile::BarnFile(const std::string& filePath) :
     mName(filePath),
-    mReader(filePath.c_str())
+    mFile(filePath)
 {
     // Make sure we can actually read this file.
-    if(!mReader.OK())
+    if(!mFile.OK())
     {
 		std::cout << "Can't read barn file at " << filePath << std::endl;
         return;
     }
+
+    // The asset directory is parsed straight out of the mapped memory.
+    BinaryReader reader(mFile.GetData(), static_cast<uint32_t>(mFile.GetSize()));
     
 	// 8 bytes: two specific 4-byte ints must appear at the beginning of the file.
     // In text form, this is a string "GK3!Barn".
-    uint32_t gameIdentifier = mReader.ReadUInt();
-    uint32_t barnIdentifier = mReader.ReadUInt();
+    uint32_t gameIdentifier = reader.ReadUInt();
+    uint32_t barnIdentifier = reader.ReadUInt();
     if(gameIdentifier != kGameIdentifier && barnIdentifier != kBarnIdentifier)
     {
 		std::cout << "Invalid file type!" << std::endl;
@@ -35,64 +63,64 @@ BarnFile::BarnFile(const std::string& filePath) :
     // 4-bytes: unknown constant value (65536)
 	// 4-bytes: unknown constant value (65536)
 	// 4-bytes: appears to be file size, or size of assets in BRN bundle.
-	mReader.Skip(12);
+	reader.Skip(12);
     
     // This value indicates the offset past the file header data to what I'd
     // call the "table of contents" or "toc".
-    uint32_t tocOffset = mReader.ReadUInt();
+    uint32_t tocOffset = reader.ReadUInt();
 
     // This additional header data can be read in if desired, but it
     // isn't really relevant to the file functionality.
     /*
     {
         // 4-bytes: EXE/Content build # (119 in both cases)
-        mReader.ReadUInt();
-        mReader.ReadUInt();
+        reader.ReadUInt();
+        reader.ReadUInt();
         
         // 4-bytes: unknown value
-        mReader.ReadUInt();
+        reader.ReadUInt();
         
         // Two dates, 2-bytes per element.
         // The dates are both on the same day, just a few minutes apart.
         // Maybe like a build start/end time for the bundles?
         short year, month, day, hour, minute, second;
-        year = mReader.ReadShort();
-        month = mReader.ReadShort();
-        mReader.ReadShort(); // unknown value
-        day = mReader.ReadShort();
-        hour = mReader.ReadShort();
-        minute = mReader.ReadShort();
-        second = mReader.ReadShort();
+        year = reader.ReadShort();
+        month = reader.ReadShort();
+        reader.ReadShort(); // unknown value
+        day = reader.ReadShort();
+        hour = reader.ReadShort();
+        minute = reader.ReadShort();
+        second = reader.ReadShort();
         cout << year << "/" << month << "/" << day << ", " << hour << ":" << minute << ":" << second << endl;
         
         // 2-bytes: unknown variable value.
-        mReader.ReadShort();
+        reader.ReadShort();
         
-        year = mReader.ReadShort();
-        month = mReader.ReadShort();
-        mReader.ReadShort(); // unknown value
-        day = mReader.ReadShort();
-        hour = mReader.ReadShort();
-        minute = mReader.ReadShort();
-        second = mReader.ReadShort();
+        year = reader.ReadShort();
+        month = reader.ReadShort();
+        reader.ReadShort(); // unknown value
+        day = reader.ReadShort();
+        hour = reader.ReadShort();
+        minute = reader.ReadShort();
+        second = reader.ReadShort();
         cout << year << "/" << month << "/" << day << ", " << hour << ":" << minute << ":" << second << endl;
         
         // 2-bytes: unknown variable value.
-        mReader.ReadShort();
+        reader.ReadShort();
         
         // Copyright notice
         char copyright[65];
-        mReader.Read(copyright, 64);
+        reader.Read(copyright, 64);
         copyright[64] = '\0';
         cout << copyright << endl;
     }
     */
     
     // Seek to table of contents offset.
-    mReader.Seek(tocOffset);
+    reader.Seek(tocOffset);
     
     // First value in TOC is number of TOC entries.
-    uint32_t tocEntryCount = mReader.ReadUInt();
+    uint32_t tocEntryCount = reader.ReadUInt();
     
     // Each toc entry will specify a header offset and a data offset.
 	std::vector<uint32_t> headerOffsets;
@@ -107,14 +135,14 @@ BarnFile::BarnFile(const std::string& filePath) :
         // The type is either "DDir" or "Data".
         // DDir specifies a directory of assets.
         // Data specifies file offset to start reading actual data.
-        uint32_t type = mReader.ReadUInt();
+        uint32_t type = reader.ReadUInt();
         
         // Some unknown values.
-        mReader.Skip(16);
+        reader.Skip(16);
         
         // Read header and data offsets.
-        uint32_t headerOffset = mReader.ReadUInt();
-        uint32_t dataOffset = mReader.ReadUInt();
+        uint32_t headerOffset = reader.ReadUInt();
+        uint32_t dataOffset = reader.ReadUInt();
         
         // For DDir, we'll save the offsets so we can iterate over them below.
         // For Data, we'll just save the data offset value.
@@ -134,22 +162,22 @@ BarnFile::BarnFile(const std::string& filePath) :
     mReferencedBarns.resize(tocEntryCount);
     for(size_t i = 0; i < headerOffsets.size(); ++i)
     {
-        mReader.Seek(headerOffsets[i]);
+        reader.Seek(headerOffsets[i]);
         
         // The name of the Barn file for these assets. NOTE that it appears
         // a Barn file can contain "pointers" to assets in other Barn files.
         // If this name is empty, it means the asset is contained within THIS Barn file.
         // However, if the name isn't empty, it means the asset is in another Barn file.
-        mReader.ReadString(32, mReferencedBarns[i]);
+        reader.ReadString(32, mReferencedBarns[i]);
         bool isPointer = !mReferencedBarns[i].empty();
 
         // 4 bytes - unknown value
         // 40 bytes - a human-readable description for this Barn file
         // 4 bytes - unknown value
-        mReader.Skip(48);
+        reader.Skip(48);
 
-        uint32_t numAssets = mReader.ReadUInt();
-		mReader.Seek(dataOffsets[i]);
+        uint32_t numAssets = reader.ReadUInt();
+		reader.Seek(dataOffsets[i]);
         for(uint32_t j = 0; j < numAssets; ++j)
         {
             BarnAsset asset;
@@ -163,16 +191,16 @@ BarnFile::BarnFile(const std::string& filePath) :
             
             // Asset size, in bytes.
             // But we need to read compression type before we know whether this is compressed or uncompressed size.
-            asset.size = mReader.ReadUInt();
+            asset.size = reader.ReadUInt();
             
             // Read in the asset offset. This is the offset from the start of the data section.
-            asset.offset = mReader.ReadUInt();
+            asset.offset = reader.ReadUInt();
             
             // Unknown values.
-            mReader.Skip(5);
+            reader.Skip(5);
             
             // Read in compression type.
-            asset.compressionType = static_cast<CompressionType>(mReader.ReadByte());
+            asset.compressionType = static_cast<CompressionType>(reader.ReadByte());
             
             // Compression type 3 should just be treated as type none.
             // Not sure if type 3 is actually different in some way?
@@ -182,8 +210,8 @@ BarnFile::BarnFile(const std::string& filePath) :
             }
 			
             // Read in asset name.
-            mReader.ReadString8(asset.name);
-            mReader.Skip(1); // null terminator is also present - skip it
+            reader.ReadString8(asset.name);
+            reader.Skip(1); // null terminator is also present - skip it
             //std::cout << asset.name << ", " << (int)asset.compressionType << ", " << asset.compressedSize << ", " << asset.uncompressedSize << std::endl;
 
             // Map asset name to asset for fast lookup later.
@@ -202,134 +230,170 @@ BarnAsset* BarnFile::GetAsset(const std::string& assetName)
     return nullptr;
 }
 
-uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize)
+const uint8_t* BarnFile::GetAssetData(const std::string& assetName, uint32_t& outDataSize)
 {
     // Use a sane default value for this.
-    outBufferSize = 0;
+    outDataSize = 0;
+
+    BarnAsset* asset = GetAsset(assetName);
+    if(asset == nullptr)
+    {
+        return nullptr;
+    }
+    return GetAssetData(*asset, outDataSize);
+}
+
+const uint8_t* BarnFile::GetAssetData(const BarnAsset& asset, uint32_t& outDataSize)
+{
+    // Use a sane default value for this.
+    outDataSize = 0;
+
+    // Only assets that actually live in this Barn, uncompressed, can be accessed directly.
+    if(asset.IsPointer() || asset.compressionType != CompressionType::None)
+    {
+        return nullptr;
+    }
 
+    // Make sure the asset's data is actually within the file (guards against truncated/corrupt Barns).
+    uint64_t dataStart = static_cast<uint64_t>(mDataOffset) + asset.offset;
+    if(dataStart + asset.size > mFile.GetSize())
+    {
+        std::cout << "Asset " << asset.name << " extends past end of Barn file!" << std::endl;
+        return nullptr;
+    }
+
+    // The asset data is simply a region of the mapped file.
+    outDataSize = asset.size;
+    return mFile.GetData() + dataStart;
+}
+
+const uint8_t* BarnFile::GetStoredAssetData(const BarnAsset& asset, uint32_t& outDataSize)
+{
+    // Use a sane default value for this.
+    outDataSize = 0;
+
+    // Pointer assets don't have any data in this Barn.
+    if(asset.IsPointer())
+    {
+        return nullptr;
+    }
+
+    // Compressed data is preceded by an 8-byte header, which is considered part of the stored data.
+    uint32_t storedSize = asset.size + (asset.compressionType != CompressionType::None ? 8 : 0);
+    uint64_t dataStart = static_cast<uint64_t>(mDataOffset) + asset.offset;
+    if(dataStart + storedSize > mFile.GetSize())
+    {
+        std::cout << "Asset " << asset.name << " extends past end of Barn file!" << std::endl;
+        return nullptr;
+    }
+    outDataSize = storedSize;
+    return mFile.GetData() + dataStart;
+}
+
+AssetBuffer BarnFile::CreateAssetBuffer(const std::string& assetName)
+{
     // Get the asset handle associated with this asset name.
     BarnAsset* asset = GetAsset(assetName);
     if(asset == nullptr)
     {
         std::cout << "No asset named " << assetName << "in Barn file!" << std::endl;
-        return nullptr;
+        return AssetBuffer();
     }
+    return CreateAssetBuffer(*asset);
+}
 
+AssetBuffer BarnFile::CreateAssetBuffer(const BarnAsset& asset)
+{
      // Make sure this asset actually exists within this barn file, and it isn't a pointer to another barn file.
-    if(asset->IsPointer())
+    if(asset.IsPointer())
     {
-        std::cout << "Can't create asset buffer for " << asset->name << " - it is an asset pointer!" << std::endl;
-        return nullptr;
+        std::cout << "Can't create asset buffer for " << asset.name << " - it is an asset pointer!" << std::endl;
+        return AssetBuffer();
     }
 
-    // If this is an uncompressed asset, we can simply read the bytes and be done with it - easy.
-    if(asset->compressionType == CompressionType::None)
+    // If this is an uncompressed asset, the buffer can just borrow the bytes from the mapped file - easy.
+    if(asset.compressionType == CompressionType::None)
     {
-        // Allocate buffer to hold asset data.
-        uint8_t* buffer = new uint8_t[asset->size];
-        outBufferSize = asset->size;
-
-        // Seek to the data and read into the buffer. Since it's already uncompressed, we're done!
-        mReaderMutex.lock();
-        mReader.Seek(mDataOffset + asset->offset);
-        mReader.Read(buffer, asset->size);
-        mReaderMutex.unlock();
-        return buffer;
+        uint32_t dataSize = 0;
+        const uint8_t* data = GetAssetData(asset, dataSize);
+        return AssetBuffer::MakeBorrowed(data, dataSize);
     }
 
-    // Otherwise, data is compressed - we need to read in compressed data, and then use an appropriate decompressor.
-    // Create buffer to hold compressed data.
-    uint8_t* compressedBuffer = new uint8_t[asset->size];
-
-    // Read compressed data into a buffer.
-    // Also grab the decompressed asset size while we're there.
-    mReaderMutex.lock();
-    mReader.Seek(mDataOffset + asset->offset);
-    outBufferSize = mReader.ReadUInt();
-    mReader.Skip(4);
-    uint32_t readCount = mReader.Read(compressedBuffer, asset->size);
-    mReaderMutex.unlock();
-
-    // Make sure we read what we were expecting.
-    if(readCount != asset->size)
+    // Otherwise, data is compressed - compressed data is preceded by an 8-byte header.
+    // Make sure the header and compressed data are actually within the file.
+    const uint32_t kCompressedHeaderSize = 8;
+    uint64_t dataStart = static_cast<uint64_t>(mDataOffset) + asset.offset;
+    if(dataStart + kCompressedHeaderSize + asset.size > mFile.GetSize())
     {
         std::cout << "Didn't read desired number of bytes." << std::endl;
-        delete[] compressedBuffer;
-        return nullptr;
+        return AssetBuffer();
     }
+
+    // Grab the decompressed asset size from the header.
+    // The compressed data can then be decompressed directly out of the mapped file - no intermediate copy.
+    const uint8_t* compressedBuffer = mFile.GetData() + dataStart;
+    uint32_t bufferSize = 0;
+    memcpy(&bufferSize, compressedBuffer, sizeof(uint32_t));
+    compressedBuffer += kCompressedHeaderSize;
         
     // Create buffer for uncompressed data.
-    uint8_t* buffer = new uint8_t[outBufferSize];
+    uint8_t* buffer = new uint8_t[bufferSize];
 
     // How we decompress the data depends on the compression type...
-    if(asset->compressionType == CompressionType::Zlib)
+    if(asset.compressionType == CompressionType::Zlib)
     {
-        // Create params object.
-        z_stream strm {};
-        strm.next_in = compressedBuffer;
-        strm.avail_in = asset->size;
-        strm.next_out = buffer;
-        strm.avail_out = outBufferSize;
-        strm.zalloc = Z_NULL;
-        strm.zfree = Z_NULL;
-        strm.opaque = Z_NULL;
+        // Each thread has its own inflate stream, which is reset and reused for every asset.
+        ZlibInflater& inflater = sInflater;
+        if(!inflater.initialized)
+        {
+            std::cout << "Error when calling inflateInit!" << std::endl;
+            delete[] buffer;
+            return AssetBuffer();
+        }
 
-        // Make sure zlib is initialized for "inflation".
-        int result = inflateInit(&strm);
+        // Reset stream state from any previous use.
+        z_stream& strm = inflater.stream;
+        int result = inflateReset(&strm);
         if(result != Z_OK)
         {
-            std::cout << "Error when calling inflateInit: " << result << std::endl;
-            delete[] compressedBuffer;
+            std::cout << "Error when calling inflateReset: " << result << std::endl;
             delete[] buffer;
-            return nullptr;
+            return AssetBuffer();
         }
 
+        // Point the stream at our input/output buffers.
+        strm.next_in = const_cast<Bytef*>(compressedBuffer);
+        strm.avail_in = asset.size;
+        strm.next_out = buffer;
+        strm.avail_out = bufferSize;
+
         // Inflate the data!
         result = inflate(&strm, Z_FINISH);
         if(result != Z_STREAM_END)
         {
             std::cout << "Inflate didn't inflate entire stream, or an error occurred: " << result << std::endl;
-            delete[] compressedBuffer;
-            delete[] buffer;
-            return nullptr;
-        }
-
-        // Uninit zlib.
-        result = inflateEnd(&strm);
-        if(result != Z_OK)
-        {
-            std::cout << "Error while ending inflate: " << result << std::endl;
-            delete[] compressedBuffer;
             delete[] buffer;
-            return nullptr;
+            return AssetBuffer();
         }
     }
-    else if(asset->compressionType == CompressionType::Lzo)
+    else if(asset.compressionType == CompressionType::Lzo)
     {
         // Make sure LZO library is initialized.
-        static bool initLzo = false;
+        // Local static init only happens once, and is thread-safe, even if many threads get here at once.
+        static const bool initLzo = (lzo_init() == LZO_E_OK);
         if(!initLzo)
         {
-            int initResult = lzo_init();
-            if(initResult == LZO_E_OK)
-            {
-                initLzo = true;
-            }
-            else
-            {
-                std::cout << "Failed to init LZO!" << std::endl;
-                delete[] compressedBuffer;
-                delete[] buffer;
-                return nullptr;
-            }
+            std::cout << "Failed to init LZO!" << std::endl;
+            delete[] buffer;
+            return AssetBuffer();
         }
         
         // Decompress using LZO library. GK3 data appears to be compressed with lzo1x.
-        //std::cout << asset->name << ": decompressing " << asset->compressedSize << " bytes to a buffer of size " << bufferSize << std::endl;
-        lzo_bytep compressedPtr = static_cast<lzo_bytep>(compressedBuffer);
+        //std::cout << asset.name << ": decompressing " << asset.compressedSize << " bytes to a buffer of size " << bufferSize << std::endl;
+        lzo_bytep compressedPtr = const_cast<lzo_bytep>(compressedBuffer);
         lzo_bytep bufferPtr = static_cast<lzo_bytep>(buffer);
-        lzo_uint bufferSize = 0;
-        int result = lzo1x_decompress(compressedPtr, asset->size, bufferPtr, &bufferSize, nullptr);
+        lzo_uint decompressedSize = 0;
+        int result = lzo1x_decompress(compressedPtr, asset.size, bufferPtr, &decompressedSize, nullptr);
         
         // For some reason *most* GK3 data decompresses with result of LZO_E_INPUT_NOT_CONSUMED.
         // This still works OK. It may indicate that "compressedSize" passed is larger than the compressed data.
@@ -337,27 +401,84 @@ uint8_t* BarnFile::CreateAssetBuffer(const std::string& assetName, uint32_t& out
         if(result != LZO_E_OK && result != LZO_E_INPUT_NOT_CONSUMED)
         {
             std::cout << "Error during LZO decompress: " << result << std::endl;
-            delete[] compressedBuffer;
             delete[] buffer;
-            return nullptr;
+            return AssetBuffer();
         }
 
         // Set buffer size for caller to use.
-        outBufferSize = static_cast<uint32_t>(bufferSize);
+        bufferSize = static_cast<uint32_t>(decompressedSize);
     }
     else
     {
-        std::cout << "Asset " << asset->name << " has invalid compression type " << (int)asset->compressionType << std::endl;
-        delete[] compressedBuffer;
+        std::cout << "Asset " << asset.name << " has invalid compression type " << (int)asset.compressionType << std::endl;
         delete[] buffer;
-        return nullptr;
+        return AssetBuffer();
+    }
+
+    // Return decompressed buffer. Caller takes ownership of it.
+    return AssetBuffer::MakeOwned(buffer, bufferSize);
+}
+
+void BarnFile::ExtractMany(const std::vector<std::string>& assetNames, const std::function<void(const std::string&, AssetBuffer&)>& callback)
+{
+    if(assetNames.empty()) { return; }
+
+    // State shared between the calling thread and any helper threads.
+    // Helper tasks may still be queued after we return (if the caller finished all the work first), so this lives on the heap.
+    struct ExtractState
+    {
+        std::vector<std::string> assetNames;
+        std::function<void(const std::string&, AssetBuffer&)> callback;
+
+        // Index of next asset to be claimed, and number of assets fully processed.
+        std::atomic<size_t> nextIndex { 0 };
+        std::atomic<size_t> doneCount { 0 };
+
+        // Used to wake the calling thread when the final asset is done.
+        std::mutex mutex;
+        std::condition_variable condVar;
+    };
+    std::shared_ptr<ExtractState> state = std::make_shared<ExtractState>();
+    state->assetNames = assetNames;
+    state->callback = callback;
+
+    // Claims and extracts assets until none are left.
+    // Captures the Barn by pointer, which is fine since no work is claimed after the final asset is done (and we wait for that).
+    auto extractLoop = [this](ExtractState& state) {
+        size_t count = state.assetNames.size();
+        size_t index = 0;
+        while((index = state.nextIndex.fetch_add(1)) < count)
+        {
+            AssetBuffer buffer = CreateAssetBuffer(state.assetNames[index]);
+            state.callback(state.assetNames[index], buffer);
+
+            // If this was the last asset, wake the caller.
+            if(state.doneCount.fetch_add(1) + 1 == count)
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.condVar.notify_all();
+            }
+        }
+    };
+
+    // Queue helpers on the thread pool - no point in having more helpers than threads or assets.
+    // The calling thread does work too, so one less helper is needed.
+    int helperCount = std::min(ThreadPool::GetThreadCount(), static_cast<int>(assetNames.size()) - 1);
+    for(int i = 0; i < helperCount; ++i)
+    {
+        ThreadPool::AddTask([state, extractLoop]() {
+            extractLoop(*state);
+        });
     }
 
-    // Delete compressed data buffer.
-    delete[] compressedBuffer;
+    // Help out on this thread.
+    extractLoop(*state);
 
-    // Return decompressed buffer.
-    return buffer;
+    // Wait for any assets still being processed by helpers.
+    // Note we only wait for the work to complete, not for the helper tasks to run - a helper may still be queued behind other tasks,
+    // but it will find no work left and exit immediately. This avoids deadlock if called from a pool thread.
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->condVar.wait(lock, [&state]() { return state->doneCount.load() == state->assetNames.size(); });
 }
 
 bool BarnFile::WriteToFile(const std::string& assetName)
@@ -405,25 +526,24 @@ bool BarnFile::WriteToFile(const std::string& assetName, const std::string& outp
 	
 	// Extract the asset and write it to file.
 	bool result = false;
-    unsigned int bufferSize = 0;
-    uint8_t* assetData = CreateAssetBuffer(assetName, bufferSize);
-	if(assetData != nullptr)
+    AssetBuffer assetData = CreateAssetBuffer(assetName);
+	if(assetData.IsValid())
 	{
 		// Textures can't be written directly to file and open correctly.
 		// Handle those separately (TODO: More modular/extendable way to do this?)
 		if(assetName.find(".BMP") != std::string::npos)
 		{
             Texture tex(assetName, AssetScope::Manual);
-            tex.Load(assetData, bufferSize);
+            tex.Load(assetData);
 			tex.WriteToFile(outputPath);
 			result = true;
 		}
         else if(assetName.find(".SHP") != std::string::npos &&
-                SheepScript::IsSheepDataCompiled(assetData, bufferSize))
+                SheepScript::IsSheepDataCompiled(assetData.GetData(), assetData.GetSize()))
         {
             // If sheep asset is compiled, we need to decompile it to get any useful data.
             SheepScript script(assetName, AssetScope::Manual);
-            script.Load(assetData, bufferSize);
+            script.Load(assetData);
             script.Decompile(outputPath);
             result = true;
         }
@@ -433,7 +553,7 @@ bool BarnFile::WriteToFile(const std::string& assetName, const std::string& outp
 			std::ofstream fileStream(outputPath, std::istream::out | std::istream::binary);
 			if(fileStream.good())
 			{
-				fileStream.write(reinterpret_cast<char*>(assetData), bufferSize);
+				fileStream.write(reinterpret_cast<const char*>(assetData.GetData()), assetData.GetSize());
 				fileStream.close();
 				result = true;
 			}
@@ -450,9 +570,6 @@ bool BarnFile::WriteToFile(const std::string& assetName, const std::string& outp
 		std::cout << "Error while extracting " << asset->name << std::endl;
 	}
 	
-	// Delete our new'd asset data array, no longer needed.
-	delete[] assetData;
-	
 	// Return success or failure.
 	return result;
 }
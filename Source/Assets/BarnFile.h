@@ -8,11 +8,13 @@
 //
 #pragma once
 #include <cstdint>
-#include <mutex>
+#include <functional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
-#include "BinaryReader.h"
+#include "AssetBuffer.h"
+#include "MappedFile.h"
 #include "StringUtil.h"
 
 enum class CompressionType
@@ -53,8 +55,25 @@ public:
 	// Retrieves an asset handle, if it exists in this bundle.
     BarnAsset* GetAsset(const std::string& assetName);
 
-    // Creates a buffer containing the desired asset. Caller owns the returned buffer.
-    uint8_t* CreateAssetBuffer(const std::string& assetName, uint32_t& outBufferSize);
+    // Retrieves a pointer to an asset's data, directly within the mapped Barn file.
+    // Only valid for uncompressed assets (returns null otherwise). The data lives as long as this BarnFile.
+    const uint8_t* GetAssetData(const std::string& assetName, uint32_t& outDataSize);
+    const uint8_t* GetAssetData(const BarnAsset& asset, uint32_t& outDataSize);
+
+    // Retrieves a pointer to an asset's data exactly as stored in the Barn - for compressed assets, this is the compressed data.
+    // Handy for identifying an asset's contents (e.g. hashing) without having to decompress it.
+    const uint8_t* GetStoredAssetData(const BarnAsset& asset, uint32_t& outDataSize);
+
+    // Creates a buffer containing the desired asset.
+    // Uncompressed assets borrow their data from the mapped file; compressed assets are decompressed into an owned buffer.
+    AssetBuffer CreateAssetBuffer(const std::string& assetName);
+    AssetBuffer CreateAssetBuffer(const BarnAsset& asset);
+
+    // Creates buffers for many assets at once, spreading decompression across the thread pool.
+    // The calling thread helps out, and this doesn't return until every asset has been passed to the callback.
+    // The callback is called on whichever thread extracted the asset (possibly several at once), so it must be thread-safe.
+    // Invalid buffers are passed for assets that don't exist or fail to decompress.
+    void ExtractMany(const std::vector<std::string>& assetNames, const std::function<void(const std::string&, AssetBuffer&)>& callback);
 
 	// For debugging, write assets to file.
     bool WriteToFile(const std::string& assetName);
@@ -68,6 +87,9 @@ public:
 	void OutputAssetList() const;
     
 	const std::string& GetName() const { return mName; }
+
+    // All assets in this Barn (including pointers to assets in other Barns), keyed by name.
+    const std::string_map_ci<BarnAsset>& GetAssets() const { return mAssetMap; }
 	
 private:
 	// Identifiers required to verify file type.
@@ -84,10 +106,9 @@ private:
     // Offset within the file to where the data is located.
     uint32_t mDataOffset = 0;
     
-    // Binary reader for extracting data.
-    // Extraction may occur on multiple threads at once, so a mutex is required to guard access.
-    BinaryReader mReader;
-    std::mutex mReaderMutex;
+    // The entire Barn file, mapped into memory.
+    // Extraction may occur on multiple threads at once - since the mapping is read-only, no locking is required.
+    MappedFile mFile;
 
     // If *this* Barn contains pointers to *other* Barns, this contains the names of those other Barns.
     // Individual assets that are pointers will point to these elements.
@@ -1,14 +1,11 @@
 #include "TextAsset.h"
 
-#include <cstring>
+#include <utility>
 
-TextAsset::~TextAsset()
+void TextAsset::Load(AssetBuffer& data)
 {
-    delete[] mText;
-}
-
-void TextAsset::Load(uint8_t* data, uint32_t dataLength)
-{
-    mText = data;
-    mTextLength = dataLength;
+    // Users of text assets (shader compilation, for example) expect null-terminated text.
+    // Data borrowed from a Barn or a mapped file isn't, so make a terminated copy if needed.
+    data.MakeOwnedCopy(true);
+    mText = std::move(data);
 }
@@ -11,15 +11,13 @@ class TextAsset : public Asset
 {
 public:
     TextAsset(const std::string& name, AssetScope scope) : Asset(name, scope) { }
-    ~TextAsset();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(AssetBuffer& data);
     
-    uint8_t* GetText() { return mText; }
-    uint32_t GetTextLength() { return mTextLength; }
+    const uint8_t* GetText() const { return mText.GetData(); }
+    uint32_t GetTextLength() const { return mText.GetSize(); }
     
 private:
-    // The text and text length. Owned by this object, deleted on destruct.
-    uint8_t* mText = nullptr;
-    uint32_t mTextLength = 0;
+    // The text data. Taken from the asset buffer, and always null-terminated.
+    AssetBuffer mText;
 };
@@ -2,28 +2,26 @@
 
 #include <iostream>
 #include <fstream>
+#include <utility>
 
 #include "AudioManager.h"
 #include "BinaryReader.h"
 
 Audio::~Audio()
 {
-	delete[] mDataBuffer;
-
     // FMOD allocates memory internally when playing an Audio file. Let it know it can get free of that memory.
     gAudioManager.ReleaseAudioData(this);
 }
 
-void Audio::Load(uint8_t* data, uint32_t dataLength)
+void Audio::Load(AssetBuffer& data)
 {
-    // Note that AssetManager typically deletes the data buffer after the asset is created.
-    // But for Audio, it knows to not do this - so it's OK for us to save the data pointer.
-    mDataBuffer = data;
-    mDataBufferLength = dataLength;
+    // Most assets are done with their data after loading, but Audio keeps it around for the audio system to use.
+    // Borrowed data (uncompressed WAVs in a Barn) stays valid as long as the Barn is loaded, so no copy is needed.
+    mDataBuffer = std::move(data);
 
     // The audio manager can read this data as-is (it's just WAV data).
     // But parsing it can be helpful to retrieve some info, like duration, for later use.
-    BinaryReader reader(data, dataLength);
+    BinaryReader reader(mDataBuffer.GetData(), mDataBuffer.GetSize());
     
     // First 4 bytes: chunk ID "RIFF".
     std::string identifier = reader.ReadString(4);
@@ -14,10 +14,10 @@ public:
     Audio(const std::string& name, AssetScope scope) : Asset(name, scope) { }
 	~Audio();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(AssetBuffer& data);
     
-    uint8_t* GetDataBuffer() const { return mDataBuffer; }
-    uint32_t GetDataBufferLength() const { return mDataBufferLength; }
+    const uint8_t* GetDataBuffer() const { return mDataBuffer.GetData(); }
+    uint32_t GetDataBufferLength() const { return mDataBuffer.GetSize(); }
     
     float GetDuration() const { return mDuration; }
     
@@ -26,8 +26,7 @@ private:
 	//const unsigned short kMp3Format = 0x0055;
 	
     // Audio data buffer - the contents of WAV file in memory.
-    uint8_t* mDataBuffer = nullptr;
-    uint32_t mDataBufferLength = 0;
+    AssetBuffer mDataBuffer;
     
     // The length of the audio file, calculated from taking (data size / samples per second).
     float mDuration = 0.0f;
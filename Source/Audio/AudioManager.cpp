@@ -7,6 +7,7 @@
 #include "Audio.h"
 #include "GEngine.h"
 #include "GMath.h"
+#include "MemoryTracker.h"
 #include "Profiler.h"
 #include "SaveManager.h"
 
@@ -324,6 +325,8 @@ void AudioManager::Shutdown()
 
 void AudioManager::Update(float deltaTime)
 {
+    MemoryTagScope memoryTag(MemoryTag::Audio);
+
     // Update FMOD system every frame.
     if(mSystem != nullptr)
     {
@@ -762,6 +765,12 @@ void AudioManager::RestoreAudioState(AudioSaveState& audioSaveState)
 
 FMOD::Sound* AudioManager::CreateSound(Audio* audio, AudioType audioType, bool is3D, bool isLooping)
 {
+    // Audio may be loaded asynchronously - wait for the data to be available. If it failed to load, we can't play it.
+    if(!audio->WaitForLoad())
+    {
+        return nullptr;
+    }
+
     // If we've already got an FMOD sound instance for this Audio, use that.
     // NOTE: we're assuming previous audio data was loaded with same "is3D" and "isLooping" flags.
     // NOTE: if that's not the case in the future, may need to revise this.
@@ -788,26 +797,28 @@ FMOD::Sound* AudioManager::CreateSound(Audio* audio, AudioType audioType, bool i
     // For music and ambient audio, stream it to avoid FPS drops when loading.
     // To stream the audio, we need to make sure the streaming buffer is never deleted while we're using it.
     // To achieve this, I'll just make a copy of the audio data.
-    uint8_t* audioBuffer = audio->GetDataBuffer();
+    const uint8_t* audioBuffer = audio->GetDataBuffer();
+    uint8_t* streamBuffer = nullptr;
     if(audioType == AudioType::Ambient || audioType == AudioType::Music)
     {
         mode |= FMOD_CREATESTREAM;
-        audioBuffer = new uint8_t[audio->GetDataBufferLength()];
-        memcpy(audioBuffer, audio->GetDataBuffer(), exinfo.length);
+        streamBuffer = new uint8_t[audio->GetDataBufferLength()];
+        memcpy(streamBuffer, audio->GetDataBuffer(), exinfo.length);
+        audioBuffer = streamBuffer;
     }
 
     // Create the sound using the audio data buffer.
     FMOD::Sound* sound = nullptr;
-    FMOD_RESULT result = mSystem->createSound(reinterpret_cast<char*>(audioBuffer), mode, &exinfo, &sound);
+    FMOD_RESULT result = mSystem->createSound(reinterpret_cast<const char*>(audioBuffer), mode, &exinfo, &sound);
     if(result != FMOD_OK)
     {
         std::cout << FMOD_ErrorString(result) << std::endl;
     }
 
     // If we made a copy of the audio data (for streaming audio), save it as userdata so we can delete it later.
-    if(audioBuffer != audio->GetDataBuffer())
+    if(streamBuffer != nullptr)
     {
-        sound->setUserData(audioBuffer);
+        sound->setUserData(streamBuffer);
     }
 
     // Cache sound for reuse if this Audio is played again.
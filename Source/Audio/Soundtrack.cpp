@@ -101,9 +101,9 @@ Soundtrack::~Soundtrack()
     }
 }
 
-void Soundtrack::Load(uint8_t* data, uint32_t dataLength)
+void Soundtrack::Load(const AssetBuffer& data)
 {
-    IniParser parser(data, dataLength);
+    IniParser parser(data.GetData(), data.GetSize());
     IniSection section;
     std::vector<SoundNode*> prsSoundNodes;
     while(parser.ReadNextSection(section))
@@ -0,0 +1,113 @@
+//
+// Clark Kromenaker
+//
+// A queue (first in, first out) that many threads can push to at once, while a single thread pops.
+// ("Multiple producer, single consumer")
+//
+// Characteristics:
+// - Fixed size: max container size must be known at compile time (and must be a power of two).
+// - Lock-free: pushing and popping never block. If the queue is full, the push fails, and the caller decides what to do.
+// - Contiguous: elements live in a circular array, each with a sequence number saying whether it's ready to push or pop.
+//
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+template<typename T, uint32_t TCapacity>
+class MPSCQueue
+{
+    static_assert(TCapacity > 0 && (TCapacity & (TCapacity - 1)) == 0, "MPSCQueue capacity must be a power of two");
+
+public:
+    MPSCQueue()
+    {
+        // Each slot starts out ready for the push at its position.
+        for(uint32_t i = 0; i < TCapacity; ++i)
+        {
+            mSlots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // No copying or moving - other threads may be using the queue.
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // Pushes an element to the back of the queue. Safe to call from any thread.
+    // Returns false if the queue is full, in which case the element is left untouched.
+    bool TryPush(T&& t)
+    {
+        size_t position = mTail.load(std::memory_order_relaxed);
+        while(true)
+        {
+            Slot& slot = mSlots[position & (TCapacity - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if(diff == 0)
+            {
+                // The slot is free - try to claim it. If another thread beat us to it, the position is updated, so just try again.
+                if(mTail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(t);
+
+                    // Publish the element to the consumer.
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff < 0)
+            {
+                // The slot still holds an element from a lap ago that hasn't been popped - queue is full.
+                return false;
+            }
+            else
+            {
+                // Another thread pushed here already - catch up.
+                position = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Pops the element at the front of the queue. Must only be called from one thread (the consumer).
+    // Returns false if the queue is empty (or the next element is still being pushed).
+    bool TryPop(T& t)
+    {
+        Slot& slot = mSlots[mHead & (TCapacity - 1)];
+        if(slot.sequence.load(std::memory_order_acquire) != mHead + 1) { return false; }
+
+        t = std::move(slot.value);
+        slot.value = T();
+
+        // Mark the slot as free for the push one lap from now.
+        slot.sequence.store(mHead + TCapacity, std::memory_order_release);
+        ++mHead;
+        return true;
+    }
+
+    // Approximate number of elements in the queue (pushes may be in progress). Should only be called by the consumer.
+    uint32_t Size() const
+    {
+        return static_cast<uint32_t>(mTail.load(std::memory_order_relaxed) - mHead);
+    }
+
+    uint32_t Capacity() const
+    {
+        return TCapacity;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    Slot mSlots[TCapacity];
+
+    // Position of the next push. Producers race to claim positions, so it's atomic.
+    // Kept on its own cache line, apart from the consumer's position, so producers and consumer don't slow each other down.
+    alignas(64) std::atomic<size_t> mTail { 0 };
+
+    // Position of the next pop. Only touched by the consumer.
+    alignas(64) size_t mHead = 0;
+};
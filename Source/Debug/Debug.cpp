@@ -16,7 +16,7 @@
 extern Mesh* line;
 extern Mesh* axes;
 
-std::list<DrawCommand> Debug::sDrawCommands;
+std::vector<DrawCommand> Debug::sDrawCommands;
 Shader* Debug::sDrawShader = nullptr;
 
 FlagSet Debug::sDebugFlags;
@@ -64,10 +64,11 @@ void Debug::Render()
     Material material(sDrawShader);
 
     // Iterate over all draw commands and render them.
-    auto it = sDrawCommands.begin();
-    while(it != sDrawCommands.end())
+    // Commands that are still alive are shifted down over any expired ones, so the vector stays compact.
+    size_t keepCount = 0;
+    for(size_t i = 0; i < sDrawCommands.size(); ++i)
     {
-        DrawCommand& command = *it;
+        DrawCommand& command = sDrawCommands[i];
 
         // Set color and world transform.
         material.SetColor(command.color);
@@ -79,16 +80,17 @@ void Debug::Render()
             command.mesh->Render();
         }
 
-        // Erase from list if time is up.
-        if(command.timer <= 0.0f)
+        // Keep the command unless time is up.
+        if(command.timer > 0.0f)
         {
-            it = sDrawCommands.erase(it);
-        }
-        else
-        {
-            it++;
+            if(keepCount != i)
+            {
+                sDrawCommands[keepCount] = command;
+            }
+            ++keepCount;
         }
     }
+    sDrawCommands.resize(keepCount);
 }
 
 void Debug::DrawLine(const Vector3& from, const Vector3& to, const Color32& color, float duration)
@@ -4,7 +4,7 @@
 // Provides some functions for debugging and visualizing constructs in 3D space.
 //
 #pragma once
-#include <list>
+#include <vector>
 
 #include "Color32.h"
 #include "FlagSet.h"
@@ -71,7 +71,8 @@ public:
 	
 private:
     // Draw commands & shader.
-	static std::list<DrawCommand> sDrawCommands;
+    // Commands are stored contiguously - most are added and removed every frame, so this avoids a heap allocation per command.
+	static std::vector<DrawCommand> sDrawCommands;
     static Shader* sDrawShader;
 
     // Debug flags.
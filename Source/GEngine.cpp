@@ -14,12 +14,14 @@
 #include "Debug.h"
 #include "FileSystem.h"
 #include "FootstepManager.h"
+#include "FrameAllocator.h"
 #include "GameProgress.h"
 #include "GK3UI.h"
 #include "InventoryManager.h"
 #include "Loader.h"
 #include "Localizer.h"
 #include "LocationManager.h"
+#include "MemoryTracker.h"
 #include "Paths.h"
 #include "Profiler.h"
 #include "ReportManager.h"
@@ -48,7 +50,12 @@ bool GEngine::Initialize()
 
     // Init threads.
     ThreadUtil::Init();
-    ThreadPool::Init(4);
+    Profiler::SetThreadName("Main");
+    ThreadPool::Init(4, 3);
+    Loader::Init(2);
+
+    // Init memory for temporary per-frame allocations.
+    FrameAllocator::Init(16 * 1024 * 1024);
 	
 	// Tell console to log itself to the "Console" report stream.
 	gConsole.SetReportStream(&gReportManager.GetReportStream("Console"));
@@ -60,6 +67,7 @@ bool GEngine::Initialize()
     mDemoMode = gAssetManager.LoadBarn("Gk3demo.brn");
 
     // For simplicity right now, let's just load all barns at once.
+    // Barn asset directories are parsed in the background, while the renderer and audio initialize.
     if(!mDemoMode)
     {
         std::vector<std::string> barns = {
@@ -74,8 +82,8 @@ bool GEngine::Initialize()
         };
         for(auto& barn : barns)
         {
-            TIMER_SCOPED_VAR(barn.c_str(), barnTimer);
-            if(!gAssetManager.LoadBarn(barn))
+            // Make sure all barns are present up front, since they're loaded asynchronously.
+            if(gAssetManager.GetAssetPath(barn).empty())
             {
                 // Generate expected path for this asset.
                 std::string path = Paths::GetDataPath(Path::Combine({ "Data", barn }));
@@ -89,6 +97,7 @@ bool GEngine::Initialize()
                 return false;
             }
         }
+        gAssetManager.LoadBarnsAsync(barns);
     }
 
     // Init tools.
@@ -112,7 +121,8 @@ bool GEngine::Initialize()
     gInputManager.Init();
     
     // Load cursors and use the default one to start.
-    // Must happen after barn assets are loaded.
+    // Must happen after barn assets are loaded. Asset loads wait for barns anyway, but be explicit about it.
+    gAssetManager.WaitForBarns();
     gCursorManager.Init();
     gCursorManager.UseLoadCursor();
     
@@ -212,6 +222,9 @@ void GEngine::Shutdown()
 
     // Shutdown SDL.
     SDL_Quit();
+
+    // Free per-frame memory.
+    FrameAllocator::Shutdown();
 }
 
 void GEngine::Run()
@@ -475,6 +488,10 @@ void GEngine::Update()
 {
     PROFILER_SCOPED(Update);
 
+    // A new frame - free last frame's temporary allocations, and start counting this frame's heap allocations.
+    FrameAllocator::Reset();
+    MemoryTracker::EndFrame();
+
     // Calculate delta time.
     static DeltaTimer deltaTimer;
     float deltaTime = deltaTimer.GetDeltaTime();
@@ -515,10 +532,11 @@ void GEngine::Update()
 	Debug::Update(deltaTime);
 
     // Update tools.
-    Tools::Update();
+    Tools::Update(deltaTime);
 
     // Run any waiting functions on the main thread.
-    ThreadUtil::RunFunctionsOnMainThread();
+    // These are given a small slice of the frame - if there are too many, the rest run on later frames.
+    ThreadUtil::RunFunctionsOnMainThread(2.0f);
 }
 
 void GEngine::Update(float deltaTime)
@@ -3,9 +3,9 @@
 #include "IniParser.h"
 #include "SheepManager.h"
 
-void NVC::Load(uint8_t* data, uint32_t dataLength)
+void NVC::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 }
 
 const std::vector<Action>& NVC::GetActions(const std::string& noun) const
@@ -67,7 +67,7 @@ const Action* NVC::GetAction(const std::string& noun, const std::string& verb) c
 	return nullptr;
 }
 
-void NVC::ParseFromData(uint8_t* data, uint32_t dataLength)
+void NVC::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     IniParser parser(data, dataLength);
     parser.ParseAll();
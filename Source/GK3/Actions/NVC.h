@@ -74,7 +74,7 @@ class NVC : public Asset
 public:
     NVC(const std::string& name, AssetScope scope) : Asset(name, scope) { }
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
 	
 	const std::vector<Action*>& GetActions() const { return mActions; }
 	const std::vector<Action>& GetActions(const std::string& noun) const;
@@ -95,5 +95,5 @@ private:
     // Mapping of case name to sheep script to eval.
     std::string_map_ci<SheepScriptAndText> mCaseLogic;
 	
-	void ParseFromData(uint8_t* data, uint32_t dataLength);
+	void ParseFromData(const uint8_t* data, uint32_t dataLength);
 };
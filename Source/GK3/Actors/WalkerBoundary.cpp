@@ -5,9 +5,9 @@
 #include <unordered_set>
 
 #include "Debug.h"
+#include "FrameAllocator.h"
 #include "GMath.h"
 #include "Texture.h"
-#include "ResizableQueue.h"
 
 bool WalkerBoundary::FindPath(const Vector3& fromWorldPos, const Vector3& toWorldPos, std::vector<Vector3>& outPath) const
 {
@@ -334,12 +334,12 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
 
     // Create set of nodes for searching.
     // Since a lot of texture pixels are unwalkable (in most cases), this does waste a bit of memory.
-    // But it works fine (for the moment). Perhaps it can be optimized by allocating the memory one time rather than each time this function is called.
+    // This is only needed during the search, so it comes from frame memory, rather than a big heap allocation per search.
     int width = mTexture->GetWidth();
     int height = mTexture->GetHeight();
     int nodeCount = width * height;
 
-    Node* nodes = new Node[nodeCount];
+    FrameVector<Node> nodes(nodeCount);
     for(int y = 0; y < height; ++y)
     {
         for(int x = 0; x < width; ++x)
@@ -349,20 +349,22 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
     }
 
     // The open set when doing the search.
-    // This does some dynamic allocation that could maybe be optimized if needed.
-    ResizableQueue<Node*> openSet(nodeCount);
+    // Each node is added at most once (when first explored), so a plain array works as the queue - just track where the front is.
+    FrameVector<Node*> openSet;
+    openSet.reserve(nodeCount);
+    size_t openSetFront = 0;
 
     // Put start node on the open set, mark as closed/explored.
     Node* startNode = &nodes[static_cast<int>(start.y * width + start.x)];
     startNode->closed = true;
-    openSet.Push(startNode);
+    openSet.push_back(startNode);
 
     // Iterate until we either find the goal, or the open set is empty.
-    while(!openSet.Empty())
+    while(openSetFront < openSet.size())
     {
         // If we find the goal, we purposely don't pop the node off the open set.
         // This is used after the while-loop to check success/failure of the search.
-        Node* current = openSet.Front();
+        Node* current = openSet[openSetFront];
         if(current->value == goal) { break; }
 
         // Create neighbors array - including diagonals!
@@ -399,23 +401,22 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
             // Add to open set.
             neighborNode->parent = current;
             neighborNode->closed = true;
-            openSet.Push(neighborNode);
+            openSet.push_back(neighborNode);
         }
 
         // Done with this node - remove from open set.
-        openSet.Pop();
+        ++openSetFront;
     }
 
     // If open set is empty, we did not find the goal. No path can be generated.
-    if(openSet.Empty())
+    if(openSetFront >= openSet.size())
     {
-        delete[] nodes;
         return false;
     }
 
     // Iterate back to start, pushing world position of each node onto our path.
     // This leaves the path with start node at back, goal node at front - caller can traverse back-to-front.
-    Node* current = openSet.Front();
+    Node* current = openSet[openSetFront];
     while(current != nullptr)
     {
         outPath.push_back(current->value);
@@ -423,6 +424,5 @@ bool WalkerBoundary::FindPathBFS(const Vector2& start, const Vector2& goal, std:
     }
 
     // We found a path! Noice.
-    delete[] nodes;
     return true;
 }
\ No newline at end of file
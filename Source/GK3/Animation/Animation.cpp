@@ -21,9 +21,9 @@ Animation::~Animation()
     }
 }
 
-void Animation::Load(uint8_t* data, uint32_t dataLength)
+void Animation::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 }
 
 std::vector<AnimNode*>* Animation::GetFrame(int frameNumber)
@@ -49,7 +49,7 @@ VertexAnimNode* Animation::GetVertexAnimationOnFrameForModel(int frameNumber, co
 	return nullptr;
 }
 
-void Animation::ParseFromData(uint8_t* data, uint32_t dataLength)
+void Animation::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     bool isYak = Path::HasExtension(GetName(), ".yak");
 
@@ -22,7 +22,7 @@ public:
     Animation(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~Animation();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
 
 	// Gets all anim nodes associated with a particular frame number. Null may be returned!
 	// Mainly used by Animator to get frame data as needed and play/sample.
@@ -60,5 +60,5 @@ private:
 	// Kept separately because we sometimes need to iterate only over these.
 	std::vector<VertexAnimNode*> mVertexAnimNodes;
     
-    void ParseFromData(uint8_t* data, uint32_t dataLength);
+    void ParseFromData(const uint8_t* data, uint32_t dataLength);
 };
@@ -23,9 +23,9 @@ GAS::~GAS()
     }
 }
 
-void GAS::Load(uint8_t* data, uint32_t dataLength)
+void GAS::Load(const AssetBuffer& data)
 {
-    imstream stream(reinterpret_cast<char*>(data), dataLength);
+    imstream stream(reinterpret_cast<const char*>(data.GetData()), data.GetSize());
     
     // Store any created "ONEOF" node, since they are generated over several lines.
     OneOfGasNode* oneOfNode = nullptr;
@@ -6,9 +6,9 @@
 #include "IniParser.h"
 #include "StringUtil.h"
 
-void Sequence::Load(uint8_t* data, uint32_t dataLength)
+void Sequence::Load(const AssetBuffer& data)
 {
-    IniParser parser(data, dataLength);
+    IniParser parser(data.GetData(), data.GetSize());
     parser.SetMultipleKeyValuePairsPerLine(false);
     while(parser.ReadLine())
     {
@@ -25,7 +25,7 @@ class Sequence : public Asset
 {
 public:
     Sequence(const std::string& name, AssetScope scope) : Asset(name, scope) { }
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
 
     int GetFramesPerSecond() const { return mFramesPerSecond; }
 
@@ -109,9 +109,9 @@ VertexAnimation::~VertexAnimation()
     }
 }
 
-void VertexAnimation::Load(uint8_t* data, uint32_t dataLength)
+void VertexAnimation::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 }
 
 VertexAnimationTransformPose VertexAnimation::SampleTransformPose(int frame, int meshIndex)
@@ -343,7 +343,7 @@ Vector3 VertexAnimation::SampleVertexPosition(float time, int framesPerSecond, i
     return Vector3::Zero;
 }
 
-void VertexAnimation::ParseFromData(uint8_t* data, uint32_t dataLength)
+void VertexAnimation::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     #ifdef DEBUG_OUTPUT
     std::cout << "Vertex Animation " << mName << std::endl;
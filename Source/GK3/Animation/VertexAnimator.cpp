@@ -9,6 +9,22 @@
 
 TYPE_DEF_CHILD(Component, VertexAnimator);
 
+namespace
+{
+    // Bounds of a vertex pose, so the mesh isn't frustum culled while a posed submesh is still partly in view.
+    AABB CalculatePoseAABB(const std::vector<Vector3>& positions)
+    {
+        if(positions.empty()) { return AABB(); }
+
+        AABB aabb(positions[0], positions[0]);
+        for(const Vector3& position : positions)
+        {
+            aabb.GrowToContain(position);
+        }
+        return aabb;
+    }
+}
+
 VertexAnimator::VertexAnimator(Actor* owner) : Component(owner)
 {
 	mMeshRenderer = owner->GetComponent<MeshRenderer>();
@@ -56,6 +72,17 @@ void VertexAnimator::Sample(VertexAnimation* animation, int frame)
 	}
 }
 
+void VertexAnimator::PrepareUpdate(float deltaTime)
+{
+    // Do the same math as OnUpdate, so the prepared sample matches exactly.
+    if(mCurrentParams.vertexAnimation != nullptr)
+    {
+        float animationTimer = mAnimationTimer + deltaTime * GetOwner()->GetTimeScale();
+        float animDuration = mCurrentParams.vertexAnimation->GetDuration(mCurrentParams.framesPerSecond);
+        CalculateSample(mCurrentParams.vertexAnimation, Math::Clamp(animationTimer, 0.0f, animDuration), mPreparedSample);
+    }
+}
+
 void VertexAnimator::OnEnable()
 {
     // When we are enabled, perform a BIG update to correspond with the disabled period.
@@ -101,7 +128,7 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, int frame)
 {
     // Iterate through each mesh and sample it in the vertex animation.
     // We need to sample both vertex poses and transform poses to get the right result.
-    const std::vector<Mesh*> meshes = mMeshRenderer->GetMeshes();
+    const std::vector<Mesh*>& meshes = mMeshRenderer->GetMeshes();
     for(size_t i = 0; i < meshes.size(); i++)
     {
         const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
@@ -111,6 +138,7 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, int frame)
             if(sample.frameNumber >= 0)
             {
                 submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.vertexPositions.data()));
+                meshes[i]->SetSubmeshPoseAABB(j, CalculatePoseAABB(sample.vertexPositions));
             }
         }
         
@@ -124,25 +152,71 @@ void VertexAnimator::TakeSample(VertexAnimation* animation, int frame)
 
 void VertexAnimator::TakeSample(VertexAnimation* animation, float time)
 {
+    // If this exact sample was prepared ahead of time, use it.
+    // A sample only depends on these inputs, so a match is guaranteed to be the same result.
+    if(mPreparedSample.animation == animation && mPreparedSample.time == time &&
+       mPreparedSample.framesPerSecond == mCurrentParams.framesPerSecond && mPreparedSample.meshesVersion == mMeshRenderer->GetMeshesVersion())
+    {
+        ApplySample(mPreparedSample);
+        mPreparedSample.animation = nullptr;
+        return;
+    }
+
+    // Otherwise, sample it now.
+    AnimationSample sample;
+    CalculateSample(animation, time, sample);
+    ApplySample(sample);
+}
+
+void VertexAnimator::CalculateSample(VertexAnimation* animation, float time, AnimationSample& sample) const
+{
+    sample.animation = animation;
+    sample.time = time;
+    sample.framesPerSecond = mCurrentParams.framesPerSecond;
+    sample.meshesVersion = mMeshRenderer->GetMeshesVersion();
+    sample.vertexPoses.clear();
+    sample.vertexPoseAABBs.clear();
+    sample.transformPoses.clear();
+
 	// Iterate through each mesh and sample it in the vertex animation.
 	// We need to sample both vertex poses and transform poses to get the right result.
-	const std::vector<Mesh*> meshes = mMeshRenderer->GetMeshes();
+    const std::vector<Mesh*>& meshes = mMeshRenderer->GetMeshes();
 	for(size_t i = 0; i < meshes.size(); i++)
 	{
 		const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
 		for(size_t j = 0; j < submeshes.size(); j++)
 		{
-			VertexAnimationVertexPose sample = animation->SampleVertexPose(time, mCurrentParams.framesPerSecond, i, j);
-			if(sample.frameNumber >= 0)
-			{
-                submeshes[j]->SetPositions(reinterpret_cast<float*>(sample.vertexPositions.data()));
-			}
-		}
-		
-		VertexAnimationTransformPose transformSample = animation->SampleTransformPose(time, mCurrentParams.framesPerSecond, i);
-		if(transformSample.frameNumber >= 0)
-		{
-            meshes[i]->SetMeshToLocalMatrix(transformSample.meshToLocalMatrix);
+            sample.vertexPoses.push_back(animation->SampleVertexPose(time, mCurrentParams.framesPerSecond, i, j));
+            sample.vertexPoseAABBs.push_back(CalculatePoseAABB(sample.vertexPoses.back().vertexPositions));
 		}
+        sample.transformPoses.push_back(animation->SampleTransformPose(time, mCurrentParams.framesPerSecond, i));
 	}
 }
+
+void VertexAnimator::ApplySample(AnimationSample& sample)
+{
+    // Poses are stored in the same order they were sampled: all submeshes of a mesh, mesh by mesh.
+    // Applying them updates the meshes' vertex buffers, so this must happen on the main thread.
+    const std::vector<Mesh*>& meshes = mMeshRenderer->GetMeshes();
+    size_t vertexPoseIndex = 0;
+    for(size_t i = 0; i < meshes.size(); i++)
+    {
+        const std::vector<Submesh*>& submeshes = meshes[i]->GetSubmeshes();
+        for(size_t j = 0; j < submeshes.size(); j++)
+        {
+            VertexAnimationVertexPose& vertexPose = sample.vertexPoses[vertexPoseIndex];
+            if(vertexPose.frameNumber >= 0)
+            {
+                submeshes[j]->SetPositions(reinterpret_cast<float*>(vertexPose.vertexPositions.data()));
+                meshes[i]->SetSubmeshPoseAABB(j, sample.vertexPoseAABBs[vertexPoseIndex]);
+            }
+            ++vertexPoseIndex;
+        }
+
+        VertexAnimationTransformPose& transformPose = sample.transformPoses[i];
+        if(transformPose.frameNumber >= 0)
+        {
+            meshes[i]->SetMeshToLocalMatrix(transformPose.meshToLocalMatrix);
+        }
+    }
+}
@@ -7,13 +7,16 @@
 #include "Component.h"
 
 #include <functional>
+#include <vector>
 
+#include "AABB.h"
 #include "Heading.h"
 #include "Profiler.h" // For Stopwatch
 #include "Vector3.h"
+#include "VertexAnimation.h"
 
+class Mesh;
 class MeshRenderer;
-class VertexAnimation;
 
 struct VertexAnimParams
 {
@@ -59,6 +62,11 @@ public:
 	
 	bool IsPlaying() const { return mCurrentParams.vertexAnimation != nullptr; }
     bool IsPlayingNotAutoscript() const { return mCurrentParams.vertexAnimation != nullptr && !mCurrentParams.fromAutoScript; }
+
+    // Samples the pose the next update (with this delta time) will apply, so that work can be done ahead of time.
+    // This only reads animation and mesh data, so it's safe to prepare many animators at once on worker threads.
+    // If the next update ends up sampling something else (e.g. a different anim was started), the prepared sample is ignored.
+    void PrepareUpdate(float deltaTime);
 	
 protected:
     void OnEnable() override;
@@ -79,7 +87,27 @@ private:
     // Problem: GK3 assumes objects continue to animate when they are not visible. But inactive objects don't Update!
     // To work around that, we'll use this timer to track how long a VertexAnimator is disabled.
     Stopwatch mDisabledTimer;
+
+    // Vertex and transform poses sampled for each mesh (and submesh), ready to be applied to the meshes.
+    struct AnimationSample
+    {
+        VertexAnimation* animation = nullptr;
+        float time = -1.0f;
+        int framesPerSecond = 0;
+
+        // The mesh renderer's meshes version when sampled - the poses only apply to the meshes they were sampled from.
+        uint32_t meshesVersion = 0;
+        std::vector<VertexAnimationVertexPose> vertexPoses;
+        std::vector<VertexAnimationTransformPose> transformPoses;
+
+        // Bounds of each vertex pose, calculated along with the poses (so on a worker thread, if prepared ahead of time).
+        std::vector<AABB> vertexPoseAABBs;
+    };
+    AnimationSample mPreparedSample;
 	
     void TakeSample(VertexAnimation* animation, int frame);
 	void TakeSample(VertexAnimation* animation, float time);
+
+    void CalculateSample(VertexAnimation* animation, float time, AnimationSample& sample) const;
+    void ApplySample(AnimationSample& sample);
 };
@@ -3,10 +3,10 @@
 #include "StringUtil.h"
 #include "TextWriter.h"
 
-void Config::Load(uint8_t* data, uint32_t dataLength)
+void Config::Load(const AssetBuffer& data)
 {
     // Read in each section and store it.
-    IniParser parser(data, dataLength);
+    IniParser parser(data.GetData(), data.GetSize());
     parser.SetMultipleKeyValuePairsPerLine(false);
 
     IniSection section;
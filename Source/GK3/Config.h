@@ -18,7 +18,7 @@ class Config : public Asset
 {
 public:
     Config(const std::string& name, AssetScope scope) : Asset(name, scope) { }
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
 
     void Save(const std::string& path);
 
@@ -81,6 +81,11 @@ void Scene::Load()
 		return;
 	}
 
+    // Fetch all assets this location/timeblock used last time in one go, and record what's used this time.
+    // Also start a new load report, to see where scene load time goes.
+    gAssetManager.BeginLoadReport(mLocation + mTimeblock.ToString());
+    gAssetManager.BeginManifest(mLocation + mTimeblock.ToString());
+
     // Set location.
     gLocationManager.SetLocation(mLocation);
 
@@ -201,6 +206,10 @@ void Scene::Load()
 
     // Init construction system.
     mConstruction.Init(this, mSceneData);
+
+    // Done loading assets for this scene.
+    gAssetManager.EndManifest();
+    gAssetManager.EndLoadReport();
 }
 
 void Scene::Unload()
@@ -296,21 +305,6 @@ void Scene::Update(float deltaTime)
 {
     if(mPaused) { return; }
 
-    //TEMP: for debug visualization of BSP ambient light sources.
-    //mSceneData->GetBSP()->DebugDrawAmbientLights(mEgo->GetPosition());
-
-    // Apply ambient light to actors.
-    for(auto& actor : mActors)
-    {
-        // Use the "model position" rather than the "actor position" for more accurate lighting.
-        // For example, in RC1, Buthane's actor position is way outside the map (dark color), but her model is near the van.
-        Color32 ambientColor = mSceneData->GetBSP()->CalculateAmbientLightColor(actor->GetFloorPosition());
-        for(Material& material : actor->GetMeshRenderer()->GetMaterials())
-        {
-            material.SetColor("uAmbientColor", ambientColor);
-        }
-    }
-
     // Check whether Ego has tripped any triggers.
     if(mEgo != nullptr && !mSceneData->GetTriggers().empty())
     {
@@ -344,6 +338,25 @@ void Scene::Update(float deltaTime)
     }
 }
 
+void Scene::ApplyAmbientLight()
+{
+    if(mPaused) { return; }
+
+    //TEMP: for debug visualization of BSP ambient light sources.
+    //mSceneData->GetBSP()->DebugDrawAmbientLights(mEgo->GetPosition());
+
+    for(auto& actor : mActors)
+    {
+        // Use the "model position" rather than the "actor position" for more accurate lighting.
+        // For example, in RC1, Buthane's actor position is way outside the map (dark color), but her model is near the van.
+        Color32 ambientColor = mSceneData->GetBSP()->CalculateAmbientLightColor(actor->GetFloorPosition());
+        for(Material& material : actor->GetMeshRenderer()->GetMaterials())
+        {
+            material.SetColor("uAmbientColor", ambientColor);
+        }
+    }
+}
+
 bool Scene::InitEgoPosition(const std::string& positionName)
 {
 	if(mEgo == nullptr) { return false; }
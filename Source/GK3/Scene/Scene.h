@@ -57,6 +57,10 @@ public:
 
     void Init();
     void Update(float deltaTime);
+
+    // Applies ambient light from the BSP to each actor's materials.
+    // This only reads actor positions and scene data, and only writes the actors' own materials, so it can run alongside other read-only actor work.
+    void ApplyAmbientLight();
 	
     bool InitEgoPosition(const std::string& positionName);
 	void SetCameraPosition(const std::string& cameraName);
@@ -12,12 +12,12 @@ SceneAsset::~SceneAsset()
 	delete mSkybox;
 }
 
-void SceneAsset::Load(uint8_t* data, uint32_t dataLength)
+void SceneAsset::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 }
 
-void SceneAsset::ParseFromData(uint8_t* data, uint32_t dataLength)
+void SceneAsset::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     IniParser parser(data, dataLength);
     parser.SetMultipleKeyValuePairsPerLine(false);
@@ -93,9 +93,9 @@ SceneInitFile::~SceneInitFile()
 	//TODO: delete any block conditions - we own them after compiling!
 }
 
-void SceneInitFile::Load(uint8_t* data, uint32_t dataLength)
+void SceneInitFile::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 }
 
 const SceneActor* SceneInitFile::FindCurrentEgo() const
@@ -151,7 +151,7 @@ GeneralBlock SceneInitFile::FindCurrentGeneralBlock() const
 	return block;
 }
 
-void SceneInitFile::ParseFromData(uint8_t* data, uint32_t dataLength)
+void SceneInitFile::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     IniParser parser(data, dataLength);
     parser.ParseAll();
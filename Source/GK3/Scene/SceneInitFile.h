@@ -236,7 +236,7 @@ public:
     SceneInitFile(const std::string& name, AssetScope scope) : Asset(name, scope) { }
 	~SceneInitFile();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
 	
 	const SceneActor* FindCurrentEgo() const;
 	GeneralBlock FindCurrentGeneralBlock() const;
@@ -295,5 +295,5 @@ private:
 	// This one's also pointers b/c NVCs are Assets.
     std::vector<ConditionalBlock<NVC*>> mActions;
 	
-	void ParseFromData(uint8_t* data, uint32_t dataLength);
+	void ParseFromData(const uint8_t* data, uint32_t dataLength);
 };
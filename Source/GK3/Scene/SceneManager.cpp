@@ -4,6 +4,8 @@
 #include "AssetManager.h"
 #include "Loader.h"
 #include "Profiler.h"
+#include "ThreadPool.h"
+#include "VertexAnimator.h"
 
 SceneManager gSceneManager;
 
@@ -24,21 +26,13 @@ void SceneManager::Update(float deltaTime)
 {
     if(mSceneLoading) { return; }
 
-    if(mScene != nullptr)
-    {
-        mScene->Update(deltaTime);
-    }
-
-    // Update actors, but *don't* update actors that are added when updating other actors!
-    // To guard against this, get size first and only update to that point.
-    size_t size = mActors.size();
-    for(size_t i = 0; i < size; ++i)
+    // Run this frame's update stages, spreading work across threads where possible.
+    if(mUpdateGraph.GetStageCount() == 0)
     {
-        mActors[i]->Update(deltaTime);
+        BuildUpdateGraph();
     }
-
-    // Delete any destroyed actors.
-    DeleteDestroyedActors();
+    mUpdateDeltaTime = deltaTime;
+    mUpdateGraph.Execute(ThreadPool::GetFrameJobSystem());
 }
 
 void SceneManager::UpdateLoading()
@@ -135,6 +129,59 @@ void SceneManager::UnloadSceneInternal()
     }
 }
 
+void SceneManager::BuildUpdateGraph()
+{
+    // Scene update runs scripts, checks triggers, etc - anything goes, so it must be on the main thread.
+    mUpdateGraph.AddStage("Update Scene", [this]() {
+        if(mScene != nullptr)
+        {
+            mScene->Update(mUpdateDeltaTime);
+        }
+    }, {}, { "Actors" }, true);
+
+    // The next two stages only read actors, and write separate data, so they run at the same time.
+    // Ambient lighting only writes each actor's materials.
+    mUpdateGraph.AddStage("Apply Ambient Light", [this]() {
+        if(mScene != nullptr)
+        {
+            mScene->ApplyAmbientLight();
+        }
+    }, { "Actors" }, { "ActorMaterials" });
+
+    // Sampling vertex animations only reads animation and mesh data, so all actors can be sampled in parallel.
+    // Actor updates then apply the prepared samples.
+    mUpdateGraph.AddStage("Sample Vertex Animations", [this]() {
+        ThreadPool::GetFrameJobSystem().ParallelFor(0, mActors.size(), [this](size_t i) {
+            if(mActors[i]->IsActive())
+            {
+                VertexAnimator* vertexAnimator = mActors[i]->GetComponent<VertexAnimator>();
+                if(vertexAnimator != nullptr && vertexAnimator->IsEnabled() && vertexAnimator->IsPlaying())
+                {
+                    vertexAnimator->PrepareUpdate(mUpdateDeltaTime);
+                }
+            }
+        });
+    }, { "Actors" }, { "VertexAnimationSamples" });
+
+    mUpdateGraph.AddStage("Update Actors", [this]() {
+        UpdateActors();
+    }, { "VertexAnimationSamples", "ActorMaterials" }, { "Actors" }, true);
+}
+
+void SceneManager::UpdateActors()
+{
+    // Update actors, but *don't* update actors that are added when updating other actors!
+    // To guard against this, get size first and only update to that point.
+    size_t size = mActors.size();
+    for(size_t i = 0; i < size; ++i)
+    {
+        mActors[i]->Update(mUpdateDeltaTime);
+    }
+
+    // Delete any destroyed actors.
+    DeleteDestroyedActors();
+}
+
 void SceneManager::DeleteDestroyedActors()
 {
     //TODO: Maybe switch to a "swap to end then delete" strategy.
@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "Scene.h"
+#include "TaskGraph.h"
 
 class Actor;
 
@@ -49,6 +50,13 @@ private:
 
     // A list of all actors that currently exist in the game.
     std::vector<Actor*> mActors;
+
+    // Stages of work done each frame to update the scene and actors, and the delta time for the current frame.
+    TaskGraph mUpdateGraph;
+    float mUpdateDeltaTime = 0.0f;
+
+    void BuildUpdateGraph();
+    void UpdateActors();
     
     void LoadSceneInternal();
     void UnloadSceneInternal();
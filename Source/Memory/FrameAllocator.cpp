@@ -0,0 +1,54 @@
+#include "FrameAllocator.h"
+
+#include <algorithm>
+
+uint8_t* FrameAllocator::sMemory = nullptr;
+size_t FrameAllocator::sSize = 0;
+LinearAllocator FrameAllocator::sAllocator(nullptr, 0);
+
+std::thread::id FrameAllocator::sOwnerThreadId;
+
+size_t FrameAllocator::sLastFrameAllocatedSize = 0;
+size_t FrameAllocator::sPeakAllocatedSize = 0;
+uint32_t FrameAllocator::sOverflowCount = 0;
+
+void FrameAllocator::Init(size_t size)
+{
+    Shutdown();
+    sMemory = new uint8_t[size];
+    sSize = size;
+    sAllocator = LinearAllocator(sMemory, size);
+    sOwnerThreadId = std::this_thread::get_id();
+}
+
+void FrameAllocator::Shutdown()
+{
+    delete[] sMemory;
+    sMemory = nullptr;
+    sSize = 0;
+    sAllocator = LinearAllocator(nullptr, 0);
+    sOwnerThreadId = std::thread::id();
+    sLastFrameAllocatedSize = 0;
+    sPeakAllocatedSize = 0;
+    sOverflowCount = 0;
+}
+
+void FrameAllocator::Reset()
+{
+    sLastFrameAllocatedSize = sAllocator.GetAllocatedSize();
+    sPeakAllocatedSize = std::max(sPeakAllocatedSize, sLastFrameAllocatedSize);
+    sAllocator.Reset();
+}
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment)
+{
+    // Only the owner thread can use frame memory - other threads may still be using it when the frame ends.
+    if(sMemory == nullptr || std::this_thread::get_id() != sOwnerThreadId) { return nullptr; }
+
+    void* memory = sAllocator.Allocate(size, static_cast<unsigned short>(alignment));
+    if(memory == nullptr)
+    {
+        ++sOverflowCount;
+    }
+    return memory;
+}
@@ -0,0 +1,99 @@
+//
+// Clark Kromenaker
+//
+// Memory for temporary allocations that only need to last until the end of the current frame.
+//
+// Allocating is just bumping a pointer (no malloc), and freeing is free - everything is freed at once when the next frame starts.
+// Great for scratch memory in hot paths (e.g. function call arguments, search data), but memory must not be held onto past the frame!
+//
+// Only the thread that initialized the frame allocator (the main thread) uses frame memory.
+// Other threads (and any allocations when frame memory runs out) fall back to regular heap allocations.
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "LinearAllocator.h"
+
+class FrameAllocator
+{
+public:
+    // Allocates the frame memory block. The calling thread becomes the one thread that uses frame memory.
+    static void Init(size_t size);
+    static void Shutdown();
+
+    // Frees all frame allocations. Should be called once at the start of each frame.
+    static void Reset();
+
+    // Allocates frame memory, or returns null if out of frame memory (or not called from the main thread).
+    static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Is this memory part of the frame memory block?
+    static bool Owns(const void* memory)
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+        uintptr_t start = reinterpret_cast<uintptr_t>(sMemory);
+        return address >= start && address < start + sSize;
+    }
+
+    // Usage stats.
+    static size_t GetCapacity() { return sSize; }
+    static size_t GetAllocatedSize() { return sAllocator.GetAllocatedSize(); }
+    static size_t GetLastFrameAllocatedSize() { return sLastFrameAllocatedSize; }
+    static size_t GetPeakAllocatedSize() { return sPeakAllocatedSize; }
+    static uint32_t GetOverflowCount() { return sOverflowCount; }
+
+private:
+    // The frame memory block, and the allocator that hands out memory from it.
+    static uint8_t* sMemory;
+    static size_t sSize;
+    static LinearAllocator sAllocator;
+
+    // The only thread allowed to use frame memory.
+    static std::thread::id sOwnerThreadId;
+
+    // Frame memory used last frame, most used in any frame, and number of allocations that didn't fit.
+    static size_t sLastFrameAllocatedSize;
+    static size_t sPeakAllocatedSize;
+    static uint32_t sOverflowCount;
+};
+
+// An allocator for STL containers that uses frame memory, falling back to the heap when frame memory can't be used.
+// Containers using it must not outlive the frame. Reserving capacity up front is best - memory given up by growing a container isn't reused.
+template<typename T>
+class FrameStlAllocator
+{
+public:
+    typedef T value_type;
+
+    FrameStlAllocator() = default;
+    template<typename U> FrameStlAllocator(const FrameStlAllocator<U>& other) { }
+
+    T* allocate(size_t count)
+    {
+        void* memory = FrameAllocator::Allocate(count * sizeof(T), alignof(T));
+        if(memory == nullptr)
+        {
+            memory = ::operator new(count * sizeof(T));
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* memory, size_t count)
+    {
+        // Frame memory is all freed at once when the frame ends - only heap memory needs to be freed here.
+        if(!FrameAllocator::Owns(memory))
+        {
+            ::operator delete(memory);
+        }
+    }
+};
+
+template<typename T, typename U> bool operator==(const FrameStlAllocator<T>&, const FrameStlAllocator<U>&) { return true; }
+template<typename T, typename U> bool operator!=(const FrameStlAllocator<T>&, const FrameStlAllocator<U>&) { return false; }
+
+// Handy aliases for containers using frame memory.
+template<typename T> using FrameVector = std::vector<T, FrameStlAllocator<T>>;
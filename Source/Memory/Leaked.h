@@ -0,0 +1,32 @@
+//
+// Clark Kromenaker
+//
+// Holds an object that is intentionally never destroyed.
+//
+// Static objects are destroyed in no particular order when the program exits. Some objects (pools, registries, locks)
+// may still be used by other static objects as those are destroyed - if they're destroyed first, that's a use-after-free.
+// A leaked object is created on first use, and lives until the process exits (at which point the OS reclaims its memory).
+//
+// Use as a function-local static, so the object is created on first use:
+//     static Leaked<std::mutex> mutex;
+//     return *mutex;
+//
+#pragma once
+#include <utility>
+
+template<typename T>
+class Leaked
+{
+public:
+    template<typename... Args> explicit Leaked(Args&&... args) : mObject(new T(std::forward<Args>(args)...)) { }
+
+    // No destructor, so this is trivially destructible - nothing happens to it during static destruction.
+    Leaked(const Leaked&) = delete;
+    Leaked& operator=(const Leaked&) = delete;
+
+    T& operator*() const { return *mObject; }
+    T* operator->() const { return mObject; }
+
+private:
+    T* mObject = nullptr;
+};
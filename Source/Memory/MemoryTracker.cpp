@@ -0,0 +1,222 @@
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+
+#include "StringUtil.h"
+
+thread_local MemoryTag MemoryTracker::sCurrentTag = MemoryTag::General;
+
+namespace
+{
+    const size_t kTagCount = static_cast<size_t>(MemoryTag::Count);
+
+    // Stats per tag. Allocations happen on every thread, so all stats are atomic.
+    // Relaxed ordering is fine - each stat only needs to be eventually correct, not consistent with the others.
+    std::atomic<size_t> currentBytes[kTagCount];
+    std::atomic<size_t> peakBytes[kTagCount];
+    std::atomic<size_t> currentAllocations[kTagCount];
+    std::atomic<uint64_t> totalAllocations[kTagCount];
+    std::atomic<uint32_t> frameAllocations[kTagCount];
+    std::atomic<uint32_t> lastFrameAllocations[kTagCount];
+
+    // Call sites are kept in a fixed-size hash table, since the tracker can't allocate memory while tracking an allocation.
+    // Slots are claimed by swapping in the call site address. Once claimed, a slot is never given up (until cleared).
+    struct CallSiteSlot
+    {
+        std::atomic<uintptr_t> address;
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> bytes;
+    };
+    const size_t kCallSiteSlotCount = 4096;
+    const size_t kMaxCallSiteProbes = 32;
+    CallSiteSlot callSites[kCallSiteSlotCount];
+    std::atomic<bool> callSiteTrackingEnabled { false };
+
+    void AddCallSite(void* callSite, size_t size)
+    {
+        uintptr_t address = reinterpret_cast<uintptr_t>(callSite);
+        if(address == 0) { return; }
+
+        // Find the call site's slot, or claim an empty one. If the table is too full, the allocation just isn't counted.
+        size_t index = static_cast<size_t>((address >> 2) * 2654435761u) % kCallSiteSlotCount;
+        for(size_t i = 0; i < kMaxCallSiteProbes; ++i)
+        {
+            CallSiteSlot& slot = callSites[(index + i) % kCallSiteSlotCount];
+            uintptr_t slotAddress = slot.address.load(std::memory_order_relaxed);
+            if(slotAddress == 0 && slot.address.compare_exchange_strong(slotAddress, address, std::memory_order_relaxed))
+            {
+                slotAddress = address;
+            }
+            if(slotAddress == address)
+            {
+                slot.allocations.fetch_add(1, std::memory_order_relaxed);
+                slot.bytes.fetch_add(size, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+}
+
+/*static*/ const char* MemoryTracker::GetTagName(MemoryTag tag)
+{
+    switch(tag)
+    {
+    case MemoryTag::General:
+        return "General";
+    case MemoryTag::Assets:
+        return "Assets";
+    case MemoryTag::Rendering:
+        return "Rendering";
+    case MemoryTag::Sheep:
+        return "Sheep";
+    case MemoryTag::UI:
+        return "UI";
+    case MemoryTag::Video:
+        return "Video";
+    case MemoryTag::Audio:
+        return "Audio";
+    default:
+        return "Unknown";
+    }
+}
+
+/*static*/ void MemoryTracker::OnAllocate(size_t size, MemoryTag tag, void* callSite)
+{
+    size_t tagIndex = static_cast<size_t>(tag);
+    if(tagIndex >= kTagCount) { return; }
+
+    size_t bytes = currentBytes[tagIndex].fetch_add(size, std::memory_order_relaxed) + size;
+    currentAllocations[tagIndex].fetch_add(1, std::memory_order_relaxed);
+    totalAllocations[tagIndex].fetch_add(1, std::memory_order_relaxed);
+    frameAllocations[tagIndex].fetch_add(1, std::memory_order_relaxed);
+
+    // Raise the peak, unless another thread raised it even higher in the meantime.
+    size_t peak = peakBytes[tagIndex].load(std::memory_order_relaxed);
+    while(bytes > peak && !peakBytes[tagIndex].compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) { }
+
+    if(callSiteTrackingEnabled.load(std::memory_order_relaxed))
+    {
+        AddCallSite(callSite, size);
+    }
+}
+
+/*static*/ void MemoryTracker::OnDeallocate(size_t size, MemoryTag tag)
+{
+    size_t tagIndex = static_cast<size_t>(tag);
+    if(tagIndex >= kTagCount) { return; }
+    currentBytes[tagIndex].fetch_sub(size, std::memory_order_relaxed);
+    currentAllocations[tagIndex].fetch_sub(1, std::memory_order_relaxed);
+}
+
+/*static*/ void MemoryTracker::EndFrame()
+{
+    for(size_t i = 0; i < kTagCount; ++i)
+    {
+        lastFrameAllocations[i].store(frameAllocations[i].exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+/*static*/ MemoryTracker::TagStats MemoryTracker::GetTagStats(MemoryTag tag)
+{
+    TagStats stats;
+    size_t tagIndex = static_cast<size_t>(tag);
+    if(tagIndex < kTagCount)
+    {
+        stats.currentBytes = currentBytes[tagIndex].load(std::memory_order_relaxed);
+        stats.peakBytes = peakBytes[tagIndex].load(std::memory_order_relaxed);
+        stats.currentAllocations = currentAllocations[tagIndex].load(std::memory_order_relaxed);
+        stats.totalAllocations = totalAllocations[tagIndex].load(std::memory_order_relaxed);
+        stats.lastFrameAllocations = lastFrameAllocations[tagIndex].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+/*static*/ MemoryTracker::TagStats MemoryTracker::GetTotalStats()
+{
+    // Peaks for each tag may have happened at different times, so the sum of peaks is only an upper bound on the overall peak.
+    TagStats total;
+    for(size_t i = 0; i < kTagCount; ++i)
+    {
+        TagStats stats = GetTagStats(static_cast<MemoryTag>(i));
+        total.currentBytes += stats.currentBytes;
+        total.peakBytes += stats.peakBytes;
+        total.currentAllocations += stats.currentAllocations;
+        total.totalAllocations += stats.totalAllocations;
+        total.lastFrameAllocations += stats.lastFrameAllocations;
+    }
+    return total;
+}
+
+/*static*/ void MemoryTracker::SetCallSiteTrackingEnabled(bool enabled)
+{
+    callSiteTrackingEnabled = enabled;
+}
+
+/*static*/ bool MemoryTracker::IsCallSiteTrackingEnabled()
+{
+    return callSiteTrackingEnabled;
+}
+
+/*static*/ void MemoryTracker::ClearCallSites()
+{
+    // Allocations being counted at the same time may be lost or land in a cleared slot - that's OK for stats.
+    for(CallSiteSlot& slot : callSites)
+    {
+        slot.address.store(0, std::memory_order_relaxed);
+        slot.allocations.store(0, std::memory_order_relaxed);
+        slot.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+/*static*/ std::vector<MemoryTracker::CallSite> MemoryTracker::GetTopCallSites(size_t count)
+{
+    std::vector<CallSite> sites;
+    for(CallSiteSlot& slot : callSites)
+    {
+        uintptr_t address = slot.address.load(std::memory_order_relaxed);
+        if(address != 0)
+        {
+            CallSite site;
+            site.address = reinterpret_cast<void*>(address);
+            site.allocations = slot.allocations.load(std::memory_order_relaxed);
+            site.bytes = slot.bytes.load(std::memory_order_relaxed);
+            sites.push_back(site);
+        }
+    }
+
+    count = std::min(count, sites.size());
+    std::partial_sort(sites.begin(), sites.begin() + count, sites.end(), [](const CallSite& a, const CallSite& b) {
+        return a.allocations > b.allocations;
+    });
+    sites.resize(count);
+    return sites;
+}
+
+/*static*/ std::string MemoryTracker::Dump(size_t callSiteCount)
+{
+    std::stringstream ss;
+    ss << StringUtil::Format("%-12s %12s %12s %10s %12s %10s", "Tag", "Current KB", "Peak KB", "Live", "Allocs", "Last Frame") << std::endl;
+    for(size_t i = 0; i <= kTagCount; ++i)
+    {
+        // One extra row at the end for totals.
+        bool totalRow = i == kTagCount;
+        TagStats stats = totalRow ? GetTotalStats() : GetTagStats(static_cast<MemoryTag>(i));
+        const char* name = totalRow ? "Total" : GetTagName(static_cast<MemoryTag>(i));
+        ss << StringUtil::Format("%-12s %12.1f %12.1f %10zu %12llu %10u", name, stats.currentBytes / 1024.0f,
+                                 stats.peakBytes / 1024.0f, stats.currentAllocations,
+                                 static_cast<unsigned long long>(stats.totalAllocations), stats.lastFrameAllocations) << std::endl;
+    }
+
+    if(IsCallSiteTrackingEnabled())
+    {
+        ss << std::endl << StringUtil::Format("%-18s %12s %12s", "Call Site", "Allocs", "KB") << std::endl;
+        for(const CallSite& site : GetTopCallSites(callSiteCount))
+        {
+            ss << StringUtil::Format("%-18p %12llu %12.1f", site.address, static_cast<unsigned long long>(site.allocations),
+                                     site.bytes / 1024.0f) << std::endl;
+        }
+    }
+    return ss.str();
+}
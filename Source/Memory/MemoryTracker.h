@@ -0,0 +1,91 @@
+//
+// Clark Kromenaker
+//
+// Meters heap allocations made through the global new/delete operators (see New.cpp).
+//
+// Every allocation is tagged with the subsystem that made it (Assets, Rendering, Sheep, etc).
+// Code sets the current tag with a MemoryTagScope - the innermost scope on the current thread wins.
+// Allocations made outside of any scope are tagged "General".
+//
+// For each tag, tracks bytes currently allocated, the most bytes ever allocated, and allocation counts (total and per frame).
+// Optionally, it can also count allocations per call site, to find exactly where allocation churn comes from.
+//
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class MemoryTag : uint8_t
+{
+    General,
+    Assets,
+    Rendering,
+    Sheep,
+    UI,
+    Video,
+    Audio,
+    Count
+};
+
+class MemoryTracker
+{
+public:
+    struct TagStats
+    {
+        size_t currentBytes = 0;
+        size_t peakBytes = 0;
+        size_t currentAllocations = 0;
+        uint64_t totalAllocations = 0;
+        uint32_t lastFrameAllocations = 0;
+    };
+
+    struct CallSite
+    {
+        // Return address of the code that called new - resolve to a function with a debugger or addr2line.
+        void* address = nullptr;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    static const char* GetTagName(MemoryTag tag);
+
+    // The tag given to allocations made on this thread.
+    static MemoryTag GetCurrentTag() { return sCurrentTag; }
+    static void SetCurrentTag(MemoryTag tag) { sCurrentTag = tag; }
+
+    // Called by the global new/delete operators. These must not allocate!
+    static void OnAllocate(size_t size, MemoryTag tag, void* callSite);
+    static void OnDeallocate(size_t size, MemoryTag tag);
+
+    // Marks the end of a frame, for per-frame allocation counts. Should be called once at the start of each frame.
+    static void EndFrame();
+
+    static TagStats GetTagStats(MemoryTag tag);
+    static TagStats GetTotalStats();
+
+    // Call site tracking is off by default, since it makes every allocation a bit slower.
+    static void SetCallSiteTrackingEnabled(bool enabled);
+    static bool IsCallSiteTrackingEnabled();
+    static void ClearCallSites();
+
+    // Call sites that allocated most often, most frequent first.
+    static std::vector<CallSite> GetTopCallSites(size_t count);
+
+    // Outputs stats for all tags, and the top call sites (if tracked).
+    static std::string Dump(size_t callSiteCount = 20);
+
+private:
+    static thread_local MemoryTag sCurrentTag;
+};
+
+// Tags allocations made on this thread with the given tag, until the scope ends.
+class MemoryTagScope
+{
+public:
+    MemoryTagScope(MemoryTag tag) : mPreviousTag(MemoryTracker::GetCurrentTag()) { MemoryTracker::SetCurrentTag(tag); }
+    ~MemoryTagScope() { MemoryTracker::SetCurrentTag(mPreviousTag); }
+
+private:
+    MemoryTag mPreviousTag;
+};
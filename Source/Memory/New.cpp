@@ -1,40 +1,111 @@
 #include <cstdlib>
-#include <iostream>
+#include <new>
+
+#include "MemoryTracker.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CALL_SITE() _ReturnAddress()
+#else
+#define CALL_SITE() __builtin_return_address(0)
+#endif
 
 // Replacements for default C++ new/new[] and delete/delete[].
-// Overriding the default functions gives us a way to "meter" when memory is allocated or deleted.
+// Overriding the default functions gives us a way to "meter" when memory is allocated or deleted (see MemoryTracker).
+//
+// Each allocation is preceded by a small header, which remembers the allocation's size and tag.
+// That's needed because delete doesn't always know the size, and the tag may have changed by the time memory is deleted.
+namespace
+{
+    struct alignas(std::max_align_t) AllocationHeader
+    {
+        size_t size;
+        MemoryTag tag;
+    };
+
+    void* Allocate(size_t size, void* callSite)
+    {
+        AllocationHeader* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+        if(header == nullptr) { return nullptr; }
+
+        header->size = size;
+        header->tag = MemoryTracker::GetCurrentTag();
+        MemoryTracker::OnAllocate(size, header->tag, callSite);
+        return header + 1;
+    }
+
+    // Throwing new must never return null. Like the default new, give any new handler a chance to free up memory, and throw if there isn't one.
+    void* AllocateOrThrow(size_t size, void* callSite)
+    {
+        void* mem = nullptr;
+        while((mem = Allocate(size, callSite)) == nullptr)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if(handler == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+        return mem;
+    }
+
+    void Deallocate(void* mem)
+    {
+        if(mem == nullptr) { return; }
+
+        AllocationHeader* header = static_cast<AllocationHeader*>(mem) - 1;
+        MemoryTracker::OnDeallocate(header->size, header->tag);
+        std::free(header);
+    }
+}
+
 void* operator new(size_t size)
 {
-    //std::cout << "new " << size << std::endl;
-    return std::malloc(size);
+    return AllocateOrThrow(size, CALL_SITE());
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size, CALL_SITE());
 }
 
 void operator delete(void* mem) noexcept
 {
-    //std::cout << "delete" << std::endl;
-    std::free(mem);
+    Deallocate(mem);
 }
 
 void operator delete(void* mem, size_t size) noexcept
 {
-    //std::cout << "delete" << std::endl;
-    std::free(mem);
+    Deallocate(mem);
+}
+
+void operator delete(void* mem, const std::nothrow_t&) noexcept
+{
+    Deallocate(mem);
 }
 
 void* operator new[](size_t size)
 {
-    //std::cout << "new[] " << size << std::endl;
-    return std::malloc(size);
+    return AllocateOrThrow(size, CALL_SITE());
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return Allocate(size, CALL_SITE());
 }
 
 void operator delete[](void* mem) noexcept
 {
-    //std::cout << "delete[]" << std::endl;
-    std::free(mem);
+    Deallocate(mem);
 }
 
 void operator delete[](void* mem, size_t size) noexcept
 {
-    //std::cout << "delete" << std::endl;
-    std::free(mem);
-}
\ No newline at end of file
+    Deallocate(mem);
+}
+
+void operator delete[](void* mem, const std::nothrow_t&) noexcept
+{
+    Deallocate(mem);
+}
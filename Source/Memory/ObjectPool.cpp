@@ -0,0 +1,228 @@
+#include "ObjectPool.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "Leaked.h"
+#include "StringUtil.h"
+
+namespace
+{
+    // All pools in existence. Pools can themselves be statics, which unregister whenever they happen to be destroyed.
+    std::mutex& GetRegistryMutex()
+    {
+        static Leaked<std::mutex> mutex;
+        return *mutex;
+    }
+
+    std::vector<ObjectPool*>& GetRegistry()
+    {
+        static Leaked<std::vector<ObjectPool*>> pools;
+        return *pools;
+    }
+}
+
+/*static*/ std::string ObjectPool::DumpAll()
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+
+    // Sort by name, so related pools are listed together.
+    std::vector<ObjectPool*> pools = GetRegistry();
+    std::sort(pools.begin(), pools.end(), [](const ObjectPool* a, const ObjectPool* b) {
+        return a->GetName() < b->GetName();
+    });
+
+    std::stringstream ss;
+    ss << StringUtil::Format("%-20s %8s %8s %8s %8s %8s %10s %10s", "Pool", "Block", "Live", "Peak", "Capacity", "Chunks",
+                             "Allocs", "KB") << std::endl;
+    for(ObjectPool* pool : pools)
+    {
+        size_t capacity = pool->GetCapacity();
+        ss << StringUtil::Format("%-20s %8zu %8zu %8zu %8zu %8zu %10zu %10.1f", pool->GetName().c_str(), pool->GetBlockSize(),
+                                 pool->GetLiveCount(), pool->GetPeakCount(), capacity, pool->GetChunkCount(),
+                                 pool->GetTotalAllocationCount(), (capacity * pool->GetBlockSize()) / 1024.0f) << std::endl;
+    }
+    return ss.str();
+}
+
+ObjectPool::Chunk::Chunk(size_t size, size_t blockSize, size_t alignment) :
+    memory(new unsigned char[size]),
+    allocator(memory, size, blockSize, static_cast<unsigned short>(alignment))
+{
+
+}
+
+ObjectPool::Chunk::~Chunk()
+{
+    delete[] memory;
+}
+
+ObjectPool::ObjectPool(const std::string& name, size_t blockSize, size_t alignment, size_t blocksPerChunk) :
+    mName(name),
+    mBlockSize(blockSize),
+    mAlignment(alignment),
+    mBlocksPerChunk(std::max(blocksPerChunk, static_cast<size_t>(1)))
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    GetRegistry().push_back(this);
+}
+
+ObjectPool::~ObjectPool()
+{
+    std::lock_guard<std::mutex> lock(GetRegistryMutex());
+    std::vector<ObjectPool*>& pools = GetRegistry();
+    pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+}
+
+void* ObjectPool::Allocate()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    // Try the chunk that last had free blocks, then every other chunk.
+    void* memory = nullptr;
+    if(mFreeChunkIndex < mChunks.size())
+    {
+        memory = mChunks[mFreeChunkIndex]->allocator.Allocate();
+    }
+    for(size_t i = 0; memory == nullptr && i < mChunks.size(); ++i)
+    {
+        memory = mChunks[i]->allocator.Allocate();
+        if(memory != nullptr)
+        {
+            mFreeChunkIndex = i;
+        }
+    }
+
+    // All chunks are full - add another one. Leave room to align the first block.
+    if(memory == nullptr)
+    {
+        mChunks.emplace_back(new Chunk(mBlocksPerChunk * mBlockSize + mAlignment, mBlockSize, mAlignment));
+        mFreeChunkIndex = mChunks.size() - 1;
+        memory = mChunks.back()->allocator.Allocate();
+    }
+
+    // Pools back class-specific operator new (e.g. for actors and components), which must never return null.
+    if(memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+
+    ++mLiveCount;
+    ++mTotalAllocationCount;
+    mPeakCount = std::max(mPeakCount, mLiveCount);
+    return memory;
+}
+
+void ObjectPool::Deallocate(void* memory)
+{
+    if(memory == nullptr) { return; }
+    std::lock_guard<std::mutex> lock(mMutex);
+    for(size_t i = 0; i < mChunks.size(); ++i)
+    {
+        if(mChunks[i]->allocator.Owns(memory))
+        {
+            mChunks[i]->allocator.Deallocate(memory);
+            mFreeChunkIndex = i;
+            --mLiveCount;
+            return;
+        }
+    }
+}
+
+bool ObjectPool::Owns(const void* memory) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for(auto& chunk : mChunks)
+    {
+        if(chunk->allocator.Owns(memory))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ObjectPool::GetChunkCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mChunks.size();
+}
+
+size_t ObjectPool::GetCapacity() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    size_t capacity = 0;
+    for(auto& chunk : mChunks)
+    {
+        capacity += chunk->allocator.GetBlockCount();
+    }
+    return capacity;
+}
+
+size_t ObjectPool::GetLiveCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLiveCount;
+}
+
+size_t ObjectPool::GetPeakCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mPeakCount;
+}
+
+size_t ObjectPool::GetTotalAllocationCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTotalAllocationCount;
+}
+
+SizedObjectPools::SizedObjectPools(const std::string& name, size_t maxBlockSize) :
+    mName(name)
+{
+    mPools.resize((maxBlockSize + kSizeClassStep - 1) / kSizeClassStep);
+}
+
+void* SizedObjectPools::Allocate(size_t size)
+{
+    // Too big for any pool? Use the heap.
+    size_t poolIndex = size > 0 ? (size - 1) / kSizeClassStep : 0;
+    if(poolIndex >= mPools.size())
+    {
+        return ::operator new(size);
+    }
+
+    // Create the pool for this size class, if it doesn't exist yet.
+    ObjectPool* pool = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(mPools[poolIndex] == nullptr)
+        {
+            size_t blockSize = (poolIndex + 1) * kSizeClassStep;
+            mPools[poolIndex].reset(new ObjectPool(mName + "/" + std::to_string(blockSize), blockSize));
+        }
+        pool = mPools[poolIndex].get();
+    }
+    return pool->Allocate();
+}
+
+void SizedObjectPools::Deallocate(void* memory, size_t size)
+{
+    if(memory == nullptr) { return; }
+
+    // Objects too big for any pool came from the heap.
+    size_t poolIndex = size > 0 ? (size - 1) / kSizeClassStep : 0;
+    if(poolIndex >= mPools.size())
+    {
+        ::operator delete(memory);
+        return;
+    }
+
+    // The pool must exist, since the object was allocated from it.
+    ObjectPool* pool = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        pool = mPools[poolIndex].get();
+    }
+    pool->Deallocate(memory);
+}
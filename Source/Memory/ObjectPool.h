@@ -0,0 +1,126 @@
+//
+// Clark Kromenaker
+//
+// A growable pool of fixed-size blocks, for objects that are created and destroyed often (actors, components, script threads).
+//
+// Blocks come from chunks of memory, each handed out by a PoolAllocator. When all chunks are full, a new chunk is added.
+// Chunks are never moved or freed while the pool exists, so objects have stable addresses,
+// and objects of the same kind end up next to each other in memory (rather than scattered all over the heap).
+//
+// Every pool registers itself by name, so usage stats for all pools can be dumped at once.
+//
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "PoolAllocator.h"
+
+class ObjectPool
+{
+public:
+    // Outputs stats for all pools that currently exist.
+    static std::string DumpAll();
+
+    ObjectPool(const std::string& name, size_t blockSize, size_t alignment = alignof(std::max_align_t), size_t blocksPerChunk = 64);
+    ~ObjectPool();
+
+    // Pools are registered by address, so no copying or moving.
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Allocates a single block. Never returns null - throws std::bad_alloc if a block can't be allocated.
+    void* Allocate();
+    void Deallocate(void* memory);
+
+    // Is this memory a block from this pool?
+    bool Owns(const void* memory) const;
+
+    // Constructs/destroys an object in a block from this pool.
+    template<typename T, typename... Args> T* New(Args&&... args);
+    template<typename T> void Delete(T* object);
+
+    // Usage stats.
+    const std::string& GetName() const { return mName; }
+    size_t GetBlockSize() const { return mBlockSize; }
+    size_t GetChunkCount() const;
+    size_t GetCapacity() const;
+    size_t GetLiveCount() const;
+    size_t GetPeakCount() const;
+    size_t GetTotalAllocationCount() const;
+
+private:
+    // Name of the pool (used in stats output).
+    std::string mName;
+
+    // Size and alignment of each block, and number of blocks in each chunk.
+    size_t mBlockSize = 0;
+    size_t mAlignment = 0;
+    size_t mBlocksPerChunk = 0;
+
+    // Chunks of memory that blocks are allocated from.
+    struct Chunk
+    {
+        Chunk(size_t size, size_t blockSize, size_t alignment);
+        ~Chunk();
+
+        unsigned char* memory = nullptr;
+        PoolAllocator allocator;
+    };
+    std::vector<std::unique_ptr<Chunk>> mChunks;
+
+    // Index of a chunk that (probably) has free blocks - checked first when allocating.
+    size_t mFreeChunkIndex = 0;
+
+    // Blocks in use, most blocks in use at once, and total allocations over the pool's lifetime.
+    size_t mLiveCount = 0;
+    size_t mPeakCount = 0;
+    size_t mTotalAllocationCount = 0;
+
+    // Objects may be created/destroyed on any thread.
+    mutable std::mutex mMutex;
+};
+
+template<typename T, typename... Args>
+T* ObjectPool::New(Args&&... args)
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types aren't supported");
+    return new(Allocate()) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void ObjectPool::Delete(T* object)
+{
+    if(object == nullptr) { return; }
+    object->~T();
+    Deallocate(object);
+}
+
+// A set of pools for objects of varying size (e.g. all subclasses of some base class), one pool per size class.
+// Sizes are rounded up to the size class, and pools are only created once an object of that size class is allocated.
+// Objects bigger than the largest size class fall back to the heap.
+class SizedObjectPools
+{
+public:
+    SizedObjectPools(const std::string& name, size_t maxBlockSize = 1024);
+
+    void* Allocate(size_t size);
+    void Deallocate(void* memory, size_t size);
+
+private:
+    // Size classes are multiples of this.
+    static const size_t kSizeClassStep = 16;
+
+    // Name of the pool set - each pool is named after the set and its size class.
+    std::string mName;
+
+    // One pool per size class.
+    std::vector<std::unique_ptr<ObjectPool>> mPools;
+
+    // Guards pool creation.
+    std::mutex mMutex;
+};
@@ -0,0 +1,73 @@
+#include "PoolAllocator.h"
+
+#include <cassert>
+
+#include "PtrMath.h"
+
+PoolAllocator::PoolAllocator(void* memory, size_t size, size_t blockSize, unsigned short alignment) :
+    mMemory(memory),
+    mSize(size)
+{
+    // Each block needs room to store a free list pointer, and each block must start at an aligned address.
+    if(blockSize < sizeof(FreeBlock))
+    {
+        blockSize = sizeof(FreeBlock);
+    }
+    if(alignment < alignof(FreeBlock))
+    {
+        alignment = alignof(FreeBlock);
+    }
+    mBlockSize = (blockSize + alignment - 1) & ~static_cast<size_t>(alignment - 1);
+
+    // Figure out how many blocks fit, after aligning the first one.
+    mFirstBlock = PtrMath::Align(mMemory, alignment);
+    size_t alignOffset = static_cast<size_t>(PtrMath::Diff(mFirstBlock, mMemory));
+    mBlockCount = mSize > alignOffset ? (mSize - alignOffset) / mBlockSize : 0;
+    Reset();
+}
+
+void* PoolAllocator::Allocate()
+{
+    // If no free blocks left, return nullptr!
+    if(mFreeListHead == nullptr) { return nullptr; }
+
+    // Take the first free block.
+    FreeBlock* block = mFreeListHead;
+    mFreeListHead = block->next;
+    ++mAllocationCount;
+    return block;
+}
+
+void PoolAllocator::Deallocate(void* memory)
+{
+    if(memory == nullptr) { return; }
+    assert(Owns(memory));
+
+    // Freed block goes on the front of the free list - it's likely still in cache, so it's a good one to use next.
+    FreeBlock* block = static_cast<FreeBlock*>(memory);
+    block->next = mFreeListHead;
+    mFreeListHead = block;
+    --mAllocationCount;
+}
+
+void PoolAllocator::Reset()
+{
+    // Link all blocks together, in address order.
+    mFreeListHead = nullptr;
+    for(size_t i = mBlockCount; i > 0; --i)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(PtrMath::Add(mFirstBlock, static_cast<int>((i - 1) * mBlockSize)));
+        block->next = mFreeListHead;
+        mFreeListHead = block;
+    }
+
+    // Reset memory stats.
+    mAllocationCount = 0;
+}
+
+bool PoolAllocator::Owns(const void* memory) const
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+    uintptr_t start = reinterpret_cast<uintptr_t>(mFirstBlock);
+    return address >= start && address < start + mBlockCount * mBlockSize && (address - start) % mBlockSize == 0;
+}
@@ -0,0 +1,50 @@
+//
+// Clark Kromenaker
+//
+// Allocates fixed-size blocks from a provided memory buffer.
+//
+// The buffer is split into equal blocks. Free blocks form a linked list (stored in the free blocks themselves),
+// so allocating and deallocating are both just a pointer swap, in any order, with no fragmentation.
+//
+// The tradeoff: every allocation is the same size. Great for lots of objects of one type.
+//
+#pragma once
+#include <cstddef>
+
+class PoolAllocator
+{
+public:
+    PoolAllocator(void* memory, size_t size, size_t blockSize, unsigned short alignment = 4);
+
+    void* Allocate();
+    void Deallocate(void* memory);
+
+    void Reset();
+
+    bool Owns(const void* memory) const;
+
+    size_t GetBlockSize() const { return mBlockSize; }
+    size_t GetBlockCount() const { return mBlockCount; }
+    size_t GetAllocationCount() const { return mAllocationCount; }
+    size_t GetAllocatedSize() const { return mAllocationCount * mBlockSize; }
+
+private:
+    // The allocator's memory.
+    void* mMemory = nullptr;
+    size_t mSize = 0;
+
+    // Start of the first block (after alignment), size of each block (including alignment padding), and number of blocks.
+    void* mFirstBlock = nullptr;
+    size_t mBlockSize = 0;
+    size_t mBlockCount = 0;
+
+    // Allocation stats.
+    size_t mAllocationCount = 0;
+
+    // First free block available. Each free block holds a pointer to the next free block.
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+    FreeBlock* mFreeListHead = nullptr;
+};
@@ -2,9 +2,21 @@
 
 #include "Debug.h"
 #include "Component.h"
+#include "Leaked.h"
+#include "ObjectPool.h"
 #include "RectTransform.h"
 #include "SceneManager.h"
 
+namespace
+{
+    // Actors owned by static objects may be deleted after this file's statics are gone.
+    SizedObjectPools& GetActorPools()
+    {
+        static Leaked<SizedObjectPools> pools("Actor");
+        return *pools;
+    }
+}
+
 Actor::Actor()
 {
     gSceneManager.AddActor(this);
@@ -50,6 +62,16 @@ Actor::~Actor()
     mComponents.clear();
 }
 
+/*static*/ void* Actor::operator new(size_t size)
+{
+    return GetActorPools().Allocate(size);
+}
+
+/*static*/ void Actor::operator delete(void* memory, size_t size)
+{
+    GetActorPools().Deallocate(memory, size);
+}
+
 void Actor::Update(float deltaTime)
 {
 	if(IsActive() && mUpdateEnabled)
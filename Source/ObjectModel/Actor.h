@@ -36,6 +36,10 @@ public:
     Actor(const std::string& name);
     Actor(const std::string& name, TransformType transformType);
     virtual ~Actor();
+
+    // Actors are allocated from pools (one per size class), rather than scattered around the heap.
+    static void* operator new(size_t size);
+    static void operator delete(void* memory, size_t size);
     
 	void Update(float deltaTime);
     
@@ -58,6 +62,7 @@ public:
 	bool IsDestroyOnLoad() const;
     
     void SetTimeScale(float timeScale) { mTimeScale = timeScale; }
+    float GetTimeScale() const { return mTimeScale; }
     void SetUpdateEnabled(bool updateEnabled) { mUpdateEnabled = updateEnabled; }
 	
 	// TRANSFORM CONVENIENCE ACCESSORS
@@ -1,9 +1,31 @@
 #include "Component.h"
 
 #include "Actor.h"
+#include "Leaked.h"
+#include "ObjectPool.h"
 
 TYPE_DEF_BASE(Component);
 
+namespace
+{
+    // Components are deleted along with their actors, which may happen during static destruction (see Actor.cpp).
+    SizedObjectPools& GetComponentPools()
+    {
+        static Leaked<SizedObjectPools> pools("Component");
+        return *pools;
+    }
+}
+
+/*static*/ void* Component::operator new(size_t size)
+{
+    return GetComponentPools().Allocate(size);
+}
+
+/*static*/ void Component::operator delete(void* memory, size_t size)
+{
+    GetComponentPools().Deallocate(memory, size);
+}
+
 Component::Component(Actor* owner) : mOwner(owner)
 {
     
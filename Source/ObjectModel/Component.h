@@ -4,6 +4,8 @@
 // A component is a reusable bit of functionality that can be attached to an Actor.
 //
 #pragma once
+#include <cstddef>
+
 #include "Type.h" // For homebrew RTTI.
 
 class Actor;
@@ -14,6 +16,10 @@ class Component
 public:
     Component(Actor* owner);
 	virtual ~Component() { }
+
+    // Components are allocated from pools (one per size class), rather than scattered around the heap.
+    static void* operator new(size_t size);
+    static void operator delete(void* memory, size_t size);
     
 	void Update(float deltaTime);
     
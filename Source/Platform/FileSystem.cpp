@@ -268,6 +268,54 @@ bool Directory::Create(const std::string& path)
     #endif
 }
 
+bool Directory::GetFiles(const std::string& path, std::vector<std::string>& outFileNames)
+{
+    // An empty path means the current working directory.
+    std::string directoryPath = path.empty() ? "." : path;
+
+    #if defined(PLATFORM_WINDOWS)
+    {
+        // Find all entries in the directory.
+        WIN32_FIND_DATAA findData;
+        HANDLE findHandle = FindFirstFileA(Path::Combine({ directoryPath, "*" }).c_str(), &findData);
+        if(findHandle == INVALID_HANDLE_VALUE) { return false; }
+
+        // Only keep files - skip sub-directories (including "." and "..").
+        do
+        {
+            if((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+            {
+                outFileNames.push_back(findData.cFileName);
+            }
+        } while(FindNextFileA(findHandle, &findData));
+        FindClose(findHandle);
+        return true;
+    }
+    #elif defined(HAVE_DIRENT_H)
+    {
+        DIR* directoryStream = opendir(directoryPath.c_str());
+        if(directoryStream == nullptr) { return false; }
+
+        // Only keep files - skip sub-directories (including "." and "..").
+        // Some file systems don't report entry types, in which case we assume the entry is a file.
+        // Worst case, a directory name is treated as a file and fails to open later on.
+        dirent* entry = nullptr;
+        while((entry = readdir(directoryStream)) != nullptr)
+        {
+            std::string fileName(entry->d_name);
+            if(entry->d_type != DT_DIR && fileName != "." && fileName != "..")
+            {
+                outFileNames.push_back(fileName);
+            }
+        }
+        closedir(directoryStream);
+        return true;
+    }
+    #else
+        #error "No implementation for Directory::GetFiles!"
+    #endif
+}
+
 uint64_t File::Size(const std::string& filePath)
 {
     #if defined(PLATFORM_WINDOWS)
@@ -302,6 +350,36 @@ uint64_t File::Size(const std::string& filePath)
     return 0;
 }
 
+uint64_t File::ModifiedTime(const std::string& filePath)
+{
+    #if defined(PLATFORM_WINDOWS)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA file_attr_data;
+        if(GetFileAttributesEx(filePath.c_str(), GetFileExInfoStandard, &file_attr_data))
+        {
+            ULARGE_INTEGER writeTime = { 0 };
+            writeTime.LowPart = file_attr_data.ftLastWriteTime.dwLowDateTime;
+            writeTime.HighPart = file_attr_data.ftLastWriteTime.dwHighDateTime;
+            return writeTime.QuadPart;
+        }
+    }
+    #elif defined(HAVE_STAT_H)
+    {
+        struct stat stat_buf;
+        int rc = stat(filePath.c_str(), &stat_buf);
+        if(rc == 0)
+        {
+            return static_cast<uint64_t>(stat_buf.st_mtime);
+        }
+    }
+    #else
+        #error "No implementation for File::ModifiedTime!"
+    #endif
+
+    // Failed to get time, so just return 0.
+    return 0;
+}
+
 uint8_t* File::ReadIntoBuffer(const std::string& filePath, uint32_t& outBufferSize)
 {
     // Open the file, or error if failed.
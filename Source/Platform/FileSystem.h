@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include "Platform.h"
 #include "StringTokenizer.h"
@@ -101,6 +102,14 @@ namespace Directory
 		}
 		return true;
 	}
+
+	/**
+	 * Gets the names of all files (not sub-directories) in the directory at path.
+	 * An empty path refers to the current working directory.
+	 *
+	 * Returns false if the directory doesn't exist or couldn't be read.
+	 */
+	bool GetFiles(const std::string& path, std::vector<std::string>& outFileNames);
 }
 
 namespace File
@@ -110,6 +119,13 @@ namespace File
      */
     uint64_t Size(const std::string& filePath);
 
+    /**
+     * Determines when a file was last modified, in platform-specific units.
+     * Only useful for comparing against other values from this function (e.g. to tell whether a file has changed).
+     * Returns 0 if the file doesn't exist.
+     */
+    uint64_t ModifiedTime(const std::string& filePath);
+
     /**
      * Reads file contents into a buffer.
      */
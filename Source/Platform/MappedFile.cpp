@@ -0,0 +1,129 @@
+#include "MappedFile.h"
+
+#include <iostream>
+
+#if defined(PLATFORM_WINDOWS)
+#include <Windows.h>
+#endif
+
+#if defined(HAVE_MMAN_H)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& filePath)
+{
+    Open(filePath);
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string& filePath)
+{
+    // Get rid of any previous mapping first.
+    Close();
+
+    #if defined(PLATFORM_WINDOWS)
+    {
+        // Open the file for reading.
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        // Can't map an empty file.
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // Create a read-only mapping object for the whole file.
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(mapping == nullptr)
+        {
+            std::cout << "Failed to create file mapping for " << filePath << std::endl;
+            CloseHandle(file);
+            return false;
+        }
+
+        // Map a view of the entire file.
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if(view == nullptr)
+        {
+            std::cout << "Failed to map view of " << filePath << std::endl;
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        mFileHandle = file;
+        mMappingHandle = mapping;
+        mData = static_cast<const uint8_t*>(view);
+        mSize = static_cast<uint64_t>(fileSize.QuadPart);
+        return true;
+    }
+    #elif defined(HAVE_MMAN_H)
+    {
+        // Open the file for reading.
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return false;
+        }
+
+        // Can't map an empty file.
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        // Map the whole file read-only.
+        // Once mapped, the file descriptor is no longer needed - the mapping keeps the file alive.
+        void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if(view == MAP_FAILED)
+        {
+            std::cout << "Failed to map " << filePath << std::endl;
+            return false;
+        }
+
+        mData = static_cast<const uint8_t*>(view);
+        mSize = static_cast<uint64_t>(fileStat.st_size);
+        return true;
+    }
+    #else
+        #error "No implementation for MappedFile::Open!"
+    #endif
+}
+
+void MappedFile::Close()
+{
+    if(mData == nullptr) { return; }
+
+    #if defined(PLATFORM_WINDOWS)
+    {
+        UnmapViewOfFile(mData);
+        CloseHandle(mMappingHandle);
+        CloseHandle(mFileHandle);
+        mMappingHandle = nullptr;
+        mFileHandle = nullptr;
+    }
+    #elif defined(HAVE_MMAN_H)
+    {
+        munmap(const_cast<uint8_t*>(mData), static_cast<size_t>(mSize));
+    }
+    #endif
+
+    mData = nullptr;
+    mSize = 0;
+}
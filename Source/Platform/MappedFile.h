@@ -0,0 +1,48 @@
+//
+// Clark Kromenaker
+//
+// A read-only view of a file's contents, mapped into memory by the OS.
+//
+// Rather than reading a file through a stream (one copy into the stream's buffer, another into ours),
+// the OS pages the file in on demand and we read it like any other piece of memory.
+// Since the mapping is read-only, any number of threads can read from it at once without locking.
+//
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Platform.h"
+
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const std::string& filePath);
+    ~MappedFile();
+
+    // Mappings own an OS resource, so no copying allowed.
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map or unmap the file.
+    bool Open(const std::string& filePath);
+    void Close();
+
+    // Returns true if the file is mapped and can be read.
+    bool OK() const { return mData != nullptr; }
+
+    // Access the mapped data.
+    const uint8_t* GetData() const { return mData; }
+    uint64_t GetSize() const { return mSize; }
+
+private:
+    // Start of the mapped region, and its size in bytes.
+    const uint8_t* mData = nullptr;
+    uint64_t mSize = 0;
+
+    #if defined(PLATFORM_WINDOWS)
+    // On Windows, both the file and the mapping object must stay open while the view is in use.
+    void* mFileHandle = nullptr;
+    void* mMappingHandle = nullptr;
+    #endif
+};
@@ -1,5 +1,6 @@
 #include "Frustum.h"
 
+#include "AABB.h"
 #include "Matrix4.h"
 
 Frustum::Frustum(const Matrix4& matrix)
@@ -44,6 +45,26 @@ bool Frustum::ContainsPoint(const Vector3& point) const
         top.GetSignedDistance(point) >= 0.0f;
 }
 
+bool Frustum::IntersectsAABB(const AABB& aabb) const
+{
+    // For each plane, find the AABB corner furthest in the direction of the plane's normal (the "positive vertex").
+    // If even that corner is behind a plane, the whole AABB is outside the frustum.
+    Vector3 min = aabb.GetMin();
+    Vector3 max = aabb.GetMax();
+    const Plane* planes[] = { &near, &far, &left, &right, &bottom, &top };
+    for(const Plane* plane : planes)
+    {
+        Vector3 positiveVertex(plane->normal.x >= 0.0f ? max.x : min.x,
+                               plane->normal.y >= 0.0f ? max.y : min.y,
+                               plane->normal.z >= 0.0f ? max.z : min.z);
+        if(plane->GetSignedDistance(positiveVertex) < 0.0f)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 //TODO: Problem with this code: it gets nearest point to *planes* rather than the actual box of the frustum. Not correct.
 //TODO: Need to research correct algorithm for this.
 /*
@@ -9,6 +9,7 @@
 #pragma once
 #include "Plane.h"
 
+class AABB;
 class Matrix4;
 class Vector3;
 
@@ -19,6 +20,10 @@ public:
     Frustum(const Matrix4& matrix);
 
     bool ContainsPoint(const Vector3& point) const;
+
+    // Returns false if the AABB is definitely outside the frustum, true if it's inside or (likely) intersecting.
+    // The test is conservative: boxes just outside a frustum corner can still return true. That's fine for visibility culling.
+    bool IntersectsAABB(const AABB& aabb) const;
     //Vector3 GetClosestPoint(const Vector3& point) const;
 
     // The frustum just consists of 6 planes forming the bounding area.
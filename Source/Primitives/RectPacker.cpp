@@ -0,0 +1,45 @@
+#include "RectPacker.h"
+
+RectPacker::RectPacker(uint32_t width, uint32_t height) :
+    mWidth(width),
+    mHeight(height)
+{
+
+}
+
+bool RectPacker::Insert(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY)
+{
+    if(width > mWidth || height > mHeight) { return false; }
+
+    // Find the existing shelf that fits this rect with the least wasted height.
+    Shelf* bestShelf = nullptr;
+    for(Shelf& shelf : mShelves)
+    {
+        if(height <= shelf.height && width <= mWidth - shelf.usedWidth)
+        {
+            if(bestShelf == nullptr || shelf.height < bestShelf->height)
+            {
+                bestShelf = &shelf;
+            }
+        }
+    }
+
+    // If no shelf has room, start a new one above the others (if there's room for that).
+    if(bestShelf == nullptr)
+    {
+        if(height > mHeight - mUsedHeight) { return false; }
+
+        Shelf shelf;
+        shelf.y = mUsedHeight;
+        shelf.height = height;
+        mShelves.push_back(shelf);
+        mUsedHeight += height;
+        bestShelf = &mShelves.back();
+    }
+
+    // Place the rect at the end of the shelf.
+    outX = bestShelf->usedWidth;
+    outY = bestShelf->y;
+    bestShelf->usedWidth += width;
+    return true;
+}
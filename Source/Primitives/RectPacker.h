@@ -0,0 +1,45 @@
+//
+// Clark Kromenaker
+//
+// Packs rectangles into a larger fixed-size area, such as a texture atlas.
+//
+// Uses a simple "shelf" approach: rectangles are placed left-to-right in horizontal rows (shelves),
+// and a new shelf is started above the previous one once no existing shelf has room.
+// Packing is tightest when rectangles are inserted tallest first.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+class RectPacker
+{
+public:
+    RectPacker(uint32_t width, uint32_t height);
+
+    // Finds space for a rectangle of the given size, returning the position of its min (lowest x/y) corner.
+    // Returns false if the rectangle doesn't fit anywhere.
+    bool Insert(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY);
+
+    uint32_t GetWidth() const { return mWidth; }
+    uint32_t GetHeight() const { return mHeight; }
+
+    // The height actually covered by shelves so far - an atlas can be trimmed to this height once packing is done.
+    uint32_t GetUsedHeight() const { return mUsedHeight; }
+
+private:
+    // Size of the area being packed.
+    uint32_t mWidth = 0;
+    uint32_t mHeight = 0;
+
+    // A row of rectangles. A shelf's height is set by the first (tallest) rectangle placed on it.
+    struct Shelf
+    {
+        uint32_t y = 0;
+        uint32_t height = 0;
+        uint32_t usedWidth = 0;
+    };
+    std::vector<Shelf> mShelves;
+
+    // Total height of all shelves.
+    uint32_t mUsedHeight = 0;
+};
@@ -1,5 +1,6 @@
 #include "BSP.h"
 
+#include <algorithm>
 #include <bitset>
 #include <iostream>
 
@@ -8,6 +9,7 @@
 #include "BSPActor.h"
 #include "BSPLightmap.h"
 #include "Debug.h"
+#include "Frustum.h"
 #include "ReportManager.h"
 #include "Shader.h"
 #include "StringUtil.h"
@@ -15,7 +17,7 @@
 #include "Vector2.h"
 #include "Vector3.h"
 
-void BSPSurface::Activate(const Material& material)
+void BSPSurfaceBatch::Activate(const Material& material)
 {
     // Activate texture to use for diffuse color.
     if(texture != nullptr)
@@ -28,8 +30,7 @@ void BSPSurface::Activate(const Material& material)
     }
 
     // Activate lightmap texture and multiplier.
-    if((flags & BSPSurface::kIgnoreLightmapFlag) != 0 ||
-       (flags & BSPSurface::kShadowTextureFlag)  != 0)
+    if(!usesLightmap)
     {
         // Some surfaces ignore lightmaps.
         // Just use "plain white" and multiplier of 1 to effectively "do nothing" in lightmap calcs.
@@ -44,20 +45,17 @@ void BSPSurface::Activate(const Material& material)
         {
             lightmapTexture->Activate(1);
         }
+        else
+        {
+            Texture::White.Activate(1);
+        }
         material.GetShader()->SetUniformFloat("uLightmapMultiplier", 2.0f);
     }
-
-    // Lightmap scale/offsets are used in shaders to calculate proper lightmap UVs.
-    Vector4 lightmapUvScaleOffset(lightmapUvScale.x,
-                                  lightmapUvScale.y,
-                                  lightmapUvOffset.x,
-                                  lightmapUvOffset.y);
-    material.GetShader()->SetUniformVector4("uLightmapScaleOffset", lightmapUvScaleOffset);
 }
 
-void BSP::Load(uint8_t* data, uint32_t dataLength)
+void BSP::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 
     // Use lightmap shader for BSP rendering.
     mMaterial.SetShader(gAssetManager.LoadShader("3D-Lightmap"));
@@ -291,7 +289,7 @@ void BSP::SetVisible(const std::string& objectName, bool visible)
 	{
         if(surface.objectIndex == index)
 		{
-            surface.visible = visible;
+            SetSurfaceVisible(&surface, visible);
 		}
 	}
 }
@@ -302,16 +300,28 @@ void BSP::SetTexture(const std::string& objectName, Texture* texture)
     uint32_t index = GetObjectIndex(objectName);
     if(index == UINT32_MAX) { return; }
 	
-	// All surfaces belonging to this object will be hidden.
-	for(auto& surface : mSurfaces)
+	// All surfaces belonging to this object will use the new texture.
+	for(uint32_t i = 0; i < mSurfaces.size(); ++i)
 	{
-        if(surface.objectIndex == index)
+        if(mSurfaces[i].objectIndex == index && mSurfaces[i].texture != texture)
 		{
-            surface.texture = texture;
+            // The surface now belongs in a different batch.
+            RemoveSurfaceFromBatch(i);
+            mSurfaces[i].texture = texture;
+            AddSurfaceToBatch(i);
 		}
 	}
 }
 
+void BSP::SetSurfaceVisible(BSPSurface* surface, bool visible)
+{
+    if(surface->visible != visible)
+    {
+        surface->visible = visible;
+        mBatches[surface->batchIndex].drawRangesDirty = true;
+    }
+}
+
 bool BSP::Exists(const std::string& objectName) const
 {
     return GetObjectIndex(objectName) != UINT32_MAX;
@@ -374,23 +384,48 @@ Vector3 BSP::GetPosition(const std::string& objectName) const
 
 void BSP::ApplyLightmap(const BSPLightmap& lightmap)
 {
-    // Apply lightmap textures to each surface.
+    // The lightmap's textures are packed into atlases. Each surface uses an atlas, with lightmap UVs moved into its part of the atlas.
+    // Starting from the BSP file's offset/scale (rather than the current one) means applying a different lightmap later works too.
     const std::vector<Texture*>& lightmapTextures = lightmap.GetLightmapTextures();
-    for(size_t i = 0; i < mSurfaces.size(); ++i)
+    const std::vector<Texture*>& atlasTextures = lightmap.GetAtlasTextures();
+    const std::vector<BSPLightmap::AtlasEntry>& atlasEntries = lightmap.GetAtlasEntries();
+    for(size_t i = 0; i < mSurfaces.size() && i < atlasEntries.size(); ++i)
     {
-        mSurfaces[i].lightmapTexture = lightmapTextures[i];
+        BSPSurface& surface = mSurfaces[i];
+        const BSPLightmap::AtlasEntry& entry = atlasEntries[i];
+        surface.lightmapTexture = atlasTextures[entry.atlasIndex];
+
+        // Baked UVs are (uv + offset) * scale. In atlas space, that's further scaled and offset by the entry's rect.
+        // (uv + offset) * scale * entryScale + entryOffset == (uv + offset + entryOffset / (scale * entryScale)) * (scale * entryScale)
+        surface.lightmapUvScale = Vector2(surface.fileLightmapUvScale.x * entry.uvScale.x,
+                                          surface.fileLightmapUvScale.y * entry.uvScale.y);
+        surface.lightmapUvOffset = surface.fileLightmapUvOffset;
+        if(surface.lightmapUvScale.x != 0.0f)
+        {
+            surface.lightmapUvOffset.x += entry.uvOffset.x / surface.lightmapUvScale.x;
+        }
+        if(surface.lightmapUvScale.y != 0.0f)
+        {
+            surface.lightmapUvOffset.y += entry.uvOffset.y / surface.lightmapUvScale.y;
+        }
     }
 
+    // Lightmap UVs changed, and surfaces are batched by lightmap, so UVs must be re-baked and batches rebuilt.
+    BakeLightmapUVs();
+    RebuildBatches();
+
     // Update light colors now that lightmap textures are populated.
+    // This uses the surface's own lightmap texture, rather than the atlas.
     for(auto& light : mLights)
     {
-        if(mSurfaces[light.surfaceIndex].lightmapTexture != nullptr)
+        Texture* lightmapTexture = light.surfaceIndex < lightmapTextures.size() ? lightmapTextures[light.surfaceIndex] : nullptr;
+        if(lightmapTexture != nullptr)
         {
-            int width = mSurfaces[light.surfaceIndex].lightmapTexture->GetWidth();
-            int height = mSurfaces[light.surfaceIndex].lightmapTexture->GetHeight();
+            int width = lightmapTexture->GetWidth();
+            int height = lightmapTexture->GetHeight();
 
             // Use a single center point to calculate the color?
-            //light.color = mSurfaces[light.surfaceIndex].lightmapTexture->GetPixelColor32(width / 2, height / 2);
+            //light.color = lightmapTexture->GetPixelColor32(width / 2, height / 2);
 
             // Or sum and average all pixels in the lightmap?
             Vector3 sums;
@@ -398,7 +433,7 @@ void BSP::ApplyLightmap(const BSPLightmap& lightmap)
             {
                 for(int j = 0; j < height; ++j)
                 {
-                    Color32 color = mSurfaces[light.surfaceIndex].lightmapTexture->GetPixelColor32(i, j);
+                    Color32 color = lightmapTexture->GetPixelColor32(i, j);
                     sums.x += color.GetR();
                     sums.y += color.GetG();
                     sums.z += color.GetB();
@@ -465,49 +500,85 @@ Color32 BSP::CalculateAmbientLightColor(const Vector3& position)
     */
 }
 
+#if defined(USE_TRUE_BSP_RENDERING)
 // For debugging BSP issues, helpful to track polygons rendered and tree depth.
 namespace
 {
     int renderedPolygonCount = 0;
     int treeDepth = 0;
 }
+#endif
+
+void BSP::UpdateVisibility(const Frustum* frustum)
+{
+    mCullingStats = BSPCullingStats();
+
+    // First, cull entire objects. This avoids testing each surface of objects that are out of view.
+    for(size_t i = 0; i < mObjectAABBs.size(); ++i)
+    {
+        bool inView = true;
+        if(frustum != nullptr && mObjectAABBs[i].IsValid())
+        {
+            inView = frustum->IntersectsAABB(mObjectAABBs[i]);
+            ++mCullingStats.objectsTested;
+            if(!inView)
+            {
+                ++mCullingStats.objectsCulled;
+            }
+        }
+        mObjectsInView[i] = inView;
+    }
+
+    // Then, cull surfaces of objects that are in view.
+    for(BSPSurface& surface : mSurfaces)
+    {
+        // No need to test surfaces that won't be rendered anyway.
+        if(!surface.visible || surface.indexCount == 0) { continue; }
+
+        bool inView = true;
+        if(frustum != nullptr)
+        {
+            ++mCullingStats.surfacesTested;
+            bool objectInView = surface.objectIndex >= mObjectsInView.size() || mObjectsInView[surface.objectIndex];
+            inView = objectInView && frustum->IntersectsAABB(surface.aabb);
+            if(!inView)
+            {
+                ++mCullingStats.surfacesCulled;
+            }
+        }
+
+        // Draw ranges only need rebuilding when a surface enters or leaves the view. For a still camera, that's never.
+        if(surface.inView != inView)
+        {
+            surface.inView = inView;
+            if(surface.batchIndex < mBatches.size())
+            {
+                mBatches[surface.batchIndex].drawRangesDirty = true;
+            }
+        }
+    }
+}
 
 void BSP::RenderOpaque(const Vector3& cameraPosition, const Vector3& cameraDirection)
 {
     // Activate material for rendering.
     mMaterial.Activate(Matrix4::Identity);
 
+    #if defined(USE_TRUE_BSP_RENDERING)
     // Reset render stat values.
     renderedPolygonCount = 0;
     treeDepth = 0;
 
-    #if defined(USE_TRUE_BSP_RENDERING)
     // NORMAL BSP RENDERING
     // Process the tree and nodes to only render what's in front of the camera.
     // Seems like it'd be quite efficient...BUT modern graphics hardware is actually quite bad at this, due to the number of draw calls!
     RenderTree(mNodes[mRootNodeIndex], cameraPosition, cameraDirection);
     #else
     // ALTERNATIVE BSP RENDERING
-    // Just render every surface lol.
-    // Surprisingly more efficient than "correct" BSP rendering, since it's fewer draw calls.
-    for(auto& surface : mSurfaces)
-    {
-        if(!surface.visible) { continue; }
-        if(surface.IsTranslucent()) { continue; }
-
-        // Activate
-        surface.Activate(mMaterial);
-
-        // Draw
-        for(auto& polygon : surface.polygons)
-        {
-            mVertexArray.DrawTriangleFans(polygon.vertexIndexOffset, polygon.vertexIndexCount);
-            renderedPolygonCount++;
-        }
-    }
+    // Just render every surface, one draw call per batch of surfaces that share a texture/lightmap.
+    // Surprisingly more efficient than "correct" BSP rendering, since it's far fewer draw calls.
+    RenderBatches(false);
     #endif
-    
-    //std::cout << "Rendered " << renderedPolygonCount << " polygons." << std::endl;
 }
 
 void BSP::RenderTranslucent()
@@ -524,20 +595,7 @@ void BSP::RenderTranslucent()
     }
     mAlphaPolygons = nullptr;
     #else
-    for(auto& surface : mSurfaces)
-    {
-        if(!surface.visible) { continue; }
-        if(!surface.IsTranslucent()) { continue; }
-
-        // Activate
-        surface.Activate(mMaterial);
-
-        // Draw
-        for(auto& polygon : surface.polygons)
-        {
-            mVertexArray.DrawTriangleFans(polygon.vertexIndexOffset, polygon.vertexIndexCount);
-        }
-    }
+    RenderBatches(true);
     #endif
 }
 
@@ -554,7 +612,7 @@ uint32_t BSP::GetObjectIndex(const std::string& objectName) const
     return UINT32_MAX;
 }
 
-void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
+void BSP::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     BinaryReader reader(data, dataLength);
     
@@ -604,8 +662,10 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
 
         surface.texture = gAssetManager.LoadSceneTexture(reader.ReadString(32), GetScope());
         
-        surface.lightmapUvOffset = reader.ReadVector2();
-        surface.lightmapUvScale = reader.ReadVector2();
+        surface.fileLightmapUvOffset = reader.ReadVector2();
+        surface.fileLightmapUvScale = reader.ReadVector2();
+        surface.lightmapUvOffset = surface.fileLightmapUvOffset;
+        surface.lightmapUvScale = surface.fileLightmapUvScale;
         
         reader.ReadFloat(); // Unknown - I had assumed this was a scale earlier, but I'm not sure.
         
@@ -654,12 +714,6 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
         
         polygon.vertexIndexCount = reader.ReadUShort();
         polygon.surfaceIndex = reader.ReadUShort();
-
-        // With "true" BSP rendering, maintaining a list of polygons for a surface is not needed.
-        // But otherwise, it's handy to have.
-        #if !defined(USE_TRUE_BSP_RENDERING)
-        mSurfaces[polygon.surfaceIndex].polygons.push_back(polygon);
-        #endif
     }
     
     // Iterate and read planes.
@@ -744,20 +798,234 @@ void BSP::ParseFromData(uint8_t* data, uint32_t dataLength)
         }
     }
 
+    // Convert to render-friendly geometry and group surfaces into batches.
+    BuildRenderData();
+    RebuildBatches();
+
     // Generate mesh definition.
-    MeshDefinition meshDefinition(MeshUsage::Static, mVertices.size());
+    MeshDefinition meshDefinition(MeshUsage::Static, mRenderPositions.size());
     meshDefinition.SetVertexLayout(VertexLayout::Packed);
 
-    meshDefinition.AddVertexData(VertexAttribute::Position, &mVertices[0]);
-    meshDefinition.AddVertexData(VertexAttribute::UV1, &mUVs[0]);
+    meshDefinition.AddVertexData(VertexAttribute::Position, mRenderPositions.data());
+    meshDefinition.AddVertexData(VertexAttribute::UV1, mRenderUV1s.data());
+    meshDefinition.AddVertexData(VertexAttribute::UV2, mRenderUV2s.data());
 
-    meshDefinition.SetIndexData(mVertexIndices.size(), &mVertexIndices[0]);
+    meshDefinition.SetIndexData(mRenderIndices.size(), mRenderIndices.data());
     meshDefinition.ownsData = false;
     
     // Create vertex array.
     mVertexArray = VertexArray(meshDefinition);
 }
 
+void BSP::BuildRenderData()
+{
+    // Gather the polygons belonging to each surface.
+    std::vector<std::vector<uint32_t>> surfacePolygons(mSurfaces.size());
+    for(uint32_t i = 0; i < mPolygons.size(); ++i)
+    {
+        surfacePolygons[mPolygons[i].surfaceIndex].push_back(i);
+    }
+
+    // BSP vertices are shared between surfaces, but lightmap UVs depend on the surface.
+    // So, each surface gets its own copy of the vertices it uses. Track which surface last copied each vertex, and the index of the copy.
+    std::vector<uint32_t> copiedForSurface(mVertices.size(), UINT32_MAX);
+    std::vector<uint32_t> copyIndexes(mVertices.size(), 0);
+    for(uint32_t surfaceIndex = 0; surfaceIndex < mSurfaces.size(); ++surfaceIndex)
+    {
+        BSPSurface& surface = mSurfaces[surfaceIndex];
+        surface.vertexOffset = static_cast<uint32_t>(mRenderPositions.size());
+        surface.indexOffset = static_cast<uint32_t>(mRenderIndices.size());
+        for(uint32_t polygonIndex : surfacePolygons[surfaceIndex])
+        {
+            BSPPolygon& polygon = mPolygons[polygonIndex];
+            polygon.triangleIndexOffset = static_cast<uint32_t>(mRenderIndices.size()) - surface.indexOffset;
+
+            // Polygons are triangle fans: each triangle is the first vertex, plus two consecutive vertices after it.
+            for(uint32_t i = 2; i < polygon.vertexIndexCount; ++i)
+            {
+                const uint32_t fanIndexes[3] = { polygon.vertexIndexOffset, polygon.vertexIndexOffset + i - 1, polygon.vertexIndexOffset + i };
+                for(uint32_t fanIndex : fanIndexes)
+                {
+                    uint16_t vertexIndex = mVertexIndices[fanIndex];
+                    if(copiedForSurface[vertexIndex] != surfaceIndex)
+                    {
+                        copiedForSurface[vertexIndex] = surfaceIndex;
+                        copyIndexes[vertexIndex] = static_cast<uint32_t>(mRenderPositions.size());
+                        mRenderPositions.push_back(mVertices[vertexIndex]);
+                        mRenderUV1s.push_back(vertexIndex < mUVs.size() ? mUVs[vertexIndex] : Vector2::Zero);
+                    }
+                    mRenderIndices.push_back(copyIndexes[vertexIndex]);
+                }
+            }
+        }
+        surface.vertexCount = static_cast<uint32_t>(mRenderPositions.size()) - surface.vertexOffset;
+        surface.indexCount = static_cast<uint32_t>(mRenderIndices.size()) - surface.indexOffset;
+    }
+    BakeLightmapUVs();
+
+    // Calculate bounds of each surface, and each object (from its surfaces), for visibility culling.
+    mObjectAABBs.assign(mObjectNames.size(), AABB(Vector3(FLT_MAX, FLT_MAX, FLT_MAX), Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX)));
+    mObjectsInView.assign(mObjectNames.size(), true);
+    for(BSPSurface& surface : mSurfaces)
+    {
+        if(surface.vertexCount == 0) { continue; }
+        surface.aabb = AABB(mRenderPositions[surface.vertexOffset], mRenderPositions[surface.vertexOffset]);
+        for(uint32_t i = surface.vertexOffset + 1; i < surface.vertexOffset + surface.vertexCount; ++i)
+        {
+            surface.aabb.GrowToContain(mRenderPositions[i]);
+        }
+        if(surface.objectIndex < mObjectAABBs.size())
+        {
+            mObjectAABBs[surface.objectIndex].GrowToContain(surface.aabb.GetMin());
+            mObjectAABBs[surface.objectIndex].GrowToContain(surface.aabb.GetMax());
+        }
+    }
+}
+
+void BSP::BakeLightmapUVs()
+{
+    // Lightmap UVs are calculated from the texture UVs, using the surface's lightmap offset/scale.
+    std::vector<Vector2> lightmapUVs(mRenderUV1s.size());
+    for(const BSPSurface& surface : mSurfaces)
+    {
+        for(uint32_t i = surface.vertexOffset; i < surface.vertexOffset + surface.vertexCount; ++i)
+        {
+            lightmapUVs[i] = Vector2((mRenderUV1s[i].x + surface.lightmapUvOffset.x) * surface.lightmapUvScale.x,
+                                     (mRenderUV1s[i].y + surface.lightmapUvOffset.y) * surface.lightmapUvScale.y);
+        }
+    }
+
+    // Once the vertex array exists, it refers to (and updates) mRenderUV2s.
+    if(mVertexArray.GetVertexCount() > 0)
+    {
+        mVertexArray.ChangeVertexData(VertexAttribute::Semantic::UV2, lightmapUVs.data());
+    }
+    else
+    {
+        mRenderUV2s.swap(lightmapUVs);
+    }
+}
+
+void BSP::RebuildBatches()
+{
+    mBatches.clear();
+    for(uint32_t i = 0; i < mSurfaces.size(); ++i)
+    {
+        AddSurfaceToBatch(i);
+    }
+
+    // Reorder render indexes so each batch's surfaces are next to each other. Then each batch is (usually) drawn as a single range.
+    std::vector<uint32_t> indexes;
+    indexes.reserve(mRenderIndices.size());
+    std::vector<uint32_t> newIndexOffsets(mSurfaces.size());
+    for(BSPSurfaceBatch& batch : mBatches)
+    {
+        for(uint32_t surfaceIndex : batch.surfaceIndexes)
+        {
+            BSPSurface& surface = mSurfaces[surfaceIndex];
+            newIndexOffsets[surfaceIndex] = static_cast<uint32_t>(indexes.size());
+            indexes.insert(indexes.end(), mRenderIndices.begin() + surface.indexOffset, mRenderIndices.begin() + surface.indexOffset + surface.indexCount);
+        }
+    }
+    for(uint32_t i = 0; i < mSurfaces.size(); ++i)
+    {
+        mSurfaces[i].indexOffset = newIndexOffsets[i];
+    }
+
+    // Once the vertex array exists, it refers to (and updates) mRenderIndices.
+    if(mVertexArray.GetIndexCount() > 0)
+    {
+        mVertexArray.ChangeIndexData(indexes.data(), static_cast<uint32_t>(indexes.size()));
+    }
+    else
+    {
+        mRenderIndices.swap(indexes);
+    }
+}
+
+void BSP::AddSurfaceToBatch(uint32_t surfaceIndex)
+{
+    BSPSurface& surface = mSurfaces[surfaceIndex];
+    Texture* lightmapTexture = surface.UsesLightmap() ? surface.lightmapTexture : nullptr;
+
+    // Find a batch with matching render state, or create one.
+    uint32_t batchIndex = 0;
+    for(; batchIndex < mBatches.size(); ++batchIndex)
+    {
+        const BSPSurfaceBatch& batch = mBatches[batchIndex];
+        if(batch.texture == surface.texture && batch.lightmapTexture == lightmapTexture &&
+           batch.usesLightmap == surface.UsesLightmap() && batch.translucent == surface.IsTranslucent())
+        {
+            break;
+        }
+    }
+    if(batchIndex == mBatches.size())
+    {
+        mBatches.emplace_back();
+        mBatches.back().texture = surface.texture;
+        mBatches.back().lightmapTexture = lightmapTexture;
+        mBatches.back().usesLightmap = surface.UsesLightmap();
+        mBatches.back().translucent = surface.IsTranslucent();
+    }
+
+    // Keep the batch's surfaces in index buffer order, so adjacent ranges can be merged.
+    BSPSurfaceBatch& batch = mBatches[batchIndex];
+    auto it = std::lower_bound(batch.surfaceIndexes.begin(), batch.surfaceIndexes.end(), surface.indexOffset, [this](uint32_t index, uint32_t indexOffset) {
+        return mSurfaces[index].indexOffset < indexOffset;
+    });
+    batch.surfaceIndexes.insert(it, surfaceIndex);
+    batch.drawRangesDirty = true;
+    surface.batchIndex = batchIndex;
+}
+
+void BSP::RemoveSurfaceFromBatch(uint32_t surfaceIndex)
+{
+    BSPSurfaceBatch& batch = mBatches[mSurfaces[surfaceIndex].batchIndex];
+    auto it = std::find(batch.surfaceIndexes.begin(), batch.surfaceIndexes.end(), surfaceIndex);
+    if(it != batch.surfaceIndexes.end())
+    {
+        batch.surfaceIndexes.erase(it);
+        batch.drawRangesDirty = true;
+    }
+}
+
+void BSP::RenderBatches(bool translucent)
+{
+    for(BSPSurfaceBatch& batch : mBatches)
+    {
+        if(batch.translucent != translucent) { continue; }
+
+        // Rebuild draw ranges from visible surfaces if anything changed.
+        if(batch.drawRangesDirty)
+        {
+            batch.drawOffsets.clear();
+            batch.drawCounts.clear();
+            for(uint32_t surfaceIndex : batch.surfaceIndexes)
+            {
+                const BSPSurface& surface = mSurfaces[surfaceIndex];
+                if(!surface.visible || !surface.inView || surface.indexCount == 0) { continue; }
+
+                // Extend the previous range if this surface directly follows it.
+                if(!batch.drawOffsets.empty() && batch.drawOffsets.back() + batch.drawCounts.back() == surface.indexOffset)
+                {
+                    batch.drawCounts.back() += surface.indexCount;
+                }
+                else
+                {
+                    batch.drawOffsets.push_back(surface.indexOffset);
+                    batch.drawCounts.push_back(surface.indexCount);
+                }
+            }
+            batch.drawRangesDirty = false;
+        }
+        if(batch.drawOffsets.empty()) { continue; }
+
+        // Draw all visible surfaces in the batch at once.
+        batch.Activate(mMaterial);
+        mVertexArray.DrawMulti(GAPI::Primitive::Triangles, batch.drawOffsets.data(), batch.drawCounts.data(), static_cast<uint32_t>(batch.drawOffsets.size()));
+    }
+}
+
 #if defined(USE_TRUE_BSP_RENDERING)
 void BSP::RenderTree(const BSPNode& node, const Vector3& cameraPosition, const Vector3& cameraDirection)
 {
@@ -855,11 +1123,11 @@ void BSP::RenderPolygon(BSPPolygon& polygon, bool translucent)
     // If we have a valid surface reference, use it to get rendering configured.
     BSPSurface& surface = mSurfaces[polygon.surfaceIndex];
 
-    // Not going to render non-visible surfaces.
-    if(!surface.visible) { return; }
+    // Not going to render non-visible surfaces (or surfaces outside the camera's view).
+    if(!surface.visible || !surface.inView) { return; }
 
     // Activate
-    surface.Activate(mMaterial);
+    mBatches[surface.batchIndex].Activate(mMaterial);
 
     // If has alpha, don't render it now, but add it to the alpha chain.
     if(surface.texture != nullptr)
@@ -873,7 +1141,10 @@ void BSP::RenderPolygon(BSPPolygon& polygon, bool translucent)
     }
 
     // Draw the polygon.
-    mVertexArray.DrawTriangleFans(polygon.vertexIndexOffset, polygon.vertexIndexCount);
+    if(polygon.vertexIndexCount >= 3)
+    {
+        mVertexArray.DrawTriangles(surface.indexOffset + polygon.triangleIndexOffset, (polygon.vertexIndexCount - 2) * 3);
+    }
     ++renderedPolygonCount;
 }
 #endif
\ No newline at end of file
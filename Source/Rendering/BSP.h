@@ -10,6 +10,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "AABB.h"
 #include "Material.h"
 #include "Mesh.h"
 #include "Plane.h"
@@ -20,6 +21,7 @@
 
 class BSPActor;
 class BSPLightmap;
+class Frustum;
 class Texture;
 
 // If desired, it's possible to render using BSP tree visibility algorithm.
@@ -61,6 +63,10 @@ struct BSPPolygon
     // These are an offset + count into the index array, defining what vertices make up this polygon.
     uint16_t vertexIndexOffset = 0;
     uint16_t vertexIndexCount = 0;
+
+    // For rendering, polygons are converted to triangle lists.
+    // This is the offset of this polygon's triangle indexes, relative to its surface's range in the render index buffer.
+    uint32_t triangleIndexOffset = 0;
 	
 	// Used for creating a linked list of alpha surfaces.
     BSPPolygon* next = nullptr;
@@ -78,13 +84,18 @@ struct BSPSurface
     Texture* texture = nullptr;
     
     // An optional lightmap texture - applied from a lightmap asset.
-    //TODO: this works OK, but it'd be more efficient to use a lightmap atlas instead of many individual textures.
+    // This is a lightmap atlas, shared by many surfaces.
     Texture* lightmapTexture = nullptr;
     
     // UVs used for the lightmap are often different from the UVs used for diffuse textures.
     // The surface defines offset/scale to apply to each UV to properly render a lightmap on that surface.
+    // Once a lightmap is applied, these map into the surface's area of the lightmap atlas.
     Vector2 lightmapUvOffset;
     Vector2 lightmapUvScale;
+
+    // The offset/scale as defined in the BSP file, for the surface's own (non-atlas) lightmap texture.
+    Vector2 fileLightmapUvOffset;
+    Vector2 fileLightmapUvScale;
     
     // Flags defining surface properties.
     uint32_t flags = 0;
@@ -102,12 +113,27 @@ struct BSPSurface
 	// If true, interactive (can be hit by raycasts).
 	bool interactive = true;
 
-    // If not using true BSP rendering, it's efficient to store the polygons directly in the surface.
-    #if !defined(USE_TRUE_BSP_RENDERING)
-    std::vector<BSPPolygon> polygons;
-    #endif
+    // World space bounds of the surface's geometry, used for visibility culling.
+    AABB aabb;
 
-    void Activate(const Material& material);
+    // If false, the surface is outside the camera's view this frame, so it isn't rendered.
+    bool inView = true;
+
+    // Range of this surface's vertices in the render vertex buffer.
+    uint32_t vertexOffset = 0;
+    uint32_t vertexCount = 0;
+
+    // Range of this surface's triangles in the render index buffer.
+    uint32_t indexOffset = 0;
+    uint32_t indexCount = 0;
+
+    // The batch this surface is rendered with.
+    uint32_t batchIndex = 0;
+
+    bool UsesLightmap() const
+    {
+        return (flags & kIgnoreLightmapFlag) == 0 && (flags & kShadowTextureFlag) == 0;
+    }
 
     bool IsTranslucent() const
     {
@@ -115,6 +141,28 @@ struct BSPSurface
     }
 };
 
+// Surfaces that share a texture and lightmap are drawn together, as a batch.
+// A batch draws all its visible surfaces' index ranges with a single (multi-)draw call.
+struct BSPSurfaceBatch
+{
+    // Render state shared by all surfaces in the batch.
+    Texture* texture = nullptr;
+    Texture* lightmapTexture = nullptr;
+    bool usesLightmap = true;
+    bool translucent = false;
+
+    // Surfaces in this batch, ordered by position in the render index buffer.
+    std::vector<uint32_t> surfaceIndexes;
+
+    // Index ranges to draw. Adjacent visible surfaces are merged into a single range.
+    // These are rebuilt when surfaces are added/removed or change visibility.
+    std::vector<uint32_t> drawOffsets;
+    std::vector<uint32_t> drawCounts;
+    bool drawRangesDirty = true;
+
+    void Activate(const Material& material);
+};
+
 // Represents an amount of ambient light emitted from a BSP surface.
 // As dynamic models navigate the scene, they can query the BSP to calculate an approximate "ambient color" at the current position.
 struct BSPAmbientLight
@@ -130,11 +178,20 @@ struct BSPAmbientLight
     Color32 color;
 };
 
+// Counts from the last visibility update, useful for tuning culling.
+struct BSPCullingStats
+{
+    uint32_t objectsTested = 0;
+    uint32_t objectsCulled = 0;
+    uint32_t surfacesTested = 0;
+    uint32_t surfacesCulled = 0; // includes surfaces culled b/c their object was culled
+};
+
 class BSP : public Asset
 {
 public:
     BSP(const std::string& name, AssetScope scope) : Asset(name, scope) { }
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
     
     // Raycasting
     bool RaycastNearest(const Ray& ray, RaycastHit& outHitInfo);
@@ -150,6 +207,7 @@ public:
     BSPActor* CreateBSPActor(const std::string& objectName);
 	void SetVisible(const std::string& objectName, bool visible);
 	void SetTexture(const std::string& objectName, Texture* texture);
+    void SetSurfaceVisible(BSPSurface* surface, bool visible);
 
     // Object Queries
 	bool Exists(const std::string& objectName) const;
@@ -161,6 +219,11 @@ public:
     void DebugDrawAmbientLights(const Vector3& position);
     Color32 CalculateAmbientLightColor(const Vector3& position);
 
+    // Visibility
+    // Culls surfaces outside the frustum, so they aren't rendered. Passing null marks all surfaces as in view.
+    void UpdateVisibility(const Frustum* frustum);
+    const BSPCullingStats& GetCullingStats() const { return mCullingStats; }
+
     // Rendering
     void RenderOpaque(const Vector3& cameraPosition, const Vector3& cameraDirection);
     void RenderTranslucent();
@@ -199,9 +262,25 @@ private:
     
     // Vertex indices for BSP mesh.
     std::vector<unsigned short> mVertexIndices;
+
+    // Rendering uses a separate copy of the geometry: each surface has its own vertices (with baked lightmap UVs),
+    // and polygons are split into triangles, with each batch's triangles next to each other in the index buffer.
+    // Copying vertices per surface means big scenes can have more than 65536 render vertices, so indexes are 32-bit.
+    std::vector<Vector3> mRenderPositions;
+    std::vector<Vector2> mRenderUV1s;
+    std::vector<Vector2> mRenderUV2s;
+    std::vector<uint32_t> mRenderIndices;
     
-    // Vertex array is loaded up with vertices/uvs/indices to perform rendering.
+    // Vertex array is loaded up with render vertices/uvs/indices to perform rendering.
     VertexArray mVertexArray;
+
+    // Surfaces grouped by shared render state.
+    std::vector<BSPSurfaceBatch> mBatches;
+
+    // World space bounds of each object's surfaces. An object outside the view means all its surfaces are too.
+    std::vector<AABB> mObjectAABBs;
+    std::vector<bool> mObjectsInView;
+    BSPCullingStats mCullingStats;
     
     // Material for rendering BSP.
 	Material mMaterial;
@@ -215,7 +294,15 @@ private:
 
     uint32_t GetObjectIndex(const std::string& objectName) const;
     
-    void ParseFromData(uint8_t* data, uint32_t dataLength);
+    void ParseFromData(const uint8_t* data, uint32_t dataLength);
+
+    // Batching
+    void BuildRenderData();
+    void BakeLightmapUVs();
+    void RebuildBatches();
+    void AddSurfaceToBatch(uint32_t surfaceIndex);
+    void RemoveSurfaceFromBatch(uint32_t surfaceIndex);
+    void RenderBatches(bool translucent);
 
     #if defined(USE_TRUE_BSP_RENDERING)
     void RenderTree(const BSPNode& node, const Vector3& cameraPosition, const Vector3& cameraDirection);
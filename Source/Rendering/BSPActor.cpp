@@ -12,7 +12,7 @@ void BSPActor::SetVisible(bool visible)
 {
 	for(auto& surface : mSurfaces)
 	{
-		surface->visible = visible;
+		mBSP->SetSurfaceVisible(surface, visible);
 	}
 }
 
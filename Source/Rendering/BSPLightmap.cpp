@@ -1,8 +1,22 @@
 #include "BSPLightmap.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "BinaryReader.h"
+#include "RectPacker.h"
 #include "Texture.h"
 
+namespace
+{
+    // Size of each atlas texture. Lightmaps are small, so one or two atlases usually hold a whole scene's lightmaps.
+    const uint32_t kAtlasSize = 1024;
+
+    // Each lightmap is surrounded by a border of duplicated edge pixels in the atlas.
+    // This keeps bilinear filtering at a lightmap's edge from blending in pixels from neighboring lightmaps.
+    const uint32_t kAtlasPadding = 1;
+}
+
 BSPLightmap::~BSPLightmap()
 {
     // This class owns the textures created in the constructor, so we must delete them.
@@ -10,11 +24,15 @@ BSPLightmap::~BSPLightmap()
     {
         delete texture;
     }
+    for(auto& texture : mAtlasTextures)
+    {
+        delete texture;
+    }
 }
 
-void BSPLightmap::Load(uint8_t* data, uint32_t dataLength)
+void BSPLightmap::Load(const AssetBuffer& data)
 {
-    BinaryReader reader(data, dataLength);
+    BinaryReader reader(data.GetData(), data.GetSize());
 
     // 4 bytes: file identifier "TULM" (MULT backwards).
     std::string identifier = reader.ReadString(4);
@@ -39,6 +57,9 @@ void BSPLightmap::Load(uint8_t* data, uint32_t dataLength)
         mLightmapTextures.push_back(texture);
     }
 
+    // Pack the lightmaps into atlases, which are what's actually used for rendering.
+    BuildAtlases();
+
     /*
     // Write out for debugging...
     for(int i = 0; i < mLightmapTextures.size(); i++)
@@ -48,3 +69,87 @@ void BSPLightmap::Load(uint8_t* data, uint32_t dataLength)
     */
 }
 
+
+void BSPLightmap::BuildAtlases()
+{
+    // The rect packer works best when the tallest rects are packed first.
+    std::vector<uint32_t> packOrder(mLightmapTextures.size());
+    for(uint32_t i = 0; i < packOrder.size(); ++i)
+    {
+        packOrder[i] = i;
+    }
+    std::stable_sort(packOrder.begin(), packOrder.end(), [this](uint32_t a, uint32_t b) {
+        return mLightmapTextures[a]->GetHeight() > mLightmapTextures[b]->GetHeight();
+    });
+
+    // Find a spot for each lightmap (plus padding), starting a new atlas when the existing ones are full.
+    std::vector<RectPacker> packers;
+    std::vector<uint32_t> packedX(mLightmapTextures.size(), 0);
+    std::vector<uint32_t> packedY(mLightmapTextures.size(), 0);
+    mAtlasEntries.resize(mLightmapTextures.size());
+    for(uint32_t index : packOrder)
+    {
+        uint32_t width = mLightmapTextures[index]->GetWidth() + kAtlasPadding * 2;
+        uint32_t height = mLightmapTextures[index]->GetHeight() + kAtlasPadding * 2;
+
+        bool packed = false;
+        for(uint32_t i = 0; i < packers.size() && !packed; ++i)
+        {
+            packed = packers[i].Insert(width, height, packedX[index], packedY[index]);
+            if(packed)
+            {
+                mAtlasEntries[index].atlasIndex = i;
+            }
+        }
+        if(!packed)
+        {
+            // An unusually big lightmap gets an atlas big enough to hold it.
+            packers.emplace_back(std::max(kAtlasSize, width), std::max(kAtlasSize, height));
+            packers.back().Insert(width, height, packedX[index], packedY[index]);
+            mAtlasEntries[index].atlasIndex = static_cast<uint32_t>(packers.size() - 1);
+        }
+    }
+
+    // Create the atlas textures. Most atlases aren't completely full, so trim off any unused height.
+    for(RectPacker& packer : packers)
+    {
+        Texture* atlas = new Texture(packer.GetWidth(), std::max(packer.GetUsedHeight(), 1U), Color32::Black);
+        atlas->SetFilterMode(Texture::FilterMode::Bilinear);
+        atlas->SetWrapMode(Texture::WrapMode::Clamp);
+        mAtlasTextures.push_back(atlas);
+    }
+
+    // Copy each lightmap into its spot in an atlas.
+    for(uint32_t i = 0; i < mLightmapTextures.size(); ++i)
+    {
+        Texture* lightmap = mLightmapTextures[i];
+        Texture* atlas = mAtlasTextures[mAtlasEntries[i].atlasIndex];
+        uint32_t width = lightmap->GetWidth();
+        uint32_t height = lightmap->GetHeight();
+        uint32_t atlasWidth = atlas->GetWidth();
+        uint32_t atlasHeight = atlas->GetHeight();
+
+        // Record where the lightmap is (not counting padding) in normalized atlas coordinates.
+        mAtlasEntries[i].uvOffset = Vector2(static_cast<float>(packedX[i] + kAtlasPadding) / atlasWidth,
+                                            static_cast<float>(packedY[i] + kAtlasPadding) / atlasHeight);
+        mAtlasEntries[i].uvScale = Vector2(static_cast<float>(width) / atlasWidth,
+                                           static_cast<float>(height) / atlasHeight);
+        if(width == 0 || height == 0) { continue; }
+
+        // Copy row by row. Padding rows/columns repeat the nearest edge pixel of the lightmap.
+        const uint8_t* source = lightmap->GetPixelData();
+        uint8_t* dest = atlas->GetPixelData();
+        for(uint32_t y = 0; y < height + kAtlasPadding * 2; ++y)
+        {
+            uint32_t sourceY = std::min(y > kAtlasPadding ? y - kAtlasPadding : 0, height - 1);
+            const uint8_t* sourceRow = source + sourceY * width * 4;
+            uint8_t* destRow = dest + ((packedY[i] + y) * atlasWidth + packedX[i]) * 4;
+            for(uint32_t x = 0; x < kAtlasPadding; ++x)
+            {
+                memcpy(destRow + x * 4, sourceRow, 4);
+                memcpy(destRow + (kAtlasPadding + width + x) * 4, sourceRow + (width - 1) * 4, 4);
+            }
+            memcpy(destRow + kAtlasPadding * 4, sourceRow, width * 4);
+        }
+    }
+}
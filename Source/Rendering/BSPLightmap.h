@@ -10,12 +10,17 @@
 // In-memory representation of .MUL files. The MUL file format is basically
 // a blob containing one or more BMP files.
 //
+// For rendering, the many small lightmap textures are packed into a few atlas textures,
+// so BSP surfaces using different lightmaps can still be drawn together.
+//
 #pragma once
 #include "Asset.h"
 
 #include <string>
 #include <vector>
 
+#include "Vector2.h"
+
 class Texture;
 
 class BSPLightmap : public Asset
@@ -24,13 +29,31 @@ public:
     BSPLightmap(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~BSPLightmap();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
     
+    // Where a lightmap texture ended up in the atlas textures.
+    // Offset/scale are normalized (0-1) atlas UVs - atlasUV = lightmapUV * uvScale + uvOffset.
+    struct AtlasEntry
+    {
+        uint32_t atlasIndex = 0;
+        Vector2 uvOffset;
+        Vector2 uvScale;
+    };
+
     const std::vector<Texture*>& GetLightmapTextures() const { return mLightmapTextures; }
+    const std::vector<Texture*>& GetAtlasTextures() const { return mAtlasTextures; }
+    const std::vector<AtlasEntry>& GetAtlasEntries() const { return mAtlasEntries; }
     
 private:
     // Textures loaded from the MUL file.
     // Order is important, and aligns with order of surfaces in BSP file.
     // Unlike most Textures, this asset owns these Textures, and is responsible for cleanup!
     std::vector<Texture*> mLightmapTextures;
+
+    // Atlas textures containing all the lightmap textures, and where each lightmap texture is in the atlases (same order as mLightmapTextures).
+    // This asset also owns the atlas textures.
+    std::vector<Texture*> mAtlasTextures;
+    std::vector<AtlasEntry> mAtlasEntries;
+
+    void BuildAtlases();
 };
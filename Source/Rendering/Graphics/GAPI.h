@@ -7,8 +7,11 @@
 // This allows the game to use different graphics libraries while isolating the graphics code.
 //
 #pragma once
+#include <vector>
+
 #include "Color32.h"
 #include "MeshDefinition.h"
+#include "Shader.h" // For Uniform
 #include "Texture.h" // For WrapMode/FilterMode
 #include "VertexDefinition.h"
 
@@ -44,6 +47,46 @@ public:
 private:
     static GAPI* sCurrent;
 
+public:
+    // Counts of expensive graphics calls made during a frame.
+    struct FrameStats
+    {
+        uint32_t drawCalls = 0;
+        uint32_t vertexCount = 0;
+        uint32_t shaderChanges = 0;
+        uint32_t textureChanges = 0;
+        uint32_t stateChanges = 0;
+        uint32_t skippedStateChanges = 0; // Redundant shader/texture/state changes that were skipped
+        uint32_t uniformChanges = 0;
+        uint32_t bufferUploads = 0;
+    };
+
+    // Stats for the last presented frame.
+    const FrameStats& GetLastFrameStats() const { return mLastFrameStats; }
+
+protected:
+    // Stats for the frame in progress - implementations count calls as they're made, and end the frame when presenting.
+    FrameStats mFrameStats;
+    void CountStateChange(bool changed)
+    {
+        if(changed)
+        {
+            ++mFrameStats.stateChanges;
+        }
+        else
+        {
+            ++mFrameStats.skippedStateChanges;
+        }
+    }
+    void EndFrameStats()
+    {
+        mLastFrameStats = mFrameStats;
+        mFrameStats = FrameStats();
+    }
+
+private:
+    FrameStats mLastFrameStats;
+
 public:
     virtual ~GAPI() { }
 
@@ -141,21 +184,35 @@ public:
     virtual void DestroyVertexBuffer(BufferHandle handle) = 0;
     virtual void SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data) = 0;
 
+    // Index buffers usually hold 16-bit indexes. Geometry with more than 65536 vertices needs 32-bit indexes instead.
     virtual BufferHandle CreateIndexBuffer(uint32_t indexCount, uint16_t* indexData = nullptr, MeshUsage usage = MeshUsage::Static) = 0;
+    virtual BufferHandle CreateIndexBuffer(uint32_t indexCount, uint32_t* indexData, MeshUsage usage = MeshUsage::Static) = 0;
     virtual void DestroyIndexBuffer(BufferHandle handle) = 0;
     virtual void SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint16_t* indexData) = 0;
+    virtual void SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint32_t* indexData) = 0;
 
     // Shaders
     virtual ShaderHandle CreateShader(const uint8_t* vertSource, const uint8_t* fragSource) = 0;
     virtual void DestroyShader(ShaderHandle handle) = 0;
     virtual void ActivateShader(ShaderHandle handle) = 0;
 
-    virtual void SetShaderUniformInt(ShaderHandle handle, const char* name, int value) = 0;
-    virtual void SetShaderUniformFloat(ShaderHandle handle, const char* name, float value) = 0;
-    virtual void SetShaderUniformVector3(ShaderHandle handle, const char* name, const Vector3& value) = 0;
-    virtual void SetShaderUniformVector4(ShaderHandle handle, const char* name, const Vector4& value) = 0;
-    virtual void SetShaderUniformMatrix4(ShaderHandle handle, const char* name, const Matrix4& mat) = 0;
-    virtual void SetShaderUniformColor(ShaderHandle handle, const char* name, const Color32& color) = 0;
+    // Lists the shader's uniforms and their locations. Looking up locations can be slow, so do it once, after creating the shader.
+    virtual void GetShaderUniforms(ShaderHandle handle, std::vector<Uniform>& outUniforms) = 0;
+
+    // Uniforms are set by location, on the active shader. Negative locations (uniforms the shader doesn't have) are ignored.
+    virtual void SetShaderUniformInt(int location, int value) = 0;
+    virtual void SetShaderUniformFloat(int location, float value) = 0;
+    virtual void SetShaderUniformVector3(int location, const Vector3& value) = 0;
+    virtual void SetShaderUniformVector4(int location, const Vector4& value) = 0;
+    virtual void SetShaderUniformMatrix4(int location, const Matrix4& mat) = 0;
+    virtual void SetShaderUniformColor(int location, const Color32& color) = 0;
+
+    // Uniform buffers hold blocks of uniforms that can be shared by many shaders.
+    // A shader's uniform block reads from whichever buffer is bound to the same binding point.
+    virtual BufferHandle CreateUniformBuffer(uint32_t size, uint32_t bindingPoint) = 0;
+    virtual void DestroyUniformBuffer(BufferHandle handle) = 0;
+    virtual void SetUniformBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data) = 0;
+    virtual void SetShaderUniformBlockBinding(ShaderHandle handle, const char* blockName, uint32_t bindingPoint) = 0;
 
     // Drawing
     enum class Primitive
@@ -169,4 +226,8 @@ public:
     virtual void Draw(Primitive primitive, BufferHandle vertexBuffer, uint32_t vertexOffset, uint32_t vertexCount) = 0;
     virtual void Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer) = 0;
     virtual void Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer, uint32_t indexOffset, uint32_t indexCount) = 0;
+
+    // Draws several ranges of an index buffer with a single call.
+    virtual void DrawMulti(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer,
+                           const uint32_t* indexOffsets, const uint32_t* indexCounts, uint32_t rangeCount) = 0;
 };
\ No newline at end of file
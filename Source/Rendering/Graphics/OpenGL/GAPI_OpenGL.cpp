@@ -38,6 +38,18 @@ namespace GLState
         }
     }
 
+    // Forget a deleted texture, so a new texture that reuses its ID is still bound when activated.
+    void ForgetTexture(GLuint textureId)
+    {
+        for(int i = 0; i < kMaxTextureUnits; ++i)
+        {
+            if(activeTextureId[i] == textureId)
+            {
+                activeTextureId[i] = GL_NONE;
+            }
+        }
+    }
+
     GLuint activeIndexBufferId = GL_NONE;
     void BindIndexBuffer(GLuint indexBufferId)
     {
@@ -57,6 +69,90 @@ namespace GLState
             activeVertexArrayId = vertexArrayId;
         }
     }
+
+    // Render states are cached so redundant changes can be skipped. Each setter returns true if the state actually changed.
+    // Initial values are invalid, so the first call always changes state.
+    GLuint activeProgramId = UINT32_MAX;
+    bool UseProgram(GLuint programId)
+    {
+        if(activeProgramId == programId) { return false; }
+        glUseProgram(programId);
+        activeProgramId = programId;
+        return true;
+    }
+
+    int depthWriteEnabled = -1;
+    bool SetDepthWriteEnabled(bool enabled)
+    {
+        if(depthWriteEnabled == static_cast<int>(enabled)) { return false; }
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+        depthWriteEnabled = static_cast<int>(enabled);
+        return true;
+    }
+
+    int depthTestEnabled = -1;
+    bool SetDepthTestEnabled(bool enabled)
+    {
+        if(depthTestEnabled == static_cast<int>(enabled)) { return false; }
+        if(enabled)
+        {
+            glEnable(GL_DEPTH_TEST);
+        }
+        else
+        {
+            glDisable(GL_DEPTH_TEST);
+        }
+        depthTestEnabled = static_cast<int>(enabled);
+        return true;
+    }
+
+    int blendEnabled = -1;
+    bool SetBlendEnabled(bool enabled)
+    {
+        if(blendEnabled == static_cast<int>(enabled)) { return false; }
+        if(enabled)
+        {
+            glEnable(GL_BLEND);
+        }
+        else
+        {
+            glDisable(GL_BLEND);
+        }
+        blendEnabled = static_cast<int>(enabled);
+        return true;
+    }
+
+    GLenum blendSrcFactor = GL_NONE;
+    GLenum blendDstFactor = GL_NONE;
+    bool SetBlendFunc(GLenum srcFactor, GLenum dstFactor)
+    {
+        if(blendSrcFactor == srcFactor && blendDstFactor == dstFactor) { return false; }
+        glBlendFunc(srcFactor, dstFactor);
+        blendSrcFactor = srcFactor;
+        blendDstFactor = dstFactor;
+        return true;
+    }
+
+    // GL_NONE means culling is disabled.
+    GLenum cullFace = UINT32_MAX;
+    bool SetCullFace(GLenum face)
+    {
+        if(cullFace == face) { return false; }
+        if(face == GL_NONE)
+        {
+            glDisable(GL_CULL_FACE);
+        }
+        else
+        {
+            if(cullFace == GL_NONE || cullFace == UINT32_MAX)
+            {
+                glEnable(GL_CULL_FACE);
+            }
+            glCullFace(face);
+        }
+        cullFace = face;
+        return true;
+    }
 }
 
 namespace
@@ -74,6 +170,12 @@ namespace
         uint32_t count = 0;
     };
 
+    struct UniformBuffer
+    {
+        // The UBO (uniform buffer object) holds values for a uniform block, which can be shared by many shaders.
+        GLuint ubo = GL_NONE;
+    };
+
     struct IndexBuffer
     {
         // The IBO (index buffer object) holds index values for indexed geometry.
@@ -81,6 +183,10 @@ namespace
 
         // Number of indexes in the buffer.
         uint32_t count = 0;
+
+        // Indexes are either 16-bit or 32-bit.
+        GLenum type = GL_UNSIGNED_SHORT;
+        uint32_t size = sizeof(GLushort);
     };
 
     GLenum PrimitiveToDrawMode(GAPI::Primitive primitive)
@@ -174,33 +280,34 @@ void GAPI_OpenGL::Clear(Color32 clearColor)
 
 void GAPI_OpenGL::Present()
 {
+    EndFrameStats();
     SDL_GL_SwapWindow(Window::Get());
 }
 
 void GAPI_OpenGL::SetPolygonCullMode(CullMode cullMode)
 {
+    GLenum face = GL_NONE;
     switch(cullMode)
     {
     case CullMode::None:
-        glDisable(GL_CULL_FACE);
+        face = GL_NONE;
         break;
     case CullMode::Back:
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        face = GL_BACK;
         break;
     case CullMode::Front:
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_FRONT);
+        face = GL_FRONT;
         break;
     case CullMode::All:
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_FRONT_AND_BACK);
+        face = GL_FRONT_AND_BACK;
         break;
     }
+    CountStateChange(GLState::SetCullFace(face));
 }
 
 void GAPI_OpenGL::SetPolygonWindingOrder(WindingOrder windingOrder)
 {
+    ++mFrameStats.stateChanges;
     if(windingOrder == WindingOrder::CounterClockwise)
     {
         glFrontFace(GL_CCW);
@@ -213,6 +320,7 @@ void GAPI_OpenGL::SetPolygonWindingOrder(WindingOrder windingOrder)
 
 void GAPI_OpenGL::SetPolygonFillMode(FillMode fillMode)
 {
+    ++mFrameStats.stateChanges;
     switch(fillMode)
     {
     case FillMode::Wireframe:
@@ -244,37 +352,24 @@ void GAPI_OpenGL::SetViewSpaceHandedness(Handedness handedness)
 
 void GAPI_OpenGL::SetViewport(int32_t x, int32_t y, uint32_t width, uint32_t height)
 {
+    ++mFrameStats.stateChanges;
     glViewport(static_cast<GLint>(x), static_cast<GLint>(y),
                static_cast<GLsizei>(width), static_cast<GLsizei>(height));
 }
 
 void GAPI_OpenGL::SetDepthWriteEnabled(bool enabled)
 {
-    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    CountStateChange(GLState::SetDepthWriteEnabled(enabled));
 }
 
 void GAPI_OpenGL::SetDepthTestEnabled(bool enabled)
 {
-    if(enabled)
-    {
-        glEnable(GL_DEPTH_TEST);
-    }
-    else
-    {
-        glDisable(GL_DEPTH_TEST);
-    }
+    CountStateChange(GLState::SetDepthTestEnabled(enabled));
 }
 
 void GAPI_OpenGL::SetBlendEnabled(bool enabled)
 {
-    if(enabled)
-    {
-        glEnable(GL_BLEND);
-    }
-    else
-    {
-        glDisable(GL_BLEND);
-    }
+    CountStateChange(GLState::SetBlendEnabled(enabled));
 }
 
 void GAPI_OpenGL::SetBlendMode(BlendMode blendMode)
@@ -282,10 +377,10 @@ void GAPI_OpenGL::SetBlendMode(BlendMode blendMode)
     switch(blendMode)
     {
     case BlendMode::AlphaBlend:
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        CountStateChange(GLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
         break;
     case BlendMode::Multiply:
-        glBlendFunc(GL_DST_COLOR, GL_ZERO);
+        CountStateChange(GLState::SetBlendFunc(GL_DST_COLOR, GL_ZERO));
         break;
     }
 }
@@ -308,11 +403,13 @@ TextureHandle GAPI_OpenGL::CreateTexture(uint32_t width, uint32_t height, uint8_
 void GAPI_OpenGL::DestroyTexture(TextureHandle handle)
 {
     GLuint textureId = reinterpret_cast<GLuint>(handle);
+    GLState::ForgetTexture(textureId);
     glDeleteTextures(1, &textureId);
 }
 
 void GAPI_OpenGL::SetTexturePixels(TextureHandle handle, uint32_t width, uint32_t height, uint8_t* pixels)
 {
+    ++mFrameStats.bufferUploads;
     GLState::BindTexture(reinterpret_cast<GLuint>(handle));
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 }
@@ -359,8 +456,15 @@ void GAPI_OpenGL::SetTextureFilterMode(TextureHandle handle, Texture::FilterMode
 
 void GAPI_OpenGL::ActivateTexture(TextureHandle handle, uint8_t textureUnit)
 {
+    GLuint textureId = reinterpret_cast<GLuint>(handle);
+    if(GLState::activeTextureId[textureUnit] == textureId)
+    {
+        ++mFrameStats.skippedStateChanges;
+        return;
+    }
+    ++mFrameStats.textureChanges;
     GLState::SetTextureUnit(textureUnit);
-    GLState::BindTexture(reinterpret_cast<GLuint>(handle));
+    GLState::BindTexture(textureId);
 }
 
 TextureHandle GAPI_OpenGL::CreateCubemap(const CubemapParams& params)
@@ -410,7 +514,8 @@ void GAPI_OpenGL::DestroyCubemap(TextureHandle handle)
 
 void GAPI_OpenGL::ActivateCubemap(TextureHandle handle)
 {
-    glActiveTexture(GL_TEXTURE0);
+    ++mFrameStats.textureChanges;
+    GLState::SetTextureUnit(0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, reinterpret_cast<GLuint>(handle));
 }
 
@@ -481,6 +586,10 @@ void GAPI_OpenGL::DestroyVertexBuffer(BufferHandle handle)
     if(handle != nullptr)
     {
         VertexBuffer* vertexBuffer = static_cast<VertexBuffer*>(handle);
+        if(GLState::activeVertexArrayId == vertexBuffer->vao)
+        {
+            GLState::activeVertexArrayId = GL_NONE;
+        }
         glDeleteBuffers(1, &vertexBuffer->vbo);
         glDeleteVertexArrays(1, &vertexBuffer->vao);
         delete vertexBuffer;
@@ -489,29 +598,45 @@ void GAPI_OpenGL::DestroyVertexBuffer(BufferHandle handle)
 
 void GAPI_OpenGL::SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data)
 {
+    ++mFrameStats.bufferUploads;
     glBindBuffer(GL_ARRAY_BUFFER, static_cast<VertexBuffer*>(handle)->vbo);
     glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
 }
 
-BufferHandle GAPI_OpenGL::CreateIndexBuffer(uint32_t indexCount, uint16_t* indexData, MeshUsage usage)
+namespace
 {
-    // Generate the buffer id.
-    GLuint indexBufferId = GL_NONE;
-    glGenBuffers(1, &indexBufferId);
-
-    // Bind the buffer id.
-    GLState::BindIndexBuffer(indexBufferId);
+    BufferHandle CreateIndexBufferOfType(uint32_t indexCount, const void* indexData, GLenum type, uint32_t size, MeshUsage usage)
+    {
+        // Generate the buffer id.
+        GLuint indexBufferId = GL_NONE;
+        glGenBuffers(1, &indexBufferId);
+
+        // Bind the buffer id.
+        GLState::BindIndexBuffer(indexBufferId);
+
+        // Create the buffer associated with this buffer id.
+        // Even if index data is null, it's fine - this just creates an empty (but properly sized) buffer in that case.
+        GLenum glUsage = (usage == MeshUsage::Static) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * size, indexData, glUsage);
+
+        // Return handle.
+        IndexBuffer* indexBuffer = new IndexBuffer();
+        indexBuffer->ibo = indexBufferId;
+        indexBuffer->count = indexCount;
+        indexBuffer->type = type;
+        indexBuffer->size = size;
+        return indexBuffer;
+    }
+}
 
-    // Create the buffer associated with this buffer id.
-    // Even if index data is null, it's fine - this just creates an empty (but properly sized) buffer in that case.
-    GLenum glUsage = (usage == MeshUsage::Static) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW;
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCount * sizeof(GLushort), indexData, glUsage);
+BufferHandle GAPI_OpenGL::CreateIndexBuffer(uint32_t indexCount, uint16_t* indexData, MeshUsage usage)
+{
+    return CreateIndexBufferOfType(indexCount, indexData, GL_UNSIGNED_SHORT, sizeof(GLushort), usage);
+}
 
-    // Return handle.
-    IndexBuffer* indexBuffer = new IndexBuffer();
-    indexBuffer->ibo = indexBufferId;
-    indexBuffer->count = indexCount;
-    return indexBuffer;
+BufferHandle GAPI_OpenGL::CreateIndexBuffer(uint32_t indexCount, uint32_t* indexData, MeshUsage usage)
+{
+    return CreateIndexBufferOfType(indexCount, indexData, GL_UNSIGNED_INT, sizeof(GLuint), usage);
 }
 
 void GAPI_OpenGL::DestroyIndexBuffer(BufferHandle handle)
@@ -520,6 +645,10 @@ void GAPI_OpenGL::DestroyIndexBuffer(BufferHandle handle)
     if(handle != nullptr)
     {
         IndexBuffer* indexBuffer = static_cast<IndexBuffer*>(handle);
+        if(GLState::activeIndexBufferId == indexBuffer->ibo)
+        {
+            GLState::activeIndexBufferId = GL_NONE;
+        }
         glDeleteBuffers(1, &indexBuffer->ibo);
         delete indexBuffer;
     }
@@ -527,6 +656,7 @@ void GAPI_OpenGL::DestroyIndexBuffer(BufferHandle handle)
 
 void GAPI_OpenGL::SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint16_t* indexData)
 {
+    ++mFrameStats.bufferUploads;
     // Bind the buffer.
     GLState::BindIndexBuffer(static_cast<IndexBuffer*>(handle)->ibo);
 
@@ -534,6 +664,13 @@ void GAPI_OpenGL::SetIndexBufferData(BufferHandle handle, uint32_t indexCount, u
     glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(GLushort), indexData);
 }
 
+void GAPI_OpenGL::SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint32_t* indexData)
+{
+    ++mFrameStats.bufferUploads;
+    GLState::BindIndexBuffer(static_cast<IndexBuffer*>(handle)->ibo);
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(GLuint), indexData);
+}
+
 namespace
 {
     GLuint CompileShader(const char* source, GLuint shaderType)
@@ -641,10 +778,10 @@ ShaderHandle GAPI_OpenGL::CreateShader(const uint8_t* vertSource, const uint8_t*
     // To do that, we can use reflection on the shader data to see which texture uniforms exist.
     {
         // We must activate the program, since we may modify uniforms below.
-        glUseProgram(program);
+        GLState::UseProgram(program);
 
         // Info obtained about each uniform.
-        const GLsizei kMaxUniformNameLength = 32;
+        const GLsizei kMaxUniformNameLength = 64;
         GLchar uniformNameBuffer[kMaxUniformNameLength];
         GLsizei uniformNameLength = 0;
         GLsizei uniformSize = 0;
@@ -669,7 +806,7 @@ ShaderHandle GAPI_OpenGL::CreateShader(const uint8_t* vertSource, const uint8_t*
             // But you must manually specify the unit if more than one texture is used.
             if(uniformType == GL_SAMPLER_2D)
             {
-                SetShaderUniformInt(reinterpret_cast<ShaderHandle>(program), uniformNameBuffer, textureUnitCounter);
+                glUniform1i(glGetUniformLocation(program, uniformNameBuffer), textureUnitCounter);
                 ++textureUnitCounter;
             }
         }
@@ -681,89 +818,198 @@ ShaderHandle GAPI_OpenGL::CreateShader(const uint8_t* vertSource, const uint8_t*
 
 void GAPI_OpenGL::DestroyShader(ShaderHandle handle)
 {
-    glDeleteProgram(reinterpret_cast<GLuint>(handle));
+    GLuint program = reinterpret_cast<GLuint>(handle);
+    if(GLState::activeProgramId == program)
+    {
+        GLState::activeProgramId = UINT32_MAX;
+    }
+    glDeleteProgram(program);
 }
 
 void GAPI_OpenGL::ActivateShader(ShaderHandle handle)
 {
-    glUseProgram(reinterpret_cast<GLuint>(handle));
+    if(GLState::UseProgram(reinterpret_cast<GLuint>(handle)))
+    {
+        ++mFrameStats.shaderChanges;
+    }
+    else
+    {
+        ++mFrameStats.skippedStateChanges;
+    }
 }
 
-void GAPI_OpenGL::SetShaderUniformInt(ShaderHandle handle, const char* name, int value)
+namespace
 {
-    GLuint program = reinterpret_cast<GLuint>(handle);
-    if(program != GL_NONE)
+    UniformType GLTypeToUniformType(GLenum type)
     {
-        GLint loc = glGetUniformLocation(program, name);
-        if(loc >= 0)
+        switch(type)
         {
-            glUniform1i(loc, value);
+        case GL_FLOAT:
+            return UniformType::Float;
+        case GL_INT:
+            return UniformType::Int;
+        case GL_UNSIGNED_INT:
+            return UniformType::Uint;
+        case GL_BOOL:
+            return UniformType::Bool;
+        case GL_FLOAT_VEC2:
+            return UniformType::Vector2;
+        case GL_FLOAT_VEC3:
+            return UniformType::Vector3;
+        case GL_FLOAT_VEC4:
+            return UniformType::Vector4;
+        case GL_FLOAT_MAT2:
+            return UniformType::Matrix2;
+        case GL_FLOAT_MAT3:
+            return UniformType::Matrix3;
+        case GL_FLOAT_MAT4:
+            return UniformType::Matrix4;
+        case GL_SAMPLER_2D:
+            return UniformType::Texture2D;
+        case GL_SAMPLER_CUBE:
+            return UniformType::TextureCube;
+        default:
+            return UniformType::Unknown;
         }
     }
 }
 
-void GAPI_OpenGL::SetShaderUniformFloat(ShaderHandle handle, const char* name, float value)
+void GAPI_OpenGL::GetShaderUniforms(ShaderHandle handle, std::vector<Uniform>& outUniforms)
 {
     GLuint program = reinterpret_cast<GLuint>(handle);
-    if(program != GL_NONE)
+    if(program == GL_NONE) { return; }
+
+    // Info obtained about each uniform.
+    const GLsizei kMaxUniformNameLength = 64;
+    GLchar uniformNameBuffer[kMaxUniformNameLength];
+    GLsizei uniformNameLength = 0;
+    GLsizei uniformSize = 0;
+    GLenum uniformType = GL_NONE;
+
+    GLint uniformCount = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &uniformCount);
+    for(GLint i = 0; i < uniformCount; ++i)
     {
-        GLint loc = glGetUniformLocation(program, name);
-        if(loc >= 0)
+        glGetActiveUniform(program, i, kMaxUniformNameLength, &uniformNameLength, &uniformSize, &uniformType, uniformNameBuffer);
+        if(uniformNameLength <= 0) { continue; }
+
+        // Uniforms inside a uniform block are "active," but have no location - they're set via the block's buffer instead.
+        GLint location = glGetUniformLocation(program, uniformNameBuffer);
+        if(location < 0) { continue; }
+
+        // Arrays are reported as "name[0]" - strip that, so the uniform can be looked up by its declared name.
+        std::string name(uniformNameBuffer, uniformNameLength);
+        if(name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
         {
-            glUniform1f(loc, value);
+            name.resize(name.size() - 3);
         }
+
+        Uniform uniform;
+        uniform.type = GLTypeToUniformType(uniformType);
+        uniform.name = name;
+        uniform.location = location;
+        outUniforms.push_back(uniform);
     }
 }
 
-void GAPI_OpenGL::SetShaderUniformVector3(ShaderHandle handle, const char* name, const Vector3& value)
+void GAPI_OpenGL::SetShaderUniformInt(int location, int value)
 {
-    GLuint program = reinterpret_cast<GLuint>(handle);
-    if(program != GL_NONE)
+    if(location >= 0)
     {
-        GLint loc = glGetUniformLocation(program, name);
-        if(loc >= 0)
-        {
-            glUniform3f(loc, value.x, value.y, value.z);
-        }
+        ++mFrameStats.uniformChanges;
+        glUniform1i(location, value);
     }
 }
 
-void GAPI_OpenGL::SetShaderUniformVector4(ShaderHandle handle, const char* name, const Vector4& value)
+void GAPI_OpenGL::SetShaderUniformFloat(int location, float value)
 {
-    GLuint program = reinterpret_cast<GLuint>(handle);
-    if(program != GL_NONE)
+    if(location >= 0)
     {
-        GLint loc = glGetUniformLocation(program, name);
-        if(loc >= 0)
-        {
-            glUniform4f(loc, value.x, value.y, value.z, value.w);
-        }
+        ++mFrameStats.uniformChanges;
+        glUniform1f(location, value);
     }
 }
 
-void GAPI_OpenGL::SetShaderUniformMatrix4(ShaderHandle handle, const char* name, const Matrix4& mat)
+void GAPI_OpenGL::SetShaderUniformVector3(int location, const Vector3& value)
 {
-    GLuint program = reinterpret_cast<GLuint>(handle);
-    if(program != GL_NONE)
+    if(location >= 0)
     {
-        GLint loc = glGetUniformLocation(program, name);
-        if(loc >= 0)
-        {
-            glUniformMatrix4fv(loc, 1, GL_FALSE, mat);
-        }
+        ++mFrameStats.uniformChanges;
+        glUniform3f(location, value.x, value.y, value.z);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformVector4(int location, const Vector4& value)
+{
+    if(location >= 0)
+    {
+        ++mFrameStats.uniformChanges;
+        glUniform4f(location, value.x, value.y, value.z, value.w);
     }
 }
 
-void GAPI_OpenGL::SetShaderUniformColor(ShaderHandle handle, const char* name, const Color32& color)
+void GAPI_OpenGL::SetShaderUniformMatrix4(int location, const Matrix4& mat)
+{
+    if(location >= 0)
+    {
+        ++mFrameStats.uniformChanges;
+        glUniformMatrix4fv(location, 1, GL_FALSE, mat);
+    }
+}
+
+void GAPI_OpenGL::SetShaderUniformColor(int location, const Color32& color)
+{
+    if(location >= 0)
+    {
+        ++mFrameStats.uniformChanges;
+        glUniform4f(location, color.GetR() / 255.0f, color.GetG() / 255.0f, color.GetB() / 255.0f, color.GetA() / 255.0f);
+    }
+}
+
+BufferHandle GAPI_OpenGL::CreateUniformBuffer(uint32_t size, uint32_t bindingPoint)
+{
+    // Create an empty buffer of the needed size.
+    GLuint uniformBufferId = GL_NONE;
+    glGenBuffers(1, &uniformBufferId);
+    glBindBuffer(GL_UNIFORM_BUFFER, uniformBufferId);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+
+    // Attach it to the binding point. It stays there, so shaders bound to that point always read from this buffer.
+    glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, uniformBufferId);
+
+    UniformBuffer* uniformBuffer = new UniformBuffer();
+    uniformBuffer->ubo = uniformBufferId;
+    return uniformBuffer;
+}
+
+void GAPI_OpenGL::DestroyUniformBuffer(BufferHandle handle)
+{
+    // It's valid to destroy a null handle.
+    if(handle != nullptr)
+    {
+        UniformBuffer* uniformBuffer = static_cast<UniformBuffer*>(handle);
+        glDeleteBuffers(1, &uniformBuffer->ubo);
+        delete uniformBuffer;
+    }
+}
+
+void GAPI_OpenGL::SetUniformBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data)
+{
+    ++mFrameStats.bufferUploads;
+    glBindBuffer(GL_UNIFORM_BUFFER, static_cast<UniformBuffer*>(handle)->ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+}
+
+void GAPI_OpenGL::SetShaderUniformBlockBinding(ShaderHandle handle, const char* blockName, uint32_t bindingPoint)
 {
     GLuint program = reinterpret_cast<GLuint>(handle);
-    if(program != GL_NONE)
+    if(program == GL_NONE) { return; }
+
+    // It's fine if the shader doesn't use this block.
+    GLuint blockIndex = glGetUniformBlockIndex(program, blockName);
+    if(blockIndex != GL_INVALID_INDEX)
     {
-        GLint loc = glGetUniformLocation(program, name);
-        if(loc >= 0)
-        {
-            glUniform4f(loc, color.GetR() / 255.0f, color.GetG() / 255.0f, color.GetB() / 255.0f, color.GetA() / 255.0f);
-        }
+        glUniformBlockBinding(program, blockIndex, bindingPoint);
     }
 }
 
@@ -781,6 +1027,8 @@ void GAPI_OpenGL::Draw(Primitive primitive, BufferHandle vertexBuffer, uint32_t
 
     // Draw "count" vertices at offset.
     glDrawArrays(PrimitiveToDrawMode(primitive), vertexOffset, vertexCount);
+    ++mFrameStats.drawCalls;
+    mFrameStats.vertexCount += vertexCount;
 }
 
 void GAPI_OpenGL::Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer)
@@ -796,8 +1044,39 @@ void GAPI_OpenGL::Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHan
     GLState::BindVertexArray(static_cast<VertexBuffer*>(vertexBuffer)->vao);
 
     // Bind the VAO, since we're drawing with an index buffer here.
-    GLState::BindIndexBuffer(static_cast<IndexBuffer*>(indexBuffer)->ibo);
+    IndexBuffer* ib = static_cast<IndexBuffer*>(indexBuffer);
+    GLState::BindIndexBuffer(ib->ibo);
 
     // Draw "count" indices at offset.
-    glDrawElements(PrimitiveToDrawMode(primitive), indexCount, GL_UNSIGNED_SHORT, BUFFER_OFFSET(indexOffset * sizeof(GLushort)));
+    glDrawElements(PrimitiveToDrawMode(primitive), indexCount, ib->type, BUFFER_OFFSET(indexOffset * ib->size));
+    ++mFrameStats.drawCalls;
+    mFrameStats.vertexCount += indexCount;
+}
+
+void GAPI_OpenGL::DrawMulti(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer,
+                            const uint32_t* indexOffsets, const uint32_t* indexCounts, uint32_t rangeCount)
+{
+    if(rangeCount == 0) { return; }
+
+    // Bind the VAO and index buffer, same as a normal indexed draw.
+    GLState::BindVertexArray(static_cast<VertexBuffer*>(vertexBuffer)->vao);
+    IndexBuffer* ib = static_cast<IndexBuffer*>(indexBuffer);
+    GLState::BindIndexBuffer(ib->ibo);
+
+    // GL wants counts as GLsizei, and offsets as byte offsets (pointers). Reuse these arrays between calls to avoid allocating each frame.
+    static std::vector<GLsizei> counts;
+    static std::vector<const void*> offsets;
+    counts.resize(rangeCount);
+    offsets.resize(rangeCount);
+    uint32_t totalCount = 0;
+    for(uint32_t i = 0; i < rangeCount; ++i)
+    {
+        counts[i] = static_cast<GLsizei>(indexCounts[i]);
+        offsets[i] = BUFFER_OFFSET(indexOffsets[i] * ib->size);
+        totalCount += indexCounts[i];
+    }
+
+    glMultiDrawElements(PrimitiveToDrawMode(primitive), counts.data(), ib->type, offsets.data(), static_cast<GLsizei>(rangeCount));
+    ++mFrameStats.drawCalls;
+    mFrameStats.vertexCount += totalCount;
 }
\ No newline at end of file
@@ -46,24 +46,35 @@ public:
     void SetVertexBufferData(BufferHandle handle, uint32_t offset, uint32_t size, void* data) override;
 
     BufferHandle CreateIndexBuffer(uint32_t indexCount, uint16_t* indexData, MeshUsage usage) override;
+    BufferHandle CreateIndexBuffer(uint32_t indexCount, uint32_t* indexData, MeshUsage usage) override;
     void DestroyIndexBuffer(BufferHandle handle) override;
     void SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint16_t* indexData) override;
+    void SetIndexBufferData(BufferHandle handle, uint32_t indexCount, uint32_t* indexData) override;
 
     ShaderHandle CreateShader(const uint8_t* vertSource, const uint8_t* fragSource) override;
     void DestroyShader(ShaderHandle handle) override;
     void ActivateShader(ShaderHandle handle) override;
 
-    void SetShaderUniformInt(ShaderHandle handle, const char* name, int value) override;
-    void SetShaderUniformFloat(ShaderHandle handle, const char* name, float value) override;
-    void SetShaderUniformVector3(ShaderHandle handle, const char* name, const Vector3& value) override;
-    void SetShaderUniformVector4(ShaderHandle handle, const char* name, const Vector4& value) override;
-    void SetShaderUniformMatrix4(ShaderHandle handle, const char* name, const Matrix4& mat) override;
-    void SetShaderUniformColor(ShaderHandle handle, const char* name, const Color32& color) override;
+    void GetShaderUniforms(ShaderHandle handle, std::vector<Uniform>& outUniforms) override;
+
+    void SetShaderUniformInt(int location, int value) override;
+    void SetShaderUniformFloat(int location, float value) override;
+    void SetShaderUniformVector3(int location, const Vector3& value) override;
+    void SetShaderUniformVector4(int location, const Vector4& value) override;
+    void SetShaderUniformMatrix4(int location, const Matrix4& mat) override;
+    void SetShaderUniformColor(int location, const Color32& color) override;
+
+    BufferHandle CreateUniformBuffer(uint32_t size, uint32_t bindingPoint) override;
+    void DestroyUniformBuffer(BufferHandle handle) override;
+    void SetUniformBufferData(BufferHandle handle, uint32_t offset, uint32_t size, const void* data) override;
+    void SetShaderUniformBlockBinding(ShaderHandle handle, const char* blockName, uint32_t bindingPoint) override;
 
     void Draw(Primitive primitive, BufferHandle vertexBuffer) override;
     void Draw(Primitive primitive, BufferHandle vertexBuffer, uint32_t vertexOffset, uint32_t vertexCount) override;
     void Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer) override;
     void Draw(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer, uint32_t indexOffset, uint32_t indexCount) override;
+    void DrawMulti(Primitive primitive, BufferHandle vertexBuffer, BufferHandle indexBuffer,
+                   const uint32_t* indexOffsets, const uint32_t* indexCounts, uint32_t rangeCount) override;
 
 private:
     // Context handle for rendering in OpenGL.
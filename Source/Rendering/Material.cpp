@@ -1,5 +1,8 @@
 #include "Material.h"
 
+#include <utility>
+
+#include "GAPI.h"
 #include "Matrix4.h"
 #include "Shader.h"
 #include "Texture.h"
@@ -12,14 +15,19 @@ Matrix4 Material::sCurrentProjMatrix;
 
 float Material::sAlphaTestValue = 0.0f;
 
+void* Material::sFrameUniformBuffer = nullptr;
+bool Material::sFrameUniformsDirty = true;
+
 void Material::SetViewMatrix(const Matrix4& viewMatrix)
 {
 	sCurrentViewMatrix = viewMatrix;
+	sFrameUniformsDirty = true;
 }
 
 void Material::SetProjMatrix(const Matrix4& projMatrix)
 {
 	sCurrentProjMatrix = projMatrix;
+	sFrameUniformsDirty = true;
 }
 
 void Material::UseAlphaTest(bool use)
@@ -27,6 +35,16 @@ void Material::UseAlphaTest(bool use)
 	sAlphaTestValue = use ? 0.1f : 0.0f;
 }
 
+void Material::Shutdown()
+{
+    if(sFrameUniformBuffer != nullptr)
+    {
+        GAPI::Get()->DestroyUniformBuffer(sFrameUniformBuffer);
+        sFrameUniformBuffer = nullptr;
+    }
+    sFrameUniformsDirty = true;
+}
+
 Material::Material() : mShader(sDefaultShader)
 {
     SetColor(Color32::White);
@@ -37,45 +55,130 @@ Material::Material(Shader* shader) : mShader(shader)
     SetColor(Color32::White);
 }
 
+Material::Material(const Material& other) :
+    mShader(other.mShader),
+    mColors(other.mColors),
+    mTextures(other.mTextures),
+    mVectors(other.mVectors)
+{
+
+}
+
+Material::Material(Material&& other) :
+    mShader(other.mShader),
+    mColors(std::move(other.mColors)),
+    mTextures(std::move(other.mTextures)),
+    mVectors(std::move(other.mVectors))
+{
+    other.mLocationsDirty = true;
+}
+
+Material& Material::operator=(const Material& other)
+{
+    if(this != &other)
+    {
+        mShader = other.mShader;
+        mColors = other.mColors;
+        mTextures = other.mTextures;
+        mVectors = other.mVectors;
+        mLocationsDirty = true;
+    }
+    return *this;
+}
+
+Material& Material::operator=(Material&& other)
+{
+    if(this != &other)
+    {
+        mShader = other.mShader;
+        mColors = std::move(other.mColors);
+        mTextures = std::move(other.mTextures);
+        mVectors = std::move(other.mVectors);
+        mLocationsDirty = true;
+        other.mLocationsDirty = true;
+    }
+    return *this;
+}
+
 void Material::Activate(const Matrix4& objectToWorldMatrix)
+{
+    Activate(objectToWorldMatrix, nullptr);
+}
+
+void Material::Activate(const Matrix4& objectToWorldMatrix, const Matrix4& worldToObjectMatrix)
+{
+    Activate(objectToWorldMatrix, &worldToObjectMatrix);
+}
+
+void Material::Activate(const Matrix4& objectToWorldMatrix, const Matrix4* worldToObjectMatrix)
 {
     // Must activate shader BEFORE setting uniforms to get correct results.
     // See https://stackoverflow.com/questions/42357380/why-must-i-use-a-shader-program-before-i-can-set-its-uniforms
     mShader->Activate();
+
+    // Upload view/projection matrices if they've changed since the last upload.
+    if(sFrameUniformsDirty)
+    {
+        if(sFrameUniformBuffer == nullptr)
+        {
+            sFrameUniformBuffer = GAPI::Get()->CreateUniformBuffer(sizeof(Matrix4) * 3, Shader::kFrameUniformsBindingPoint);
+        }
+
+        // Layout matches the FrameUniforms block in shaders (std140 layout; mat4s are tightly packed).
+        Matrix4 frameUniforms[3] = { sCurrentViewMatrix, sCurrentProjMatrix, sCurrentProjMatrix * sCurrentViewMatrix };
+        GAPI::Get()->SetUniformBufferData(sFrameUniformBuffer, 0, sizeof(frameUniforms), frameUniforms);
+        sFrameUniformsDirty = false;
+    }
     
 	// Set built-in transform matrices.
-    mShader->SetUniformMatrix4("gObjectToWorldMatrix", objectToWorldMatrix);
-    mShader->SetUniformMatrix4("gWorldToObjectMatrix", Matrix4::Inverse(objectToWorldMatrix));
+    mShader->SetUniformMatrix4(mShader->GetUniformLocation(BuiltInUniform::ObjectToWorldMatrix), objectToWorldMatrix);
 
-    mShader->SetUniformMatrix4("gViewMatrix", sCurrentViewMatrix);
-    mShader->SetUniformMatrix4("gProjMatrix", sCurrentProjMatrix);
-	mShader->SetUniformMatrix4("gWorldToProjMatrix", sCurrentProjMatrix * sCurrentViewMatrix);
+    // Only calculate the inverse if the shader uses it, and the caller didn't already provide it.
+    int worldToObjectLocation = mShader->GetUniformLocation(BuiltInUniform::WorldToObjectMatrix);
+    if(worldToObjectLocation >= 0)
+    {
+        if(worldToObjectMatrix != nullptr)
+        {
+            mShader->SetUniformMatrix4(worldToObjectLocation, *worldToObjectMatrix);
+        }
+        else
+        {
+            mShader->SetUniformMatrix4(worldToObjectLocation, Matrix4::Inverse(objectToWorldMatrix));
+        }
+    }
 	
 	// Set built-in alpha test value.
-	mShader->SetUniformFloat("gAlphaTest", sAlphaTestValue);
+	mShader->SetUniformFloat(mShader->GetUniformLocation(BuiltInUniform::AlphaTest), sAlphaTestValue);
+
+    // Make sure cached property locations are valid for this shader.
+    if(mLocationsDirty || mLocationsShader != mShader)
+    {
+        RefreshUniformLocations();
+    }
 	
     // Set user-defined color values.
-    for(auto& entry : mColors)
+    for(auto& entry : mColorLocations)
     {
-        mShader->SetUniformColor(entry.first.c_str(), entry.second);
+        mShader->SetUniformColor(entry.location, *static_cast<const Color32*>(entry.value));
     }
     
     // Set user-defined textures.
     uint8_t textureUnit = 0;
-    for(auto& entry : mTextures)
+    for(auto& entry : mTextureLocations)
     {
-        if(entry.second != nullptr)
+        Texture* texture = *static_cast<Texture* const*>(entry.value);
+        if(texture != nullptr)
         {
-            mShader->SetUniformInt(entry.first.c_str(), textureUnit);
-            entry.second->Activate(textureUnit);
+            mShader->SetUniformInt(entry.location, textureUnit);
+            texture->Activate(textureUnit);
             ++textureUnit;
         }
     }
 
     // Set user-defined vector values.
-    for(auto& entry : mVectors)
+    for(auto& entry : mVectorLocations)
     {
-        mShader->SetUniformVector4(entry.first.c_str(), entry.second);
+        mShader->SetUniformVector4(entry.location, *static_cast<const Vector4*>(entry.value));
     }
     
 	//TODO: May need to "deactivate" texture units if no texture is defined in material, but a texture sampler exists in the shader.
@@ -83,7 +186,14 @@ void Material::Activate(const Matrix4& objectToWorldMatrix)
 
 void Material::SetColor(const std::string& name, const Color32& color)
 {
+    auto it = mColors.find(name);
+    if(it != mColors.end())
+    {
+        it->second = color;
+        return;
+    }
     mColors[name] = color;
+    mLocationsDirty = true;
 }
 
 const Color32* Material::GetColor(const std::string& name) const
@@ -98,7 +208,14 @@ const Color32* Material::GetColor(const std::string& name) const
 
 void Material::SetTexture(const std::string& name, Texture* texture)
 {
+    auto it = mTextures.find(name);
+    if(it != mTextures.end())
+    {
+        it->second = texture;
+        return;
+    }
     mTextures[name] = texture;
+    mLocationsDirty = true;
 }
 
 Texture* Material::GetTexture(const std::string& name) const
@@ -113,7 +230,48 @@ Texture* Material::GetTexture(const std::string& name) const
 
 void Material::SetVector4(const std::string& name, const Vector4& vector)
 {
+    auto it = mVectors.find(name);
+    if(it != mVectors.end())
+    {
+        it->second = vector;
+        return;
+    }
     mVectors[name] = vector;
+    mLocationsDirty = true;
+}
+
+void Material::RefreshUniformLocations()
+{
+    mColorLocations.clear();
+    for(auto& entry : mColors)
+    {
+        CachedLocation cached;
+        cached.location = mShader->GetUniformLocation(entry.first);
+        cached.value = &entry.second;
+        mColorLocations.push_back(cached);
+    }
+
+    // Textures are kept even if the shader doesn't use them, so texture units are assigned the same as before.
+    mTextureLocations.clear();
+    for(auto& entry : mTextures)
+    {
+        CachedLocation cached;
+        cached.location = mShader->GetUniformLocation(entry.first);
+        cached.value = &entry.second;
+        mTextureLocations.push_back(cached);
+    }
+
+    mVectorLocations.clear();
+    for(auto& entry : mVectors)
+    {
+        CachedLocation cached;
+        cached.location = mShader->GetUniformLocation(entry.first);
+        cached.value = &entry.second;
+        mVectorLocations.push_back(cached);
+    }
+
+    mLocationsShader = mShader;
+    mLocationsDirty = false;
 }
 
 bool Material::IsTranslucent()
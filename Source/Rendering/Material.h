@@ -21,13 +21,24 @@ public:
 	static void SetViewMatrix(const Matrix4& viewMatrix);
 	static void SetProjMatrix(const Matrix4& projMatrix);
 	static void UseAlphaTest(bool use);
+
+	// Releases graphics resources shared by all materials. Must be called before the GAPI shuts down.
+	static void Shutdown();
 	
     Material();
 	Material(Shader* shader);
+
+    // Cached uniform locations point into the property maps, so they aren't copied - the copy rebuilds its own.
+    Material(const Material& other);
+    Material(Material&& other);
+    Material& operator=(const Material& other);
+    Material& operator=(Material&& other);
     
+	// If the world-to-object matrix is already known (e.g. cached by the object), pass it in - otherwise, it's calculated if the shader needs it.
 	void Activate(const Matrix4& objectToWorldMatrix);
+	void Activate(const Matrix4& objectToWorldMatrix, const Matrix4& worldToObjectMatrix);
 	
-    void SetShader(Shader* shader) { mShader = shader; }
+    void SetShader(Shader* shader) { mShader = shader; mLocationsDirty = true; }
     Shader* GetShader() const { return mShader; }
     
     void SetColor(const std::string& name, const Color32& color);
@@ -50,7 +61,11 @@ private:
 	static Matrix4 sCurrentViewMatrix;
 	static Matrix4 sCurrentProjMatrix;
 	static float sAlphaTestValue;
-	
+
+	// View/projection matrices are uploaded to a uniform buffer shared by all shaders - once when they change, rather than per object.
+	static void* sFrameUniformBuffer;
+	static bool sFrameUniformsDirty;
+
     // Shader to use.
     Shader* mShader = nullptr;
 
@@ -59,6 +74,22 @@ private:
     std::unordered_map<std::string, Color32> mColors;
     std::unordered_map<std::string, Texture*> mTextures;
     std::unordered_map<std::string, Vector4> mVectors;
+
+    // Each property's uniform location in the current shader, so properties can be set without looking up names.
+    // Rebuilt when the shader changes, when a new property is added, or when the material is copied or moved (values point into the maps).
+    struct CachedLocation
+    {
+        int location = -1;
+        const void* value = nullptr;
+    };
+    std::vector<CachedLocation> mColorLocations;
+    std::vector<CachedLocation> mTextureLocations;
+    std::vector<CachedLocation> mVectorLocations;
+    Shader* mLocationsShader = nullptr;
+    bool mLocationsDirty = true;
+
+    void Activate(const Matrix4& objectToWorldMatrix, const Matrix4* worldToObjectMatrix);
+    void RefreshUniformLocations();
     
     //TODO: Opaque vs. transparent? Render queue value?
 };
@@ -12,6 +12,42 @@ Mesh::~Mesh()
 	}
 }
 
+const Matrix4& Mesh::GetLocalToMeshMatrix()
+{
+    if(mLocalToMeshDirty)
+    {
+        mLocalToMeshMatrix = Matrix4::InverseTransform(mMeshToLocalMatrix);
+        mLocalToMeshDirty = false;
+    }
+    return mLocalToMeshMatrix;
+}
+
+void Mesh::SetSubmeshPoseAABB(int submeshIndex, const AABB& aabb)
+{
+    // Submeshes that were never posed are still in their original positions, which the mesh's AABB already contains.
+    if(submeshIndex >= static_cast<int>(mSubmeshPoseAABBs.size()))
+    {
+        mSubmeshPoseAABBs.resize(submeshIndex + 1, mAABB);
+    }
+    mSubmeshPoseAABBs[submeshIndex] = aabb;
+    mCullingAABBDirty = true;
+}
+
+const AABB& Mesh::GetCullingAABB()
+{
+    if(mCullingAABBDirty)
+    {
+        mCullingAABB = mAABB;
+        for(const AABB& poseAABB : mSubmeshPoseAABBs)
+        {
+            mCullingAABB.GrowToContain(poseAABB.GetMin());
+            mCullingAABB.GrowToContain(poseAABB.GetMax());
+        }
+        mCullingAABBDirty = false;
+    }
+    return mCullingAABB;
+}
+
 void Mesh::Render()
 {
 	for(auto& submesh : mSubmeshes)
@@ -28,11 +28,17 @@ public:
 	void Render(unsigned int submeshIndex);
 	void Render(unsigned int submeshIndex, unsigned int offset, unsigned int count);
     
-    void SetMeshToLocalMatrix(const Matrix4& mat) { mMeshToLocalMatrix = mat; }
-    Matrix4& GetMeshToLocalMatrix() { return mMeshToLocalMatrix; }
+    void SetMeshToLocalMatrix(const Matrix4& mat) { mMeshToLocalMatrix = mat; mLocalToMeshDirty = true; }
+    const Matrix4& GetMeshToLocalMatrix() const { return mMeshToLocalMatrix; }
+    const Matrix4& GetLocalToMeshMatrix();
 	
-	void SetAABB(const AABB& aabb) { mAABB = aabb; }
+	void SetAABB(const AABB& aabb) { mAABB = aabb; mCullingAABBDirty = true; }
 	const AABB& GetAABB() const { return mAABB; }
+
+    // Vertex animations can move a submesh's vertices outside the mesh's AABB (e.g. an arm reaching out).
+    // So, culling uses an AABB that also contains the current pose of each animated submesh.
+    void SetSubmeshPoseAABB(int submeshIndex, const AABB& aabb);
+    const AABB& GetCullingAABB();
 	
     Submesh* AddSubmesh(const MeshDefinition& meshDefinition);
     
@@ -51,7 +57,16 @@ private:
 	// Each Mesh in GK3 has its own position/rotation/scale, and Submesh vertices are relative to the Mesh coordinate system.
 	// This matrix represents the Mesh's coordinate system and can be used to transform from mesh space to parent space.
     Matrix4 mMeshToLocalMatrix = Matrix4::Identity;
+
+    // Inverse of the above, calculated only when needed after the mesh-to-local matrix changes.
+    Matrix4 mLocalToMeshMatrix = Matrix4::Identity;
+    bool mLocalToMeshDirty = false;
 	
 	// An AABB for the mesh, in its own local space.
 	AABB mAABB;
+
+    // Bounds of each submesh's current vertex animation pose, and an AABB containing these and the mesh's AABB.
+    std::vector<AABB> mSubmeshPoseAABBs;
+    AABB mCullingAABB;
+    bool mCullingAABBDirty = true;
 };
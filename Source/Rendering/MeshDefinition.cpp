@@ -30,3 +30,9 @@ void MeshDefinition::SetIndexData(unsigned int count, unsigned short* data)
     indexCount = count;
     indexData = data;
 }
+
+void MeshDefinition::SetIndexData(unsigned int count, uint32_t* data)
+{
+    indexCount = count;
+    indexData32 = data;
+}
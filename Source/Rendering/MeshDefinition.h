@@ -6,6 +6,7 @@
 //
 #pragma once
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 #include "Value.h"
@@ -40,7 +41,9 @@ struct MeshDefinition
     std::vector<TypeHandler*> vertexDataTypeHandlers;
 
     // A buffer of indexes, if mesh uses indexes.
+    // Indexes are usually 16-bit, but a mesh with more than 65536 vertices needs 32-bit indexes instead - only one of these is used.
     unsigned short* indexData = nullptr;
+    uint32_t* indexData32 = nullptr;
 
     // Vertex/index data is usually "owned" by this object.
     // But in rare circumstances, data lifetime may be owned by external systems - so keep track of that here!
@@ -60,6 +63,7 @@ struct MeshDefinition
     template<typename T> void SetVertexData(T* data);
     
     void SetIndexData(unsigned int count, unsigned short* data);
+    void SetIndexData(unsigned int count, uint32_t* data);
 
     template<typename T> T* GetVertexData(const VertexAttribute& attribute) const;
 };
@@ -9,6 +9,7 @@
 #include "Model.h"
 #include "Ray.h"
 #include "Renderer.h"
+#include "RenderQueue.h"
 #include "Texture.h"
 
 TYPE_DEF_CHILD(Component, MeshRenderer);
@@ -23,7 +24,7 @@ MeshRenderer::~MeshRenderer()
     gRenderer.RemoveMeshRenderer(this);
 }
 
-void MeshRenderer::Render(bool opaque, bool translucent)
+void MeshRenderer::Render(RenderQueue& renderQueue)
 {
     // Don't render if actor is inactive or component is disabled.
     if(!IsActiveAndEnabled()) { return; }
@@ -37,11 +38,15 @@ void MeshRenderer::Render(bool opaque, bool translucent)
     int maxMaterialIndex = static_cast<int>(mMaterials.size()) - 1;
     
     // Iterate meshes and render each in turn.
-    Matrix4 localToWorldMatrix = GetOwner()->GetTransform()->GetLocalToWorldMatrix();
+    Transform* transform = GetOwner()->GetTransform();
+    Matrix4 localToWorldMatrix = transform->GetLocalToWorldMatrix();
     for(size_t i = 0; i < mMeshes.size(); i++)
     {
         // Mesh vertices are in "mesh space". Create matrix to convert to world space.
         Matrix4 meshToWorldMatrix = localToWorldMatrix * mMeshes[i]->GetMeshToLocalMatrix();
+
+        // Some shaders also need the inverse. The transform and mesh each cache their own inverse, and only recalculate it when they change.
+        Matrix4 worldToMeshMatrix = mMeshes[i]->GetLocalToMeshMatrix() * transform->GetWorldToLocalMatrix();
         
         // Iterate each submesh.
         const std::vector<Submesh*>& submeshes = mMeshes[i]->GetSubmeshes();
@@ -57,45 +62,37 @@ void MeshRenderer::Render(bool opaque, bool translucent)
                 int materialIndex = Math::Min(submeshIndex, maxMaterialIndex);
                 Material& material = mMaterials[materialIndex];
 
-                // If this is translucent, only render if want to render translucent stuff.
-                // Or if this is opaque, only render if want to render opaque.
-                if((opaque && !material.IsTranslucent()) ||
-                   (translucent && material.IsTranslucent()))
+                // Queue the submesh to be rendered in the appropriate pass.
+                RenderQueue::Pass pass = material.IsTranslucent() ? RenderQueue::Pass::Translucent : RenderQueue::Pass::Opaque;
+                renderQueue.Add(pass, &material, submeshes[j], meshToWorldMatrix, worldToMeshMatrix);
+
+                // Draw debug axes if desired.
+                if(Debug::RenderSubmeshLocalAxes())
                 {
-                    // Activate material.
-                    material.Activate(meshToWorldMatrix);
-
-                    // Render the submesh!
-                    submeshes[j]->Render();
-
-                    // Draw debug axes if desired.
-                    if(Debug::RenderSubmeshLocalAxes())
-                    {
-                        Debug::DrawAxes(meshToWorldMatrix);
-                    }
-
-                    /*
-                    // Uncomment to visualize normals.
-                    int vcount = submeshes[j]->GetVertexCount();
-                    for(int k = 0; k < vcount; ++k)
-                    {
-                        Matrix4 worldToMeshMatrix = Matrix4::Inverse(meshToWorldMatrix);
-                        Vector3 lightPos = worldToMeshMatrix.TransformPoint(gSceneManager.GetScene()->GetSceneData()->GetGlobalLightPosition());
-                        Vector3 lightDir = Vector3::Normalize(lightPos - submeshes[j]->GetVertexPosition(k));
-                        float dot = Vector3::Dot(submeshes[j]->GetVertexNormal(k), lightDir);
-                        Color32 color(static_cast<int>(dot * 255), 0, 0);
-
-                        Vector3 pos = submeshes[j]->GetVertexPosition(k);
-                        pos = meshToWorldMatrix.TransformPoint(pos);
-
-                        Vector3 normal = submeshes[j]->GetVertexNormal(k);
-                        normal = meshToWorldMatrix.TransformNormal(normal);
-
-                        Debug::DrawLine(pos, pos + normal, color);
-                        //Debug::DrawLine(pos, pos + lightDir, Color32::Yellow);
-                    }
-                    */
+                    Debug::DrawAxes(meshToWorldMatrix);
                 }
+
+                /*
+                // Uncomment to visualize normals.
+                int vcount = submeshes[j]->GetVertexCount();
+                for(int k = 0; k < vcount; ++k)
+                {
+                    Matrix4 worldToMeshMatrix = Matrix4::Inverse(meshToWorldMatrix);
+                    Vector3 lightPos = worldToMeshMatrix.TransformPoint(gSceneManager.GetScene()->GetSceneData()->GetGlobalLightPosition());
+                    Vector3 lightDir = Vector3::Normalize(lightPos - submeshes[j]->GetVertexPosition(k));
+                    float dot = Vector3::Dot(submeshes[j]->GetVertexNormal(k), lightDir);
+                    Color32 color(static_cast<int>(dot * 255), 0, 0);
+
+                    Vector3 pos = submeshes[j]->GetVertexPosition(k);
+                    pos = meshToWorldMatrix.TransformPoint(pos);
+
+                    Vector3 normal = submeshes[j]->GetVertexNormal(k);
+                    normal = meshToWorldMatrix.TransformNormal(normal);
+
+                    Debug::DrawLine(pos, pos + normal, color);
+                    //Debug::DrawLine(pos, pos + lightDir, Color32::Yellow);
+                }
+                */
             }
 
             // Increase submesh index.
@@ -117,6 +114,7 @@ void MeshRenderer::SetModel(Model* model)
     // Clear any existing.
     mMeshes.clear();
     mMaterials.clear();
+    ++mMeshesVersion;
 
     // Add each mesh.
     if(model != nullptr)
@@ -137,6 +135,7 @@ void MeshRenderer::SetMesh(Mesh* mesh)
 {
     mMeshes.clear();
     mMaterials.clear();
+    ++mMeshesVersion;
     AddMesh(mesh);
 }
 
@@ -150,6 +149,7 @@ void MeshRenderer::AddMesh(Mesh* mesh)
 
 	// Add mesh to array.
 	mMeshes.push_back(mesh);
+    ++mMeshesVersion;
 	
 	// Create a material for each submesh.
 	const std::vector<Submesh*>& submeshes = mesh->GetSubmeshes();
@@ -258,6 +258,16 @@ bool MeshRenderer::Raycast(const Ray& ray, RaycastHit& hitInfo)
 }
 
 AABB MeshRenderer::GetAABB() const
+{
+    return CalculateWorldAABB(false);
+}
+
+AABB MeshRenderer::GetCullingAABB() const
+{
+    return CalculateWorldAABB(true);
+}
+
+AABB MeshRenderer::CalculateWorldAABB(bool forCulling) const
 {
     if(mMeshes.empty()) { return AABB(); }
 
@@ -267,18 +277,24 @@ AABB MeshRenderer::GetAABB() const
     {
         Matrix4 meshToWorldMatrix = GetOwner()->GetTransform()->GetLocalToWorldMatrix() * mMeshes[i]->GetMeshToLocalMatrix();
 
-        const AABB& meshAABB = mMeshes[i]->GetAABB();
-        Vector3 worldMin = meshToWorldMatrix.TransformPoint(meshAABB.GetMin());
-        Vector3 worldMax = meshToWorldMatrix.TransformPoint(meshAABB.GetMax());
-
-        if(i == 0)
+        // If the mesh is rotated, its transformed min/max points aren't necessarily the min/max of the world AABB.
+        // So, transform all eight corners of the mesh AABB, and grow to contain each one.
+        const AABB& meshAABB = forCulling ? mMeshes[i]->GetCullingAABB() : mMeshes[i]->GetAABB();
+        Vector3 min = meshAABB.GetMin();
+        Vector3 max = meshAABB.GetMax();
+        for(int corner = 0; corner < 8; ++corner)
         {
-            toReturn = AABB(worldMin, worldMax);
-        }
-        else
-        {
-            toReturn.GrowToContain(worldMin);
-            toReturn.GrowToContain(worldMax);
+            Vector3 worldCorner = meshToWorldMatrix.TransformPoint(Vector3((corner & 1) ? max.x : min.x,
+                                                                           (corner & 2) ? max.y : min.y,
+                                                                           (corner & 4) ? max.z : min.z));
+            if(i == 0 && corner == 0)
+            {
+                toReturn = AABB(worldCorner, worldCorner);
+            }
+            else
+            {
+                toReturn.GrowToContain(worldCorner);
+            }
         }
     }
     return toReturn;
@@ -16,6 +16,7 @@
 class Model;
 class Ray;
 struct RaycastHit;
+class RenderQueue;
 class Texture;
 
 class MeshRenderer : public Component
@@ -25,7 +26,8 @@ public:
     MeshRenderer(Actor* actor);
     ~MeshRenderer();
 	
-    void Render(bool opaque = true, bool translucent = true);
+    // Adds commands to draw each visible submesh to the queue.
+    void Render(RenderQueue& renderQueue);
 
     void SetShader(Shader* shader) { mShader = shader; }
 
@@ -36,6 +38,9 @@ public:
     void SetMesh(Mesh* mesh);
     void AddMesh(Mesh* mesh);
     const std::vector<Mesh*>& GetMeshes() const { return mMeshes; }
+
+    // Changes whenever the set of meshes changes - cheaper than comparing mesh lists to see if anything changed.
+    uint32_t GetMeshesVersion() const { return mMeshesVersion; }
     Mesh* GetMesh(int index) const;
 	
 	void SetMaterial(int index, Material material);
@@ -48,6 +53,10 @@ public:
 	bool Raycast(const Ray& ray, RaycastHit& hitInfo);
 
     AABB GetAABB() const;
+
+    // Like GetAABB, but also contains any vertex-animated poses - for frustum culling.
+    AABB GetCullingAABB() const;
+
     void DebugDrawAABBs(const Color32& color = Color32::White, const Color32& meshColor = Color32(255, 255, 132));
     
 private:
@@ -62,6 +71,7 @@ private:
     // A mesh component can render one or more meshes.
     // If more than one is specified, they will be rendered in order.
     std::vector<Mesh*> mMeshes;
+    uint32_t mMeshesVersion = 0;
     
     // A material describes how to render a mesh.
     // Each mesh *must have* a material!
@@ -74,4 +84,5 @@ private:
     std::bitset<kMaxSubmeshes> mSubmeshInvisible;
 
     int GetIndexFromMeshSubmeshIndexes(int meshIndex, int submeshIndex);
+    AABB CalculateWorldAABB(bool forCulling) const;
 };
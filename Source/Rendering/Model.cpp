@@ -28,9 +28,9 @@ Model::~Model()
     }
 }
 
-void Model::Load(uint8_t* data, uint32_t dataLength)
+void Model::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 }
 
 void Model::WriteToObjFile(const std::string& filePath)
@@ -140,7 +140,7 @@ void Model::WriteToObjFile(const std::string& filePath)
 	}
 }
 
-void Model::ParseFromData(uint8_t* data, uint32_t dataLength)
+void Model::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     #ifdef DEBUG_MODEL_OUTPUT
     std::cout << "MOD " << mName << std::endl;
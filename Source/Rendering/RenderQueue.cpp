@@ -0,0 +1,53 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+
+#include "Material.h"
+#include "Submesh.h"
+
+void RenderQueue::Begin(const Vector3& cameraPosition)
+{
+    mCommands.clear();
+    mSortEntries.clear();
+    mCameraPosition = cameraPosition;
+}
+
+void RenderQueue::Add(Pass pass, Material* material, Submesh* submesh, const Matrix4& objectToWorldMatrix, const Matrix4& worldToObjectMatrix)
+{
+    // Distance from camera only needs to sort correctly, so squared distance is fine.
+    float depth = (objectToWorldMatrix.GetTranslation() - mCameraPosition).GetLengthSq();
+
+    SortEntry sortEntry;
+    sortEntry.key = MakeSortKey(pass, material->GetShader(), material->GetDiffuseTexture(), depth);
+    sortEntry.index = static_cast<uint32_t>(mCommands.size());
+    mSortEntries.push_back(sortEntry);
+
+    RenderCommand command;
+    command.material = material;
+    command.submesh = submesh;
+    command.objectToWorldMatrix = objectToWorldMatrix;
+    command.worldToObjectMatrix = worldToObjectMatrix;
+    mCommands.push_back(command);
+}
+
+void RenderQueue::Sort()
+{
+    std::sort(mSortEntries.begin(), mSortEntries.end(), [](const SortEntry& a, const SortEntry& b) {
+        return a.key < b.key;
+    });
+}
+
+void RenderQueue::Submit(Pass pass)
+{
+    // Pass is in the key's top bits, so each pass's commands are together after sorting.
+    uint64_t passBits = static_cast<uint64_t>(pass) << 62;
+    for(const SortEntry& sortEntry : mSortEntries)
+    {
+        if((sortEntry.key & (3ULL << 62)) != passBits) { continue; }
+
+        // Material and GAPI skip any state that's already set, so consecutive commands with the same shader/texture are cheap.
+        RenderCommand& command = mCommands[sortEntry.index];
+        command.material->Activate(command.objectToWorldMatrix, command.worldToObjectMatrix);
+        command.submesh->Render();
+    }
+}
@@ -0,0 +1,100 @@
+//
+// Clark Kromenaker
+//
+// A queue of draw commands for a frame.
+//
+// Rather than drawing right away, renderers add commands to the queue. Commands are then sorted by a 64-bit key,
+// so draws that share a shader and texture are submitted together (fewer state changes), and opaque draws go front-to-back
+// (less overdraw) while translucent draws go back-to-front (correct blending).
+//
+// Sort key layout, from most to least significant bits:
+//      Opaque:      [pass:2][shader:14][texture:16][depth:32]
+//      Translucent: [pass:2][depth:32, inverted][shader:14][texture:16]
+// Shader and texture bits are derived from pointers - they only need to group equal values together, not be unique.
+//
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "Matrix4.h"
+#include "Vector3.h"
+
+class Material;
+class Shader;
+class Submesh;
+class Texture;
+
+class RenderQueue
+{
+public:
+    enum class Pass
+    {
+        Opaque,
+        Translucent
+    };
+
+    static uint64_t MakeSortKey(Pass pass, const Shader* shader, const Texture* texture, float depth);
+
+    // Clears last frame's commands. Depth of each command is measured from the camera position.
+    void Begin(const Vector3& cameraPosition);
+
+    // Adds a command to draw a submesh with a material. The world-to-object matrix must be the inverse of the object-to-world matrix.
+    void Add(Pass pass, Material* material, Submesh* submesh, const Matrix4& objectToWorldMatrix, const Matrix4& worldToObjectMatrix);
+
+    // Sorts the commands. Call after all commands are added, and before submitting.
+    void Sort();
+
+    // Draws all commands in a pass, in sorted order. Render state (blend, depth) for the pass should already be set.
+    void Submit(Pass pass);
+
+    uint32_t GetCommandCount() const { return static_cast<uint32_t>(mCommands.size()); }
+
+private:
+    struct RenderCommand
+    {
+        Material* material = nullptr;
+        Submesh* submesh = nullptr;
+        Matrix4 objectToWorldMatrix;
+        Matrix4 worldToObjectMatrix;
+    };
+    std::vector<RenderCommand> mCommands;
+
+    // Sort key for each command, along with the command's index.
+    // Sorting these (rather than the commands themselves) avoids moving matrices around.
+    struct SortEntry
+    {
+        uint64_t key = 0;
+        uint32_t index = 0;
+    };
+    std::vector<SortEntry> mSortEntries;
+
+    // Depth of each command is measured from here.
+    Vector3 mCameraPosition;
+};
+
+inline uint64_t RenderQueue::MakeSortKey(Pass pass, const Shader* shader, const Texture* texture, float depth)
+{
+    // For non-negative floats, the bit pattern sorts the same as the value.
+    uint32_t depthBits = 0;
+    if(depth > 0.0f)
+    {
+        memcpy(&depthBits, &depth, sizeof(depthBits));
+    }
+
+    // Pointers are at least 16-byte aligned, so ignore the lowest bits.
+    uint64_t shaderBits = (reinterpret_cast<uintptr_t>(shader) >> 4) & 0x3FFF;
+    uint64_t textureBits = (reinterpret_cast<uintptr_t>(texture) >> 4) & 0xFFFF;
+
+    uint64_t key = static_cast<uint64_t>(pass) << 62;
+    if(pass == Pass::Opaque)
+    {
+        key |= (shaderBits << 48) | (textureBits << 32) | depthBits;
+    }
+    else
+    {
+        // Farthest first.
+        key |= (static_cast<uint64_t>(~depthBits) << 30) | (shaderBits << 16) | textureBits;
+    }
+    return key;
+}
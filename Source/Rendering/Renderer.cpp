@@ -11,8 +11,10 @@
 #include "BSP.h"
 #include "Camera.h"
 #include "Debug.h"
+#include "Frustum.h"
 #include "GAPI.h"
 #include "Matrix4.h"
+#include "MemoryTracker.h"
 #include "MeshRenderer.h"
 #include "Model.h"
 #include "Profiler.h"
@@ -210,6 +212,7 @@ bool Renderer::Initialize()
 
 void Renderer::Shutdown()
 {
+    Material::Shutdown();
     GAPI::Get()->Shutdown();
     Window::Destroy();
 }
@@ -231,6 +234,8 @@ void Renderer::Clear()
 
 void Renderer::Render()
 {
+	MemoryTagScope memoryTag(MemoryTag::Rendering);
+
 	// Render camera-oriented stuff.
     Matrix4 projectionMatrix;
     Matrix4 viewMatrix;
@@ -242,6 +247,10 @@ void Renderer::Render()
         viewMatrix = mCamera->GetLookAtMatrix();
         PROFILER_END_SAMPLE();
 
+        // Anything outside this world space frustum isn't visible to the camera, so there's no need to render it.
+        Frustum frustum(projectionMatrix * viewMatrix);
+        CullingStats cullingStats;
+
         PROFILER_BEGIN_SAMPLE("Render Skybox");
         // SKYBOX RENDERING
         // Draw the skybox first, which is just a little cube around the camera.
@@ -271,19 +280,40 @@ void Renderer::Render()
         // Render opaque BSP. This should occur front-to-back, which has no overdraw.
         if(mBSP != nullptr)
         {
+            // Surfaces culled here stay culled for translucent BSP rendering later in the frame.
+            mBSP->UpdateVisibility(mCullingEnabled ? &frustum : nullptr);
+            const BSPCullingStats& bspStats = mBSP->GetCullingStats();
+            cullingStats.bspObjectsTested = bspStats.objectsTested;
+            cullingStats.bspObjectsCulled = bspStats.objectsCulled;
+            cullingStats.bspSurfacesTested = bspStats.surfacesTested;
+            cullingStats.bspSurfacesCulled = bspStats.surfacesCulled;
             mBSP->RenderOpaque(mCamera->GetOwner()->GetPosition(), mCamera->GetOwner()->GetForward());
         }
         PROFILER_END_SAMPLE();
 
         PROFILER_BEGIN_SAMPLE("Render Objects");
-        // OPAQUE MESH RENDERING
-        // Render opaque meshes (no particular order).
-        // Sorting is probably not worthwhile b/c BSP likely mostly filled the z-buffer at this point.
-        // And with the z-buffer, we can render opaque meshed correctly regardless of order.
+        // Gather draws from all meshes, and sort them.
+        mRenderQueue.Begin(mCamera->GetOwner()->GetPosition());
         for(auto& meshRenderer : mMeshRenderers)
         {
-            meshRenderer->Render();
+            // Skip mesh renderers that are entirely outside the camera's view.
+            if(mCullingEnabled && meshRenderer->IsActiveAndEnabled())
+            {
+                ++cullingStats.meshRenderersTested;
+                if(!frustum.IntersectsAABB(meshRenderer->GetCullingAABB()))
+                {
+                    ++cullingStats.meshRenderersCulled;
+                    continue;
+                }
+            }
+            meshRenderer->Render(mRenderQueue);
         }
+        mRenderQueue.Sort();
+
+        // OPAQUE MESH RENDERING
+        // Opaque meshes are sorted by shader/texture, to minimize state changes.
+        // Depth order matters less, b/c BSP likely mostly filled the z-buffer at this point.
+        mRenderQueue.Submit(RenderQueue::Pass::Opaque);
 
         // Turn off alpha test.
         Material::UseAlphaTest(false);
@@ -302,7 +332,14 @@ void Renderer::Render()
         {
             mBSP->RenderTranslucent();
         }
+
+        // TRANSLUCENT MESH RENDERING
+        // These are sorted back-to-front, so they blend correctly.
+        GAPI::Get()->SetBlendMode(GAPI::BlendMode::AlphaBlend);
+        mRenderQueue.Submit(RenderQueue::Pass::Translucent);
         PROFILER_END_SAMPLE();
+
+        mLastCullingStats = cullingStats;
     }
 
     PROFILER_BEGIN_SAMPLE("Render UI");
@@ -10,6 +10,7 @@
 
 #include "Matrix4.h"
 #include "Rect.h"
+#include "RenderQueue.h"
 #include "Vector2.h"
 #include "Window.h"
 
@@ -47,12 +48,29 @@ public:
 
     void ChangeResolution(const Window::Resolution& resolution);
 
+    // Objects outside the camera's view are culled (not rendered). Culling can be turned off to compare results.
+    struct CullingStats
+    {
+        uint32_t meshRenderersTested = 0;
+        uint32_t meshRenderersCulled = 0;
+        uint32_t bspObjectsTested = 0;
+        uint32_t bspObjectsCulled = 0;
+        uint32_t bspSurfacesTested = 0;
+        uint32_t bspSurfacesCulled = 0;
+    };
+    const CullingStats& GetLastCullingStats() const { return mLastCullingStats; }
+    void SetCullingEnabled(bool enabled) { mCullingEnabled = enabled; }
+    bool IsCullingEnabled() const { return mCullingEnabled; }
+
 private:
     // Our camera in the scene - we currently only support one.
     Camera* mCamera = nullptr;
     
     // List of mesh components to render.
     std::vector<MeshRenderer*> mMeshRenderers;
+
+    // Mesh renderers add their draws to this queue, which is sorted to minimize state changes.
+    RenderQueue mRenderQueue;
 	
     // A BSP to render.
     BSP* mBSP = nullptr;
@@ -63,6 +81,10 @@ private:
     // Global texture settings.
     bool mUseMipmaps = true;
     bool mUseTrilinearFiltering = true;
+
+    // Visibility culling settings and stats.
+    bool mCullingEnabled = true;
+    CullingStats mLastCullingStats;
 };
 
 extern Renderer gRenderer;
\ No newline at end of file
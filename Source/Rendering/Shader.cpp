@@ -3,10 +3,29 @@
 #include "GAPI.h"
 #include "TextAsset.h"
 
+const char* Shader::kFrameUniformsBlockName = "FrameUniforms";
+
 Shader::Shader(const std::string& name, TextAsset* vertShaderBytes, TextAsset* fragShaderBytes) : Asset(name)
 {
     mShaderHandle = GAPI::Get()->CreateShader(vertShaderBytes->GetText(),
                                               fragShaderBytes->GetText());
+
+    // Look up uniform locations once, up front.
+    GAPI::Get()->GetShaderUniforms(mShaderHandle, mUniforms);
+    for(const Uniform& uniform : mUniforms)
+    {
+        mUniformLocations[uniform.name] = uniform.location;
+    }
+
+    const char* kBuiltInUniformNames[] = { "gObjectToWorldMatrix", "gWorldToObjectMatrix", "gAlphaTest" };
+    static_assert(sizeof(kBuiltInUniformNames) / sizeof(kBuiltInUniformNames[0]) == static_cast<int>(BuiltInUniform::Count), "Missing built-in uniform name");
+    for(int i = 0; i < static_cast<int>(BuiltInUniform::Count); ++i)
+    {
+        mBuiltInUniformLocations[i] = GetUniformLocation(kBuiltInUniformNames[i]);
+    }
+
+    // Have the shader read per-frame uniforms from the shared buffer.
+    GAPI::Get()->SetShaderUniformBlockBinding(mShaderHandle, kFrameUniformsBlockName, kFrameUniformsBindingPoint);
 }
 
 Shader::~Shader()
@@ -19,32 +38,68 @@ void Shader::Activate()
     GAPI::Get()->ActivateShader(mShaderHandle);
 }
 
+int Shader::GetUniformLocation(const std::string& name) const
+{
+    auto it = mUniformLocations.find(name);
+    return it != mUniformLocations.end() ? it->second : -1;
+}
+
+void Shader::SetUniformInt(int location, int value)
+{
+    GAPI::Get()->SetShaderUniformInt(location, value);
+}
+
+void Shader::SetUniformFloat(int location, float value)
+{
+    GAPI::Get()->SetShaderUniformFloat(location, value);
+}
+
+void Shader::SetUniformVector3(int location, const Vector3& vector)
+{
+    GAPI::Get()->SetShaderUniformVector3(location, vector);
+}
+
+void Shader::SetUniformVector4(int location, const Vector4& vector)
+{
+    GAPI::Get()->SetShaderUniformVector4(location, vector);
+}
+
+void Shader::SetUniformMatrix4(int location, const Matrix4& mat)
+{
+    GAPI::Get()->SetShaderUniformMatrix4(location, mat);
+}
+
+void Shader::SetUniformColor(int location, const Color32& color)
+{
+    GAPI::Get()->SetShaderUniformColor(location, color);
+}
+
 void Shader::SetUniformInt(const char* name, int value)
 {
-    GAPI::Get()->SetShaderUniformInt(mShaderHandle, name, value);
+    SetUniformInt(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniformFloat(const char* name, float value)
 {
-    GAPI::Get()->SetShaderUniformFloat(mShaderHandle, name, value);
+    SetUniformFloat(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniformVector3(const char* name, const Vector3& vector)
 {
-    GAPI::Get()->SetShaderUniformVector3(mShaderHandle, name, vector);
+    SetUniformVector3(GetUniformLocation(name), vector);
 }
 
 void Shader::SetUniformVector4(const char *name, const Vector4& vector)
 {
-    GAPI::Get()->SetShaderUniformVector4(mShaderHandle, name, vector);
+    SetUniformVector4(GetUniformLocation(name), vector);
 }
 
 void Shader::SetUniformMatrix4(const char* name, const Matrix4& mat)
 {
-    GAPI::Get()->SetShaderUniformMatrix4(mShaderHandle, name, mat);
+    SetUniformMatrix4(GetUniformLocation(name), mat);
 }
 
 void Shader::SetUniformColor(const char* name, const Color32& color)
 {
-    GAPI::Get()->SetShaderUniformColor(mShaderHandle, name, color);
+    SetUniformColor(GetUniformLocation(name), color);
 }
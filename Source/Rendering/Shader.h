@@ -3,10 +3,16 @@
 //
 // A compiled and linked shader program.
 //
+// Uniform locations are looked up once, when the shader is created. After that, uniforms can be set by location,
+// which avoids a name lookup in the graphics driver every time a uniform is set.
+//
 #pragma once
 #include "Asset.h"
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class Color32;
 class Matrix4;
@@ -43,16 +49,50 @@ struct Uniform
     
     // Uniform name.
     std::string name;
+
+    // Location of the uniform in the shader program, or -1 if the shader doesn't have it.
+    int location = -1;
+};
+
+// Built-in uniforms set by the engine for every object drawn. Their locations are cached on every shader.
+enum class BuiltInUniform
+{
+    ObjectToWorldMatrix,    // gObjectToWorldMatrix
+    WorldToObjectMatrix,    // gWorldToObjectMatrix
+    AlphaTest,              // gAlphaTest
+    Count
 };
 
 class Shader : public Asset
 {
 public:
+    // Per-frame built-in uniforms (view/projection matrices) are in a uniform block, shared by all shaders.
+    // Shaders declare it as "layout(std140) uniform FrameUniforms { mat4 gViewMatrix; mat4 gProjMatrix; mat4 gWorldToProjMatrix; };"
+    static const char* kFrameUniformsBlockName;
+    static const uint32_t kFrameUniformsBindingPoint = 0;
+
     Shader(const std::string& name, TextAsset* vertShaderBytes, TextAsset* fragShaderBytes);
     ~Shader();
     
     void Activate();
-    
+
+    // Returns the location of a uniform, or -1 if this shader doesn't have it.
+    int GetUniformLocation(const std::string& name) const;
+    int GetUniformLocation(BuiltInUniform builtIn) const { return mBuiltInUniformLocations[static_cast<int>(builtIn)]; }
+    const std::vector<Uniform>& GetUniforms() const { return mUniforms; }
+
+    // Setters act on the active shader, so call Activate first.
+    void SetUniformInt(int location, int value);
+    void SetUniformFloat(int location, float value);
+
+    void SetUniformVector3(int location, const Vector3& vector);
+    void SetUniformVector4(int location, const Vector4& vector);
+
+    void SetUniformMatrix4(int location, const Matrix4& mat);
+
+    void SetUniformColor(int location, const Color32& color);
+
+    // Convenience versions that look up the location by name.
 	void SetUniformInt(const char* name, int value);
 	void SetUniformFloat(const char* name, float value);
 	
@@ -68,4 +108,11 @@ public:
 private:
     // Handle to shader in underlying graphics system.
     void* mShaderHandle = nullptr;
+
+    // The shader's uniforms (excluding any in uniform blocks), and a map from name to location.
+    std::vector<Uniform> mUniforms;
+    std::unordered_map<std::string, int> mUniformLocations;
+
+    // Cached locations of built-in uniforms.
+    int mBuiltInUniformLocations[static_cast<int>(BuiltInUniform::Count)];
 };
@@ -66,14 +66,91 @@ Texture::~Texture()
 	}
 }
 
-void Texture::Load(uint8_t* data, uint32_t dataLength)
+void Texture::Load(const AssetBuffer& data)
 {
-    BinaryReader reader(data, dataLength);
+    BinaryReader reader(data.GetData(), data.GetSize());
     ParseFromData(reader);
+
+    // Parsing sets up the transparent color, but that's part of loading - the texture still matches its source data.
+    mChanged = false;
+}
+
+bool Texture::LoadCooked(BinaryReader& reader)
+{
+    // Read size and render type.
+    uint32_t width = reader.ReadUInt();
+    uint32_t height = reader.ReadUInt();
+    RenderType renderType = static_cast<RenderType>(reader.ReadByte());
+    if(!reader.OK() || width == 0 || height == 0) { return false; }
+
+    // Read pixels, and palette data if the texture has a palette.
+    uint32_t pixelCount = width * height;
+    uint8_t* pixels = new uint8_t[pixelCount * 4];
+    bool readAll = reader.Read(pixels, pixelCount * 4) == pixelCount * 4;
+
+    uint32_t paletteSize = reader.ReadUInt();
+    uint8_t* palette = nullptr;
+    uint8_t* paletteIndexes = nullptr;
+    if(readAll && paletteSize > 0)
+    {
+        palette = new uint8_t[paletteSize];
+        paletteIndexes = new uint8_t[pixelCount];
+        readAll = reader.Read(palette, paletteSize) == paletteSize &&
+                  reader.Read(paletteIndexes, pixelCount) == pixelCount;
+    }
+
+    // If the data is incomplete, leave this texture alone.
+    if(!readAll)
+    {
+        delete[] pixels;
+        delete[] palette;
+        delete[] paletteIndexes;
+        return false;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    mRenderType = renderType;
+    mPixels = pixels;
+    mPalette = palette;
+    mPaletteSize = paletteSize;
+    mPaletteIndexes = paletteIndexes;
+    return true;
+}
+
+bool Texture::WriteCooked(BinaryWriter& writer) const
+{
+    // Nothing to cook if the texture failed to load.
+    if(mPixels == nullptr || mWidth == 0 || mHeight == 0) { return false; }
+
+    writer.WriteUInt(mWidth);
+    writer.WriteUInt(mHeight);
+    writer.WriteByte(static_cast<uint8_t>(mRenderType));
+    writer.Write(mPixels, mWidth * mHeight * 4);
+
+    // Palette indexes only exist alongside a palette.
+    if(mPalette != nullptr && mPaletteIndexes != nullptr)
+    {
+        writer.WriteUInt(mPaletteSize);
+        writer.Write(mPalette, mPaletteSize);
+        writer.Write(mPaletteIndexes, mWidth * mHeight);
+    }
+    else
+    {
+        writer.WriteUInt(0);
+    }
+    return true;
 }
 
 void Texture::Activate(uint8_t textureUnit)
 {
+    // If this texture is still loading in the background, wait for it. If it failed to load, use a placeholder.
+    if(!WaitForLoad())
+    {
+        White.Activate(textureUnit);
+        return;
+    }
+
     // Upload to GPU if dirty.
     UploadToGPU();
 
@@ -119,6 +196,7 @@ void Texture::SetPixelColor32(int x, int y, const Color32& color)
     mPixels[index + 2] = color.GetB();
     mPixels[index + 3] = color.GetA();
     mDirtyFlags |= DirtyFlags::Pixels;
+    mChanged = true;
 }
 
 Color32 Texture::GetPixelColor32(int x, int y) const
@@ -152,6 +230,7 @@ void Texture::SetPaletteIndex(int x, int y, uint8_t val)
 
     // Got it!
     mPaletteIndexes[index] = val;
+    mChanged = true;
 }
 
 uint8_t Texture::GetPaletteIndex(int x, int y) const
@@ -237,6 +316,7 @@ void Texture::Blit(Texture* source, int destX, int destY)
 	// Don't upload dest to GPU here, since we might be doing a bunch of copy operations in a row.
 	// We'll leave it up to the caller to do that manually (for now).
     dest.mDirtyFlags |= DirtyFlags::Pixels;
+    dest.mChanged = true;
 }
 
 void Texture::SetTransparentColor(const Color32& color)
@@ -262,6 +342,7 @@ void Texture::SetTransparentColor(const Color32& color)
 	
     // Mark dirty so it uploads to GPU on next use.
     mDirtyFlags |= DirtyFlags::Pixels;
+    mChanged = true;
 }
 
 void Texture::ClearTransparentColor()
@@ -277,6 +358,7 @@ void Texture::ClearTransparentColor()
 
     // Mark dirty so it uploads to GPU on next use.
     mDirtyFlags |= DirtyFlags::Pixels;
+    mChanged = true;
 }
 
 void Texture::ApplyAlphaChannel(const Texture& alphaTexture)
@@ -304,11 +386,17 @@ void Texture::ApplyAlphaChannel(const Texture& alphaTexture)
 
     // If an alpha channel is applied, we'll assume this texture is now translucent.
     mRenderType = RenderType::Translucent;
+    mChanged = true;
 }
 
 void Texture::AddDirtyFlags(DirtyFlags flags)
 {
+    // Dirty pixels mean the caller changed the pixel data directly.
     mDirtyFlags |= flags;
+    if((flags & DirtyFlags::Pixels) != DirtyFlags::None)
+    {
+        mChanged = true;
+    }
 }
 
 void Texture::UploadToGPU()
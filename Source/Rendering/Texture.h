@@ -15,6 +15,7 @@
 #include "EnumClassFlags.h"
 
 class BinaryReader;
+class BinaryWriter;
 
 class Texture : public Asset
 {
@@ -59,15 +60,24 @@ public:
     Texture(BinaryReader& reader);
 	~Texture();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
+
+    // Cooked textures store decoded RGBA pixels, so nothing needs to be decoded on load.
+    uint32_t GetCookedVersion() const override { return 1; }
+    bool LoadCooked(BinaryReader& reader) override;
+    bool WriteCooked(BinaryWriter& writer) const override;
+
+    // Any change to pixel data after loading counts (e.g. applying an alpha channel, or blending in other pixels).
+    bool IsChanged() const override { return mChanged; }
 	
 	// Activates the texture in the graphics library.
     void Activate(uint8_t textureUnit);
     static void Deactivate();
     
-    uint32_t GetWidth() const { return mWidth; }
-    uint32_t GetHeight() const { return mHeight; }
-    uint8_t* GetPixelData() const { return mPixels; }
+    // Textures may be loaded asynchronously, so accessing pixel data waits for the load to finish.
+    uint32_t GetWidth() const { WaitForLoad(); return mWidth; }
+    uint32_t GetHeight() const { WaitForLoad(); return mHeight; }
+    uint8_t* GetPixelData() const { WaitForLoad(); return mPixels; }
 	
 	RenderType GetRenderType() const { return mRenderType; }
 	
@@ -142,6 +152,9 @@ private:
     // Flags indicating that texture data in RAM is dirty, so we need to upload to GPU.
     // A newly created texture will automatically have its "dirty pixels" flag set, since we must upload pixel data before use.
     DirtyFlags mDirtyFlags = DirtyFlags::Pixels;
+
+    // Set once pixel data has been changed since the texture was loaded.
+    bool mChanged = false;
 	
 	static int CalculateBmpRowSize(unsigned short bitsPerPixel, unsigned int width);
 	
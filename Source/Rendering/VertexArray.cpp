@@ -21,6 +21,7 @@ VertexArray::~VertexArray()
         
         // Delete index data.
         delete[] mData.indexData;
+        delete[] mData.indexData32;
     }
 
     // Destroy GPU resources.
@@ -111,6 +112,17 @@ void VertexArray::Draw(GAPI::Primitive mode, uint32_t offset, uint32_t count)
     }
 }
 
+void VertexArray::DrawMulti(GAPI::Primitive mode, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount)
+{
+    // Make sure vertex buffer and index buffer are ready to go.
+    CreateVertexBuffer();
+    CreateIndexBuffer();
+    if(mIndexBuffer != nullptr)
+    {
+        GAPI::Get()->DrawMulti(mode, mVertexBuffer, mIndexBuffer, offsets, counts, rangeCount);
+    }
+}
+
 void VertexArray::ChangeVertexData(void* data)
 {
     // Save data locally.
@@ -207,6 +219,33 @@ void VertexArray::ChangeIndexData(uint16_t* indexes, uint32_t count)
     }
 }
 
+void VertexArray::ChangeIndexData(uint32_t* indexes, uint32_t count)
+{
+    // Same as above, but for 32-bit indexes.
+    if(mIndexBuffer != nullptr && mData.indexCount != count)
+    {
+        GAPI::Get()->DestroyIndexBuffer(mIndexBuffer);
+        mIndexBuffer = nullptr;
+    }
+    if(mData.indexData32 != nullptr && mData.indexCount != count)
+    {
+        assert(mData.ownsData);
+        delete[] mData.indexData32;
+        mData.indexData32 = nullptr;
+    }
+    if(mData.indexData32 == nullptr)
+    {
+        mData.indexData32 = new uint32_t[count];
+    }
+
+    mData.indexCount = count;
+    memcpy(mData.indexData32, indexes, count * sizeof(uint32_t));
+    if(mIndexBuffer != nullptr)
+    {
+        GAPI::Get()->SetIndexBufferData(mIndexBuffer, mData.indexCount, mData.indexData32);
+    }
+}
+
 void VertexArray::CreateVertexBuffer()
 {
     // Already got one? Don't need to create another one.
@@ -254,11 +293,18 @@ void VertexArray::CreateIndexBuffer()
     }
 
     // No need if index data is empty or count is zero.
-    if(mData.indexData == nullptr || mData.indexCount <= 0)
+    if((mData.indexData == nullptr && mData.indexData32 == nullptr) || mData.indexCount <= 0)
     {
         return;
     }
 
     // Create the index buffer.
-    mIndexBuffer = GAPI::Get()->CreateIndexBuffer(mData.indexCount, mData.indexData, mData.meshUsage);
+    if(mData.indexData32 != nullptr)
+    {
+        mIndexBuffer = GAPI::Get()->CreateIndexBuffer(mData.indexCount, mData.indexData32, mData.meshUsage);
+    }
+    else
+    {
+        mIndexBuffer = GAPI::Get()->CreateIndexBuffer(mData.indexCount, mData.indexData, mData.meshUsage);
+    }
 }
@@ -45,6 +45,9 @@ public:
     void Draw(GAPI::Primitive mode);
     void Draw(GAPI::Primitive mode, uint32_t offset, uint32_t count);
 
+    // Draws several index ranges with one draw call. Requires index data.
+    void DrawMulti(GAPI::Primitive mode, const uint32_t* offsets, const uint32_t* counts, uint32_t rangeCount);
+
     unsigned int GetVertexCount() const { return mData.vertexCount; }
     unsigned int GetIndexCount() const { return mData.indexCount; }
 
@@ -53,6 +56,7 @@ public:
 
     void ChangeIndexData(uint16_t* indexes);
     void ChangeIndexData(uint16_t* indexes, uint32_t count);
+    void ChangeIndexData(uint32_t* indexes, uint32_t count);
     
 private:
     // Mesh data (vertices, normals, indexes, etc).
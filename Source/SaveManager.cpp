@@ -9,10 +9,12 @@ SaveManager::SaveManager()
 {
     std::string prefsPath = Paths::GetSaveDataPath("Prefs.ini");
 
-    uint32_t bufferSize = 0;
-    uint8_t* buffer = File::ReadIntoBuffer(prefsPath, bufferSize);
+    // The file is mapped while loading - make sure the mapping is released before saving over the file below.
     mPrefs = new Config("Prefs.ini", AssetScope::Manual);
-    mPrefs->Load(buffer, bufferSize);
+    {
+        AssetBuffer buffer = AssetBuffer::MakeFromFile(prefsPath);
+        mPrefs->Load(buffer);
+    }
 
     // Increment run count.
     int runCount = mPrefs->GetInt("App", "Run Count", 0);
@@ -1,6 +1,7 @@
 #include "SheepAPI_Assets.h"
 
 #include "AssetManager.h"
+#include "ReportManager.h"
 
 using namespace std;
 
@@ -11,11 +12,11 @@ shpvoid AddPath(const std::string& pathName)
 }
 RegFunc1(AddPath, void, string, IMMEDIATE, DEV_FUNC);
 
-/*
 shpvoid FullScanPaths()
 {
     // Scans and indexes assets on all search paths.
     // Really only useful when dealing with loose files.
+    gAssetManager.RescanSearchPaths();
     return 0;
 }
 RegFunc0(FullScanPaths, void, IMMEDIATE, DEV_FUNC);
@@ -23,10 +24,11 @@ RegFunc0(FullScanPaths, void, IMMEDIATE, DEV_FUNC);
 shpvoid RescanPaths()
 {
     // Same as full scan paths, but dumps any existing indexes as well.
+    // Our scan always starts from scratch, so these are one and the same.
+    gAssetManager.RescanSearchPaths();
     return 0;
 }
 RegFunc0(RescanPaths, void, IMMEDIATE, DEV_FUNC);
-*/
 
 shpvoid Extract(const std::string& fileSpec, const std::string& outputPath)
 {
@@ -47,6 +49,14 @@ shpvoid Extract(const std::string& fileSpec, const std::string& outputPath)
 }
 RegFunc2(Extract, void, string, string, IMMEDIATE, REL_FUNC);
 
+shpvoid DumpAssetLoadReport()
+{
+    // Shows where time went while loading assets for the current scene (or at startup, if no scene has loaded yet).
+    gReportManager.Log("Dump", gAssetManager.GetLoadReport().ToString());
+    return 0;
+}
+RegFunc0(DumpAssetLoadReport, void, IMMEDIATE, DEV_FUNC);
+
 shpvoid NeedDiscResources(int discNum)
 {
     // In the original game, this would check that all the resources from disk 1/2/3 were loaded.
@@ -42,5 +42,8 @@ shpvoid Edit(const std::string& fileName); // DEV
 shpvoid Open(const std::string& fileName); // DEV
 shpvoid OpenFile(const std::string& fileName); // DEV
 
+// ASSET LOAD REPORTS
+shpvoid DumpAssetLoadReport(); // DEV
+
 // MISC
 shpvoid NeedDiscResources(int discNum);
@@ -1,7 +1,14 @@
 #include "SheepAPI_Debug.h"
 
 #include "Debug.h"
+#include "FrameAllocator.h"
 #include "LayerManager.h"
+#include "MemoryTracker.h"
+#include "ObjectPool.h"
+#include "Paths.h"
+#include "Profiler.h"
+#include "ReportManager.h"
+#include "StringUtil.h"
 
 using namespace std;
 
@@ -39,9 +46,63 @@ shpvoid DumpDebugFlags()
 }
 RegFunc0(DumpDebugFlags, void, IMMEDIATE, DEV_FUNC);
 
+shpvoid DumpMemoryUsage()
+{
+    std::string frameStats = StringUtil::Format("Frame memory: %.1f KB capacity, %.1f KB last frame, %.1f KB peak, %u overflows",
+                                                FrameAllocator::GetCapacity() / 1024.0f,
+                                                FrameAllocator::GetLastFrameAllocatedSize() / 1024.0f,
+                                                FrameAllocator::GetPeakAllocatedSize() / 1024.0f,
+                                                FrameAllocator::GetOverflowCount());
+    gReportManager.Log("Dump", MemoryTracker::Dump() + "\n" + frameStats + "\n" + ObjectPool::DumpAll());
+    return 0;
+}
+RegFunc0(DumpMemoryUsage, void, IMMEDIATE, DEV_FUNC);
+
+shpvoid SetMemoryCallSiteTracking(int enabled)
+{
+    // Start from a clean slate each time tracking is turned on, so results reflect what happened since.
+    if(enabled != 0 && !MemoryTracker::IsCallSiteTrackingEnabled())
+    {
+        MemoryTracker::ClearCallSites();
+    }
+    MemoryTracker::SetCallSiteTrackingEnabled(enabled != 0);
+    return 0;
+}
+RegFunc1(SetMemoryCallSiteTracking, void, int, IMMEDIATE, DEV_FUNC);
+
 shpvoid DumpLayerStack()
 {
     gLayerManager.DumpLayerStack();
     return 0;
 }
-RegFunc0(DumpLayerStack, void, IMMEDIATE, DEV_FUNC);
\ No newline at end of file
+RegFunc0(DumpLayerStack, void, IMMEDIATE, DEV_FUNC);
+
+shpvoid SetProfilerEnabled(int enabled)
+{
+    Profiler::SetEnabled(enabled != 0);
+    return 0;
+}
+RegFunc1(SetProfilerEnabled, void, int, IMMEDIATE, DEV_FUNC);
+
+shpvoid BeginProfilerCapture()
+{
+    Profiler::BeginCapture();
+    return 0;
+}
+RegFunc0(BeginProfilerCapture, void, IMMEDIATE, DEV_FUNC);
+
+shpvoid EndProfilerCapture(const std::string& filename)
+{
+    // Captures are saved as Chrome trace files, alongside save data (since that's always writable).
+    std::string filePath = Paths::GetSaveDataPath(filename.empty() ? "Trace.json" : filename);
+    if(Profiler::EndCapture(filePath))
+    {
+        gReportManager.Log("Dump", "Saved profiler capture to " + filePath);
+    }
+    else
+    {
+        ExecError();
+    }
+    return 0;
+}
+RegFunc1(EndProfilerCapture, void, string, IMMEDIATE, DEV_FUNC);
\ No newline at end of file
@@ -18,12 +18,17 @@ shpvoid UnbindDebugKey(const std::string& keyName);
 shpvoid DumpFile(const std::string& filename);
 shpvoid DumpLockedObjects();
 shpvoid DumpMemoryUsage();
+shpvoid SetMemoryCallSiteTracking(int enabled); // DEV
 shpvoid DumpPathFileMap();
 shpvoid DumpUsedPaths();
 shpvoid DumpUsedFiles();
 shpvoid DumpLayerStack(); // DEV
 shpvoid DumpBuildInfo(); // DEV
 
+shpvoid SetProfilerEnabled(int enabled); // DEV
+shpvoid BeginProfilerCapture(); // DEV
+shpvoid EndProfilerCapture(const std::string& filename); // DEV
+
 shpvoid ReportMemoryUsage();
 shpvoid ReportSurfaceMemoryUsage();
 
@@ -3,7 +3,9 @@
 #include <iostream>
 
 #include "BinaryReader.h"
+#include "FrameAllocator.h"
 #include "GMath.h"
+#include "MemoryTracker.h"
 #include "ReportManager.h"
 #include "SheepScript.h"
 #include "SheepSysFunc.h"
@@ -50,15 +52,15 @@ SheepVM::~SheepVM()
 {
 	for(auto& instance : mSheepInstances)
 	{
-		delete instance;
+		mSheepInstancePool.Delete(instance);
 	}
 	for(auto& thread : mSheepThreads)
 	{
-		delete thread;
+		mSheepThreadPool.Delete(thread);
 	}
     for(auto& notifyLink : mNotifyLinks)
     {
-        delete notifyLink;
+        mNotifyLinkPool.Delete(notifyLink);
     }
 }
 
@@ -224,7 +226,7 @@ SheepInstance* SheepVM::GetInstance(SheepScript* script)
 	// Create a new instance if we have to.
 	if(context == nullptr)
 	{
-		context = new SheepInstance();
+		context = mSheepInstancePool.New<SheepInstance>();
 		mSheepInstances.push_back(context);
 	}
 
@@ -253,7 +255,7 @@ SheepThread* SheepVM::GetIdleThread()
 	// If needed, create a new thread instead.
 	if(useThread == nullptr)
 	{
-		useThread = new SheepThread();
+		useThread = mSheepThreadPool.New<SheepThread>();
 		useThread->mVirtualMachine = this;
 		mSheepThreads.push_back(useThread);
 	}
@@ -281,7 +283,7 @@ NotifyLink* SheepVM::GetNotifyLink()
     // Create a new one if needed.
     if(toUse == nullptr)
     {
-        toUse = new NotifyLink();
+        toUse = mNotifyLinkPool.New<NotifyLink>();
         mNotifyLinks.push_back(toUse);
     }
     return toUse;
@@ -304,7 +306,9 @@ Value SheepVM::CallSysFunc(SheepThread* thread, SysFuncImport* sysImport)
 	assert(argCount == sysFunc->argumentTypes.size());
 	
 	// Retrieve the arguments, of the expected types, from the stack.
-	std::vector<Value> args;
+	// Sheep makes a LOT of sys func calls, so the args use frame memory to avoid a heap allocation per call.
+	FrameVector<Value> args;
+	args.reserve(argCount);
 	for(int i = 0; i < argCount; i++)
 	{
 		SheepValue& sheepValue = thread->mStack.Peek(argCount - 1 - i);
@@ -431,6 +435,8 @@ SheepThread* SheepVM::StartExecution(SheepInstance* instance, int bytecodeOffset
 
 void SheepVM::ContinueExecution(SheepThread* thread)
 {
+	MemoryTagScope memoryTag(MemoryTag::Sheep);
+
 	// Store previous thread and set passed in thread as the currently executing thread.
 	SheepThread* prevThread = mCurrentThread;
 	mCurrentThread = thread;
@@ -9,6 +9,7 @@
 #include <vector>
 #include <iostream>
 
+#include "ObjectPool.h"
 #include "Profiler.h"
 #include "SheepThread.h"
 #include "SheepValue.h"
@@ -136,6 +137,11 @@ public:
 	bool IsAnyThreadRunning() const;
 
 private:
+    // Instances, threads, and notify links are recycled, but new ones come from pools, so they're close together in memory.
+    ObjectPool mSheepInstancePool { "SheepInstance", sizeof(SheepInstance), alignof(SheepInstance), 16 };
+    ObjectPool mSheepThreadPool { "SheepThread", sizeof(SheepThread), alignof(SheepThread), 16 };
+    ObjectPool mNotifyLinkPool { "NotifyLink", sizeof(NotifyLink), alignof(NotifyLink), 32 };
+
     // Instances of SheepScripts that have been created for execution.
 	std::vector<SheepInstance*> mSheepInstances;
 
@@ -1,24 +1,28 @@
 #include "SheepManager.h"
 
 #include "LayerManager.h"
+#include "MemoryTracker.h"
 #include "StringUtil.h"
 
 SheepManager gSheepManager;
 
 SheepScript* SheepManager::Compile(const char* filePath)
 {
+    MemoryTagScope memoryTag(MemoryTag::Sheep);
     SheepCompiler compiler;
     return compiler.CompileToAsset(filePath);
 }
 
 SheepScript* SheepManager::Compile(const std::string& name, const std::string& sheep)
 {
+    MemoryTagScope memoryTag(MemoryTag::Sheep);
     SheepCompiler compiler;
     return compiler.CompileToAsset(name, sheep);
 }
 
 SheepScript* SheepManager::Compile(const std::string& name, std::istream& stream)
 {
+    MemoryTagScope memoryTag(MemoryTag::Sheep);
     SheepCompiler compiler;
     return compiler.CompileToAsset(name, stream);
 }
@@ -5,12 +5,13 @@
 #include <fstream>
 
 #include "BinaryReader.h"
+#include "BinaryWriter.h"
 #include "mstream.h"
 #include "SheepManager.h"
 #include "SheepScriptBuilder.h"
 #include "StringUtil.h"
 
-/*static*/ bool SheepScript::IsSheepDataCompiled(uint8_t* data, uint32_t dataLength)
+/*static*/ bool SheepScript::IsSheepDataCompiled(const uint8_t* data, uint32_t dataLength)
 {
     // If the first 8 bytes of the data is GK3Sheep, we'll assume this is valid compiled Sheepscript data.
     // Otherwise, it may be a text-based (uncompiled) Sheepscript, or some other data entirely.
@@ -27,18 +28,18 @@ SheepScript::~SheepScript()
     delete[] mBytecode;
 }
 
-void SheepScript::Load(uint8_t* data, uint32_t dataLength)
+void SheepScript::Load(const AssetBuffer& data)
 {
     // If the data is already compiled, we can just parse it directly.
-    if(IsSheepDataCompiled(data, dataLength))
+    if(IsSheepDataCompiled(data.GetData(), data.GetSize()))
     {
-        ParseFromData(data, dataLength);
+        ParseFromData(data.GetData(), data.GetSize());
         return;
     }
 
     // If the data is in uncompiled text format, we must compile it!
     SheepCompiler compiler;
-    imstream stream(reinterpret_cast<char*>(data), dataLength);
+    imstream stream(reinterpret_cast<const char*>(data.GetData()), data.GetSize());
     if(compiler.Compile(GetNameNoExtension(), stream))
     {
         Load(compiler.GetCompiledBuilder());
@@ -59,6 +60,115 @@ void SheepScript::Load(const SheepScriptBuilder& builder)
     std::copy(builder.GetBytecode().begin(), builder.GetBytecode().end(), mBytecode);
 }
 
+bool SheepScript::LoadCooked(BinaryReader& reader)
+{
+    // SysFunc imports.
+    std::vector<SysFuncImport> sysImports(reader.ReadUInt());
+    for(SysFuncImport& import : sysImports)
+    {
+        reader.ReadString16(import.name);
+        import.returnType = reader.ReadSByte();
+        import.argumentTypes.resize(reader.ReadByte());
+        for(char& argumentType : import.argumentTypes)
+        {
+            argumentType = reader.ReadSByte();
+        }
+    }
+
+    // String constants.
+    std::unordered_map<int, std::string> stringConsts;
+    uint32_t stringConstCount = reader.ReadUInt();
+    for(uint32_t i = 0; i < stringConstCount; ++i)
+    {
+        int offset = reader.ReadInt();
+        reader.ReadString32(stringConsts[offset]);
+    }
+
+    // Variables. Like compiled sheep data, string variables have no default value.
+    std::vector<SheepValue> variables(reader.ReadUInt());
+    for(SheepValue& variable : variables)
+    {
+        variable.type = static_cast<SheepValueType>(reader.ReadByte());
+        variable.intValue = reader.ReadInt();
+        if(variable.type == SheepValueType::String)
+        {
+            variable.stringValue = nullptr;
+        }
+    }
+
+    // Functions.
+    std::string_map_ci<int> functions;
+    uint32_t functionCount = reader.ReadUInt();
+    for(uint32_t i = 0; i < functionCount; ++i)
+    {
+        std::string name;
+        reader.ReadString16(name);
+        functions[name] = reader.ReadInt();
+    }
+
+    // Bytecode.
+    int bytecodeLength = reader.ReadInt();
+    if(!reader.OK() || bytecodeLength <= 0) { return false; }
+    char* bytecode = new char[bytecodeLength];
+    if(reader.Read(bytecode, bytecodeLength) != static_cast<uint32_t>(bytecodeLength))
+    {
+        delete[] bytecode;
+        return false;
+    }
+
+    mSysImports = std::move(sysImports);
+    mStringConsts = std::move(stringConsts);
+    mVariables = std::move(variables);
+    mFunctions = std::move(functions);
+    mBytecode = bytecode;
+    mBytecodeLength = bytecodeLength;
+    return true;
+}
+
+bool SheepScript::WriteCooked(BinaryWriter& writer) const
+{
+    // Nothing to cook if the script failed to compile.
+    if(mBytecode == nullptr || mBytecodeLength <= 0) { return false; }
+
+    writer.WriteUInt(static_cast<uint32_t>(mSysImports.size()));
+    for(const SysFuncImport& import : mSysImports)
+    {
+        writer.WriteShortString(import.name);
+        writer.WriteSByte(import.returnType);
+        writer.WriteByte(static_cast<uint8_t>(import.argumentTypes.size()));
+        for(char argumentType : import.argumentTypes)
+        {
+            writer.WriteSByte(argumentType);
+        }
+    }
+
+    writer.WriteUInt(static_cast<uint32_t>(mStringConsts.size()));
+    for(const auto& entry : mStringConsts)
+    {
+        writer.WriteInt(entry.first);
+        writer.WriteMedString(entry.second);
+    }
+
+    // Int and float values are both 4 bytes, so one write covers either.
+    writer.WriteUInt(static_cast<uint32_t>(mVariables.size()));
+    for(const SheepValue& variable : mVariables)
+    {
+        writer.WriteByte(static_cast<uint8_t>(variable.type));
+        writer.WriteInt(variable.type == SheepValueType::String ? 0 : variable.intValue);
+    }
+
+    writer.WriteUInt(static_cast<uint32_t>(mFunctions.size()));
+    for(const auto& entry : mFunctions)
+    {
+        writer.WriteShortString(entry.first);
+        writer.WriteInt(entry.second);
+    }
+
+    writer.WriteInt(mBytecodeLength);
+    writer.Write(mBytecode, mBytecodeLength);
+    return true;
+}
+
 SysFuncImport* SheepScript::GetSysImport(int index)
 {
     if(index < 0 || index >= mSysImports.size()) { return nullptr; }
@@ -106,7 +216,7 @@ void SheepScript::Dump()
     std::cout << "--------------------------------------------------------------------------" << std::endl;
 }
 
-void SheepScript::ParseFromData(uint8_t* data, uint32_t dataLength)
+void SheepScript::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
     BinaryReader reader(data, dataLength);
     
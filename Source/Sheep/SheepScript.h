@@ -15,20 +15,26 @@
 #include "StringUtil.h"
 
 class BinaryReader;
+class BinaryWriter;
 class SheepScriptBuilder;
 
 class SheepScript : public Asset
 {
 public:
-    static bool IsSheepDataCompiled(uint8_t* data, uint32_t dataLength);
+    static bool IsSheepDataCompiled(const uint8_t* data, uint32_t dataLength);
 
     SheepScript(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     SheepScript(const std::string& name, SheepScriptBuilder& builder);
     ~SheepScript();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
     void Load(const SheepScriptBuilder& builder);
 
+    // Cooked sheep are already compiled and flattened, so text sheep needn't be recompiled on every launch.
+    uint32_t GetCookedVersion() const override { return 1; }
+    bool LoadCooked(BinaryReader& reader) override;
+    bool WriteCooked(BinaryWriter& writer) const override;
+
     SysFuncImport* GetSysImport(int index);
     
     std::string* GetStringConst(int offset);
@@ -64,7 +70,7 @@ private:
     char* mBytecode = nullptr;
     int mBytecodeLength = 0;
     
-    void ParseFromData(uint8_t* data, uint32_t dataLength);
+    void ParseFromData(const uint8_t* data, uint32_t dataLength);
     void ParseSysImportsSection(BinaryReader& reader);
     void ParseStringConstsSection(BinaryReader& reader);
     void ParseVariablesSection(BinaryReader& reader);
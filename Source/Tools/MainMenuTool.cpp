@@ -62,6 +62,14 @@ void MainMenuTool::Render()
             {
                 hierarchyToolActive = !hierarchyToolActive;
             }
+            if(ImGui::MenuItem("Memory", nullptr, memoryToolActive))
+            {
+                memoryToolActive = !memoryToolActive;
+            }
+            if(ImGui::MenuItem("Profiler", nullptr, profilerToolActive))
+            {
+                profilerToolActive = !profilerToolActive;
+            }
             ImGui::EndMenu();
         }
 
@@ -0,0 +1,99 @@
+#include "MemoryTool.h"
+
+#include <imgui.h>
+
+#include "FrameAllocator.h"
+#include "MemoryTracker.h"
+#include "ObjectPool.h"
+
+void MemoryTool::Render(bool& toolActive)
+{
+    if(!toolActive) { return; }
+
+    // Sets the default size of the memory window on first open.
+    ImGui::SetNextWindowSize(ImVec2(520, 420), ImGuiCond_FirstUseEver);
+
+    // Begin the memory window. Early out if collapsed.
+    if(!ImGui::Begin("Memory", &toolActive))
+    {
+        ImGui::End();
+        return;
+    }
+
+    // Heap usage per tag, with a final row for totals.
+    const int kTagCount = static_cast<int>(MemoryTag::Count);
+    if(ImGui::BeginTable("Tags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+    {
+        ImGui::TableSetupColumn("Tag");
+        ImGui::TableSetupColumn("Current KB");
+        ImGui::TableSetupColumn("Peak KB");
+        ImGui::TableSetupColumn("Live");
+        ImGui::TableSetupColumn("Allocs");
+        ImGui::TableSetupColumn("Last Frame");
+        ImGui::TableHeadersRow();
+        for(int i = 0; i <= kTagCount; ++i)
+        {
+            bool totalRow = i == kTagCount;
+            MemoryTracker::TagStats stats = totalRow ? MemoryTracker::GetTotalStats() : MemoryTracker::GetTagStats(static_cast<MemoryTag>(i));
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(totalRow ? "Total" : MemoryTracker::GetTagName(static_cast<MemoryTag>(i)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", stats.currentBytes / 1024.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", stats.peakBytes / 1024.0f);
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", stats.currentAllocations);
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(stats.totalAllocations));
+            ImGui::TableNextColumn();
+            ImGui::Text("%u", stats.lastFrameAllocations);
+        }
+        ImGui::EndTable();
+    }
+
+    // Frame memory usage.
+    ImGui::Text("Frame memory: %.1f KB last frame, %.1f KB peak, %.1f KB capacity, %u overflows",
+                FrameAllocator::GetLastFrameAllocatedSize() / 1024.0f, FrameAllocator::GetPeakAllocatedSize() / 1024.0f,
+                FrameAllocator::GetCapacity() / 1024.0f, FrameAllocator::GetOverflowCount());
+
+    // Object pool usage.
+    if(ImGui::CollapsingHeader("Object Pools"))
+    {
+        ImGui::TextUnformatted(ObjectPool::DumpAll().c_str());
+    }
+
+    // Allocation call sites, if tracking is on.
+    if(ImGui::CollapsingHeader("Call Sites"))
+    {
+        bool trackCallSites = MemoryTracker::IsCallSiteTrackingEnabled();
+        if(ImGui::Checkbox("Track Call Sites", &trackCallSites))
+        {
+            if(trackCallSites)
+            {
+                MemoryTracker::ClearCallSites();
+            }
+            MemoryTracker::SetCallSiteTrackingEnabled(trackCallSites);
+        }
+        if(trackCallSites && ImGui::BeginTable("CallSites", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Address");
+            ImGui::TableSetupColumn("Allocs");
+            ImGui::TableSetupColumn("KB");
+            ImGui::TableHeadersRow();
+            for(const MemoryTracker::CallSite& site : MemoryTracker::GetTopCallSites(20))
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%p", site.address);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(site.allocations));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", site.bytes / 1024.0f);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
@@ -0,0 +1,12 @@
+//
+// Clark Kromenaker
+//
+// A tool that shows heap memory usage by subsystem, plus frame memory and object pool usage.
+//
+#pragma once
+
+class MemoryTool
+{
+public:
+    void Render(bool& toolActive);
+};
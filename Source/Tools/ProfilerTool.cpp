@@ -0,0 +1,195 @@
+#include "ProfilerTool.h"
+
+#include <climits>
+#include <cstdint>
+
+#include <imgui.h>
+
+#include "MemoryTracker.h"
+#include "Paths.h"
+
+void ProfilerTool::Update(float deltaTime)
+{
+    UpdateFrameInfo(deltaTime);
+}
+
+void ProfilerTool::Render(bool& toolActive)
+{
+    if(!toolActive) { return; }
+
+    // Sets the default size of the profiler window on first open.
+    ImGui::SetNextWindowSize(ImVec2(480, 600), ImGuiCond_FirstUseEver);
+
+    // Begin the profiler window. Early out if collapsed.
+    if(!ImGui::Begin("Profiler", &toolActive))
+    {
+        ImGui::End();
+        return;
+    }
+
+    // Frame time graph, with average and max over the graphed frames.
+    float totalMs = 0.0f;
+    float maxMs = 0.0f;
+    for(float frameTime : mFrameTimes)
+    {
+        totalMs += frameTime;
+        maxMs = frameTime > maxMs ? frameTime : maxMs;
+    }
+    char overlay[64];
+    snprintf(overlay, sizeof(overlay), "avg %.2f ms, max %.2f ms", totalMs / kFrameTimeCount, maxMs);
+    ImGui::PlotLines("##FrameTimes", mFrameTimes, kFrameTimeCount, mFrameTimeOffset, overlay, 0.0f, maxMs > 33.3f ? maxMs : 33.3f,
+                     ImVec2(ImGui::GetContentRegionAvail().x, 80.0f));
+
+    // Profiler controls. Scope timings are only available while the profiler is enabled.
+    bool enabled = Profiler::IsEnabled();
+    if(ImGui::Checkbox("Profile Scopes", &enabled))
+    {
+        Profiler::SetEnabled(enabled);
+    }
+    ImGui::SameLine();
+    if(!Profiler::IsCapturing())
+    {
+        if(ImGui::Button("Begin Capture"))
+        {
+            Profiler::BeginCapture();
+        }
+    }
+    else if(ImGui::Button("End Capture"))
+    {
+        Profiler::EndCapture(Paths::GetSaveDataPath("Trace.json"));
+    }
+
+    // Turning culling off shows how much it's saving.
+    bool cullingEnabled = gRenderer.IsCullingEnabled();
+    if(ImGui::Checkbox("Frustum Culling", &cullingEnabled))
+    {
+        gRenderer.SetCullingEnabled(cullingEnabled);
+    }
+
+    // Last frame.
+    if(ImGui::CollapsingHeader("Last Frame", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::PushID("LastFrame");
+        RenderFrameInfo(mLastFrame);
+        ImGui::PopID();
+    }
+
+    // Worst frame.
+    if(ImGui::CollapsingHeader("Worst Frame"))
+    {
+        if(ImGui::Button("Reset Worst Frame"))
+        {
+            mWorstFrame = FrameInfo();
+        }
+        ImGui::PushID("WorstFrame");
+        RenderFrameInfo(mWorstFrame);
+        ImGui::PopID();
+    }
+
+    // Asset residency.
+    if(ImGui::CollapsingHeader("Asset Residency"))
+    {
+        RenderResidency(gAssetManager.GetResidencyStats());
+    }
+    ImGui::End();
+}
+
+void ProfilerTool::UpdateFrameInfo(float deltaTime)
+{
+    // Profiler frame samples include the whole frame - use those when available, since they're the most accurate.
+    const std::vector<Profiler::FrameSample>& samples = Profiler::GetLastFrameSamples();
+    float frameMs = !samples.empty() ? samples.front().durationMs : deltaTime * 1000.0f;
+
+    mFrameTimes[mFrameTimeOffset] = frameMs;
+    mFrameTimeOffset = (mFrameTimeOffset + 1) % kFrameTimeCount;
+
+    mLastFrame.frameNumber = Profiler::GetFrameNumber();
+    mLastFrame.frameMs = frameMs;
+    mLastFrame.allocations = MemoryTracker::GetTotalStats().lastFrameAllocations;
+    mLastFrame.renderStats = GAPI::Get()->GetLastFrameStats();
+    mLastFrame.cullingStats = gRenderer.GetLastCullingStats();
+    mLastFrame.samples = samples;
+
+    // Keep a copy of the worst frame.
+    if(mLastFrame.frameMs > mWorstFrame.frameMs)
+    {
+        mWorstFrame = mLastFrame;
+    }
+}
+
+void ProfilerTool::RenderFrameInfo(const FrameInfo& frameInfo)
+{
+    ImGui::Text("Frame %llu: %.2f ms", static_cast<unsigned long long>(frameInfo.frameNumber), frameInfo.frameMs);
+    ImGui::Text("Heap allocations: %u", frameInfo.allocations);
+
+    const GAPI::FrameStats& renderStats = frameInfo.renderStats;
+    ImGui::Text("Draw calls: %u (%u vertices)", renderStats.drawCalls, renderStats.vertexCount);
+    ImGui::Text("Shader changes: %u, texture changes: %u, state changes: %u (%u redundant skipped)", renderStats.shaderChanges,
+                renderStats.textureChanges, renderStats.stateChanges, renderStats.skippedStateChanges);
+    ImGui::Text("Uniform changes: %u, buffer uploads: %u", renderStats.uniformChanges, renderStats.bufferUploads);
+
+    const Renderer::CullingStats& cullingStats = frameInfo.cullingStats;
+    ImGui::Text("Culled: %u/%u mesh renderers, %u/%u BSP objects, %u/%u BSP surfaces",
+                cullingStats.meshRenderersCulled, cullingStats.meshRenderersTested,
+                cullingStats.bspObjectsCulled, cullingStats.bspObjectsTested,
+                cullingStats.bspSurfacesCulled, cullingStats.bspSurfacesTested);
+
+    if(frameInfo.samples.empty())
+    {
+        ImGui::TextDisabled("Enable \"Profile Scopes\" to see where frame time goes.");
+    }
+    else
+    {
+        RenderSampleTree(frameInfo.samples);
+    }
+}
+
+void ProfilerTool::RenderSampleTree(const std::vector<Profiler::FrameSample>& samples)
+{
+    // Samples are in the order they began, so a sample's children directly follow it (with greater depth).
+    // Track how many tree nodes are open, and skip over the children of collapsed nodes.
+    int openDepth = 0;
+    int skipDepth = INT_MAX;
+    for(size_t i = 0; i < samples.size(); ++i)
+    {
+        const Profiler::FrameSample& sample = samples[i];
+        if(sample.depth > skipDepth) { continue; }
+        skipDepth = INT_MAX;
+
+        // Close nodes until we're back at this sample's depth.
+        while(openDepth > sample.depth)
+        {
+            ImGui::TreePop();
+            --openDepth;
+        }
+
+        bool hasChildren = i + 1 < samples.size() && samples[i + 1].depth > sample.depth;
+        ImGuiTreeNodeFlags flags = hasChildren ? ImGuiTreeNodeFlags_DefaultOpen : (ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen);
+        bool open = ImGui::TreeNodeEx(reinterpret_cast<void*>(static_cast<intptr_t>(i)), flags, "%s: %.3f ms", sample.name, sample.durationMs);
+        if(hasChildren)
+        {
+            if(open)
+            {
+                openDepth = sample.depth + 1;
+            }
+            else
+            {
+                skipDepth = sample.depth;
+            }
+        }
+    }
+    while(openDepth > 0)
+    {
+        ImGui::TreePop();
+        --openDepth;
+    }
+}
+
+void ProfilerTool::RenderResidency(const AssetManager::ResidencyStats& stats)
+{
+    ImGui::Text("Resident assets: %zu (%.1f MB)", stats.residentCount, stats.residentBytes / (1024.0f * 1024.0f));
+    ImGui::Text("Retained assets: %zu (%.1f MB of %.1f MB budget)", stats.retainedCount, stats.retainedBytes / (1024.0f * 1024.0f),
+                stats.budgetBytes / (1024.0f * 1024.0f));
+    float budgetFraction = stats.budgetBytes > 0 ? static_cast<float>(stats.retainedBytes) / stats.budgetBytes : 0.0f;
+    ImGui::ProgressBar(budgetFraction > 1.0f ? 1.0f : budgetFraction);
+}
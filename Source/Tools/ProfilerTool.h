@@ -0,0 +1,47 @@
+//
+// Clark Kromenaker
+//
+// A tool that shows frame times, where frame time is spent, and per-frame counts (allocations, draw calls, etc).
+// Also keeps the worst frame seen, so spikes can be looked at after the fact.
+//
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "AssetManager.h"
+#include "GAPI.h"
+#include "Profiler.h"
+#include "Renderer.h"
+
+class ProfilerTool
+{
+public:
+    void Update(float deltaTime);
+    void Render(bool& toolActive);
+
+private:
+    // Recent frame times, in milliseconds. Oldest frame time is at the offset.
+    static const int kFrameTimeCount = 240;
+    float mFrameTimes[kFrameTimeCount] = { 0.0f };
+    int mFrameTimeOffset = 0;
+
+    // Everything known about a single frame.
+    struct FrameInfo
+    {
+        uint64_t frameNumber = 0;
+        float frameMs = 0.0f;
+        uint32_t allocations = 0;
+        GAPI::FrameStats renderStats;
+        Renderer::CullingStats cullingStats;
+        std::vector<Profiler::FrameSample> samples;
+    };
+
+    // The last frame, and the worst frame since the worst frame was last reset.
+    FrameInfo mLastFrame;
+    FrameInfo mWorstFrame;
+
+    void UpdateFrameInfo(float deltaTime);
+    void RenderFrameInfo(const FrameInfo& frameInfo);
+    void RenderSampleTree(const std::vector<Profiler::FrameSample>& samples);
+    void RenderResidency(const AssetManager::ResidencyStats& stats);
+};
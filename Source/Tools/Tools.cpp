@@ -10,6 +10,8 @@
 
 #include "HierarchyTool.h"
 #include "MainMenuTool.h"
+#include "MemoryTool.h"
+#include "ProfilerTool.h"
 
 namespace
 {
@@ -22,6 +24,8 @@ namespace
     // Individual tools.
     MainMenuTool mainMenu;
     HierarchyTool hierarchy;
+    MemoryTool memory;
+    ProfilerTool profiler;
 }
 
 void Tools::Init()
@@ -48,8 +52,11 @@ void Tools::Shutdown()
     }
 }
 
-void Tools::Update()
+void Tools::Update(float deltaTime)
 {
+    // Frame info is collected every frame, even while tools are hidden, so the worst frame isn't missed.
+    profiler.Update(deltaTime);
+
     // Toggle tools with Tab key.
     if(gInputManager.IsKeyLeadingEdge(SDL_SCANCODE_TAB))
     {
@@ -78,6 +85,8 @@ void Tools::Render()
     // Render any tools.
     mainMenu.Render();
     hierarchy.Render(mainMenu.hierarchyToolActive);
+    memory.Render(mainMenu.memoryToolActive);
+    profiler.Render(mainMenu.profilerToolActive);
 
     // Optionally show demo window.
     //ImGui::ShowDemoWindow();
@@ -16,7 +16,7 @@ namespace Tools
     void Init();
     void Shutdown();
 
-    void Update();
+    void Update(float deltaTime);
     void Render();
 
     void SetActive(bool active);
@@ -13,12 +13,15 @@ Cursor::~Cursor()
     {
         SDL_FreeCursor(frame);
     }
+    delete mTexture;
 }
 
-void Cursor::Load(uint8_t* data, uint32_t dataLength)
+void Cursor::Load(const AssetBuffer& data)
 {
     // Texture used is always the same as the name of the cursor.
-    Texture* texture = gAssetManager.LoadTexture(GetNameNoExtension(), GetScope());
+    // Frames aren't created until activation, which may be long after loading. By then, a cached texture may have been unloaded.
+    // So, the cursor loads its own copy of the texture, and holds onto it until the frames are created.
+    Texture* texture = gAssetManager.LoadTexture(GetNameNoExtension(), AssetScope::Manual);
     if(texture == nullptr)
     {
         printf("Create cursor %s failed: couldn't load texture.\n", mName.c_str());
@@ -30,7 +33,7 @@ void Cursor::Load(uint8_t* data, uint32_t dataLength)
     bool hotspotIsPercent = false;
     int frameCount = 1;
 
-    IniParser parser(data, dataLength);
+    IniParser parser(data.GetData(), data.GetSize());
     parser.SetMultipleKeyValuePairsPerLine(false);
     while(parser.ReadLine())
     {
@@ -81,6 +84,63 @@ void Cursor::Load(uint8_t* data, uint32_t dataLength)
         hotspot.y = frameHeight * hotspot.y;
     }
 
+    // Save what we need to create the cursor frames.
+    // Creating cursors must happen on the main thread, and cursors may be loaded on a background thread - so we wait until activation.
+    mTexture = texture;
+    mFrameCount = frameCount;
+    mHotspot = hotspot;
+}
+
+void Cursor::Activate(bool animate)
+{
+    // Create cursor frames if not yet created.
+    if(!mCreatedFrames)
+    {
+        CreateFrames();
+    }
+
+    // Set to first frame.
+    if(mCursorFrames.size() > 0)
+    {
+        SDL_SetCursor(mCursorFrames[0]);
+    }
+    mFrameIndex = 0.0f;
+
+    // Save animation pref.
+    mAnimate = animate;
+}
+
+void Cursor::Update(float deltaTime)
+{
+    // Only need to update if there are multiple frames to animate.
+    if(!mAnimate || mCursorFrames.size() < 2) { return; }
+
+    // Increase timer, but keep in bounds.
+    mFrameIndex += mFramesPerSecond * deltaTime;
+    while(mFrameIndex >= mCursorFrames.size())
+    {
+        mFrameIndex -= mCursorFrames.size();
+    }
+    
+    // Set frame.
+    SDL_SetCursor(mCursorFrames[static_cast<int>(mFrameIndex)]);
+}
+
+void Cursor::CreateFrames()
+{
+    // Only try this once, even if it fails.
+    mCreatedFrames = true;
+
+    // If the cursor is loading in the background, wait for it. Can't create frames without a texture.
+    if(!WaitForLoad() || mTexture == nullptr) { return; }
+    Texture* texture = mTexture;
+    int frameCount = mFrameCount;
+    Vector2 hotspot = mHotspot;
+
+    // Determine width/height of each cursor animation frame.
+    int frameWidth = texture->GetWidth() / frameCount;
+    int frameHeight = texture->GetHeight();
+
     // Generate RGB masks (taken straight from SDL docs).
     unsigned int rmask, gmask, bmask, amask;
     #if SDL_BYTEORDER == SDL_BIG_ENDIAN
@@ -139,33 +199,9 @@ void Cursor::Load(uint8_t* data, uint32_t dataLength)
         }
         mCursorFrames.push_back(cursor);
     }
-}
-
-void Cursor::Activate(bool animate)
-{
-    // Set to first frame.
-    if(mCursorFrames.size() > 0)
-    {
-        SDL_SetCursor(mCursorFrames[0]);
-    }
-    mFrameIndex = 0.0f;
-
-    // Save animation pref.
-    mAnimate = animate;
-}
 
-void Cursor::Update(float deltaTime)
-{
-    // Only need to update if there are multiple frames to animate.
-    if(!mAnimate || mCursorFrames.size() < 2) { return; }
-
-    // Increase timer, but keep in bounds.
-    mFrameIndex += mFramesPerSecond * deltaTime;
-    while(mFrameIndex >= mCursorFrames.size())
-    {
-        mFrameIndex -= mCursorFrames.size();
-    }
-    
-    // Set frame.
-    SDL_SetCursor(mCursorFrames[static_cast<int>(mFrameIndex)]);
+    // The frames have their own copies of the pixels, so the texture is no longer needed.
+    SDL_FreeSurface(srcSurface);
+    delete mTexture;
+    mTexture = nullptr;
 }
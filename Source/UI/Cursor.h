@@ -8,7 +8,10 @@
 
 #include <vector>
 
+#include "Vector2.h"
+
 struct SDL_Cursor;
+class Texture;
 
 class Cursor : public Asset
 {
@@ -16,13 +19,24 @@ public:
     Cursor(const std::string& name, AssetScope scope) : Asset(name, scope) { }
     ~Cursor();
 
-    void Load(uint8_t* data, uint32_t dataLength);
+    void Load(const AssetBuffer& data);
     
     void Activate(bool animate = true);
     
     void Update(float deltaTime);
     
 private:
+    // The texture containing the cursor's frames, and the number of frames in it.
+    // The cursor owns this texture, until it's used to create the frames.
+    Texture* mTexture = nullptr;
+    int mFrameCount = 1;
+
+    // The cursor's hotspot, in pixels.
+    Vector2 mHotspot;
+
+    // Cursor frames are created on first activation.
+    bool mCreatedFrames = false;
+
     // The frames making up the cursor.
     // For animated cursors, there may be multiple entries.
     std::vector<SDL_Cursor*> mCursorFrames;
@@ -36,4 +50,6 @@ private:
 
     // For animated cursors, the current frame index.
     float mFrameIndex = 0.0f;
+
+    void CreateFrames();
 };
@@ -7,9 +7,9 @@
 #include "StringUtil.h"
 #include "Texture.h"
 
-void Font::Load(uint8_t* data, uint32_t dataLength)
+void Font::Load(const AssetBuffer& data)
 {
-    ParseFromData(data, dataLength);
+    ParseFromData(data.GetData(), data.GetSize());
 
     // After parsing, if we have no font texture, we can't do much more.
     if(mFontTexture == nullptr) { return; }
@@ -146,7 +146,7 @@ Shader* Font::GetShader() const
 	return Material::sDefaultShader;
 }
 
-void Font::ParseFromData(uint8_t* data, uint32_t dataLength)
+void Font::ParseFromData(const uint8_t* data, uint32_t dataLength)
 {
 	// Font is in INI format, but only one key per line.
 	IniParser parser(data, dataLength);
@@ -1,6 +1,7 @@
 #include "UICanvas.h"
 
 #include "InputManager.h"
+#include "MemoryTracker.h"
 
 TYPE_DEF_CHILD(UIWidget, UICanvas);
 
@@ -9,6 +10,8 @@ UIWidget* UICanvas::sMouseOverWidget = nullptr;
 
 /*static*/ void UICanvas::UpdateInput()
 {
+	MemoryTagScope memoryTag(MemoryTag::UI);
+
 	// Iterate canvases back-to-front. Since canvases at end of list are rendered last,
 	// they should be the first to receive input events.
 	for(int i = static_cast<int>(sCanvases.size() - 1); i >= 0; --i)
@@ -117,6 +120,8 @@ UICanvas::~UICanvas()
 
 void UICanvas::Render()
 {
+	MemoryTagScope memoryTag(MemoryTag::UI);
+
 	if(IsActiveAndEnabled())
 	{
 		for(auto& widget : mWidgets)
@@ -1,31 +1,93 @@
 #include "Loader.h"
 
+#include "Profiler.h"
 #include "ThreadPool.h"
 
-// Loader uses a single background thread, for now.
-ThreadedTaskQueue Loader::sLoadingTasks(1);
+// Loader has no threads until initialized - until then, tasks run immediately on the calling thread.
+JobSystem Loader::sLoadingJobs;
 
-int Loader::sLoadingCount = 0;
-std::function<void()> Loader::sLoadingFinishedCallback;
+std::deque<Loader::LoadTask> Loader::sQueuedTasks[3];
+std::mutex Loader::sQueueMutex;
+
+std::atomic<int> Loader::sLoadingCount(0);
+std::vector<std::function<void()>> Loader::sLoadingFinishedCallbacks;
+
+void Loader::Init(int workerCount)
+{
+    sLoadingJobs.Start(workerCount, "Loader");
+}
 
 void Loader::Shutdown()
 {
-    sLoadingTasks.Shutdown();
+    // Anything that hasn't started yet is dropped - there's no sense in finishing a scene load or prefetch as the game quits.
+    // This must happen before the job system shuts down, since it runs any remaining jobs on this thread. With no tasks left, those jobs do nothing.
+    {
+        std::lock_guard<std::mutex> lock(sQueueMutex);
+        sLoadingCount -= static_cast<int>(sQueuedTasks[static_cast<int>(LoadPriority::Blocking)].size());
+        for(auto& queue : sQueuedTasks)
+        {
+            queue.clear();
+        }
+    }
+
+    // Wait for any tasks already running to finish.
+    sLoadingJobs.Shutdown();
 }
 
-void Loader::Load(std::function<void()> loadFunc)
+void Loader::Load(std::function<void()> loadFunc, LoadPriority priority, const std::string& tag)
 {
     if(loadFunc != nullptr)
     {
-        sLoadingCount++;
-        sLoadingTasks.AddTask(loadFunc, []() {
-            sLoadingCount--;
-            if(sLoadingCount == 0)
+        // Blocking tasks count as loading from the moment they're queued.
+        if(priority == LoadPriority::Blocking)
+        {
+            ++sLoadingCount;
+        }
+        {
+            std::lock_guard<std::mutex> lock(sQueueMutex);
+            sQueuedTasks[static_cast<int>(priority)].push_back({ loadFunc, tag });
+        }
+        sLoadingJobs.Run([]() {
+            RunNextTask();
+        });
+    }
+}
+
+int Loader::Cancel(const std::string& tag)
+{
+    int canceledCount = 0;
+    int canceledBlockingCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(sQueueMutex);
+        for(int i = 0; i < 3; ++i)
+        {
+            std::deque<LoadTask>& queue = sQueuedTasks[i];
+            for(auto it = queue.begin(); it != queue.end();)
             {
-                OnLoadingFinished();
+                if(it->tag == tag)
+                {
+                    it = queue.erase(it);
+                    ++canceledCount;
+                    if(i == static_cast<int>(LoadPriority::Blocking))
+                    {
+                        ++canceledBlockingCount;
+                    }
+                }
+                else
+                {
+                    ++it;
+                }
             }
-        });
+        }
+    }
+
+    // Canceled blocking tasks are no longer loading.
+    // Their jobs still run, but just do another task, or nothing if no tasks are left.
+    for(int i = 0; i < canceledBlockingCount; ++i)
+    {
+        RemoveLoadingTask();
     }
+    return canceledCount;
 }
 
 void Loader::DoAfterLoading(std::function<void()> callback)
@@ -33,7 +95,7 @@ void Loader::DoAfterLoading(std::function<void()> callback)
     // Save callback.
     if(callback != nullptr)
     {
-        sLoadingFinishedCallback = callback;
+        sLoadingFinishedCallbacks.push_back(callback);
     }
 
     // If nothing is loading right now, loading must already be done.
@@ -44,12 +106,60 @@ void Loader::DoAfterLoading(std::function<void()> callback)
     }
 }
 
+void Loader::RemoveLoadingTask()
+{
+    // Exactly one decrement takes the count to zero - that one lets the main thread know loading is done.
+    if(sLoadingCount.fetch_sub(1) == 1)
+    {
+        ThreadUtil::RunOnMainThread([]() {
+            OnLoadingFinished();
+        });
+    }
+}
+
+void Loader::RunNextTask()
+{
+    // Take the highest priority task waiting.
+    LoadTask task;
+    LoadPriority priority = LoadPriority::Blocking;
+    {
+        std::lock_guard<std::mutex> lock(sQueueMutex);
+        for(int i = 0; i < 3; ++i)
+        {
+            if(!sQueuedTasks[i].empty())
+            {
+                task = std::move(sQueuedTasks[i].front());
+                sQueuedTasks[i].pop_front();
+                priority = static_cast<LoadPriority>(i);
+                break;
+            }
+        }
+    }
+
+    // Nothing left to do if tasks were canceled, or dropped during shutdown.
+    if(task.func == nullptr) { return; }
+    {
+        static const char* kSampleNames[] = { "Load (Blocking)", "Load (Prefetch)", "Load (Speculative)" };
+        PROFILER_SCOPED_NAMED(kSampleNames[static_cast<int>(priority)]);
+        task.func();
+    }
+
+    if(priority == LoadPriority::Blocking)
+    {
+        RemoveLoadingTask();
+    }
+}
+
 void Loader::OnLoadingFinished()
 {
-    auto callback = sLoadingFinishedCallback;
-    sLoadingFinishedCallback = nullptr;
-    if(callback != nullptr)
+    // Loading may have started up again before this ran - if so, wait for that to finish too.
+    if(sLoadingCount > 0) { return; }
+
+    // Callbacks may start more loading (and add more callbacks), so take the current list first.
+    std::vector<std::function<void()>> callbacks;
+    callbacks.swap(sLoadingFinishedCallbacks);
+    for(auto& callback : callbacks)
     {
         callback();
     }
-}
\ No newline at end of file
+}
@@ -4,35 +4,70 @@
 // Loader tracks outstanding background tasks and performs them on background threads.
 // Ideally, any loading work the game does that can go through the loader probably should!
 //
-// Keep in mind: when the loader is running, the game is not playable. A spinning loading cursor is displayed.
-// So, only use it when some work needs to be done before the game can continue playing.
+// Keep in mind: when the loader is running blocking tasks, the game is not playable. A spinning loading cursor is displayed.
+// So, only use blocking tasks when some work needs to be done before the game can continue playing.
+// Work that's only nice to have done early (e.g. prefetching) can use a lower priority, which doesn't block the game.
 //
 #pragma once
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "ThreadPool.h"
 
+enum class LoadPriority
+{
+    Blocking,       // Must finish before the game can continue (e.g. a scene load).
+    Prefetch,       // Known to be needed soon (e.g. assets a scene used last time it was loaded).
+    Speculative     // Might be needed at some point - only done if nothing else is waiting.
+};
+
 class Loader
 {
 public:
+    static void Init(int workerCount);
     static void Shutdown();
 
-    static void Load(std::function<void()> loadFunc);
+    // Queues a task to run on a loader thread. Higher priority tasks always start first.
+    // The tag is used to cancel related tasks as a group (e.g. all prefetches for a location).
+    static void Load(std::function<void()> loadFunc, LoadPriority priority = LoadPriority::Blocking, const std::string& tag = "");
+
+    // Cancels any tasks with this tag that haven't started yet (tasks already running finish as normal).
+    // Returns the number of tasks canceled.
+    static int Cancel(const std::string& tag);
+
+    // Runs the callback on the main thread once all blocking tasks are done.
     static void DoAfterLoading(std::function<void()> callback);
 
+    // For tracking blocking work done outside the loader (e.g. async asset loads).
     static void AddLoadingTask() { ++sLoadingCount; }
-    static void RemoveLoadingTask() { --sLoadingCount; }
+    static void RemoveLoadingTask();
     static bool IsLoading() { return sLoadingCount > 0; }
 
 private:
     // Threads devoted to loading tasks.
-    static ThreadedTaskQueue sLoadingTasks;
+    // Kept separate from the thread pool, so long-running loads never hold up (or get picked up by) threads waiting on pool jobs.
+    static JobSystem sLoadingJobs;
+
+    // Tasks waiting for a loader thread, per priority.
+    // Each queued task has a matching job in the job system. When a job runs, it does the highest priority task waiting.
+    struct LoadTask
+    {
+        std::function<void()> func;
+        std::string tag;
+    };
+    static std::deque<LoadTask> sQueuedTasks[3];
+    static std::mutex sQueueMutex;
 
-    // Number of loading tasks.
-    static int sLoadingCount;
+    // Number of blocking tasks queued or running. Touched by many threads.
+    static std::atomic<int> sLoadingCount;
 
-    // Callback for when loading finishes.
-    static std::function<void()> sLoadingFinishedCallback;
+    // Callbacks for when loading finishes. Only used on the main thread.
+    static std::vector<std::function<void()>> sLoadingFinishedCallbacks;
 
+    static void RunNextTask();
     static void OnLoadingFinished();
 };
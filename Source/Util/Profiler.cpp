@@ -1,14 +1,175 @@
 #include "Profiler.h"
 
-#include <cassert>
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_set>
 
-#include <SDL.h>
-
-#include "Platform.h"
+#include "Leaked.h"
 
 uint64_t Profiler::sFrameNumber = 0L;
-std::vector<Sample> Profiler::sActiveSamples;
+std::atomic<bool> Profiler::sEnabled { false };
+std::atomic<bool> Profiler::sCapturing { false };
+std::vector<Profiler::FrameSample> Profiler::sLastFrameSamples;
+
+namespace
+{
+    // Returns the current time in nanoseconds, from an arbitrary starting point.
+    uint64_t GetTicks()
+    {
+        using namespace std::chrono;
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    // A sample that has finished.
+    struct Event
+    {
+        const char* name;
+        uint64_t startTicks;
+        uint64_t endTicks;
+        int depth;
+    };
+
+    // Each thread records finished samples into its own buffer.
+    // A buffer's lock is only contended when another thread reads the buffer (e.g. when writing a capture).
+    struct ThreadBuffer
+    {
+        uint32_t threadId = 0;
+        std::string threadName;
+
+        std::mutex mutex;
+        std::vector<Event> events;
+
+        // If true, the thread has exited. The buffer is only kept until its samples are no longer needed (see ClearAllBuffers).
+        bool exited = false;
+    };
+
+    // A long capture could use a lot of memory - past this many samples on one thread, samples are dropped.
+    const size_t kMaxEventsPerThread = 1024 * 1024;
+
+    // Buffers for all threads that exist, or that exited with samples not yet written to a capture.
+    // Leaked, since code run during static destruction (e.g. a job system shutting down) may still record samples.
+    std::mutex& GetBuffersMutex()
+    {
+        static Leaked<std::mutex> mutex;
+        return *mutex;
+    }
+
+    std::vector<ThreadBuffer*>& GetBuffers()
+    {
+        static Leaked<std::vector<ThreadBuffer*>> buffers;
+        return *buffers;
+    }
+
+    // The calling thread's buffer, and the samples it has begun, but not yet ended.
+    // Begun samples are tracked even while profiling is off, so begin/end calls stay matched if profiling is toggled mid-sample.
+    struct OpenSample
+    {
+        const char* name;
+        uint64_t startTicks;
+        bool recording;
+    };
+    thread_local ThreadBuffer* threadBuffer = nullptr;
+    thread_local std::vector<OpenSample> openSamples;
+
+    // Ids are never reused, so each thread gets its own track in a capture.
+    uint32_t nextThreadId = 1;
+
+    // The thread that begins/ends frames (the main thread). Outside of captures, only this thread's samples are recorded.
+    // Set by the frame thread, but every thread that ends a sample compares against it - so it must be atomic.
+    std::atomic<ThreadBuffer*> frameThreadBuffer { nullptr };
+
+    // Releases the calling thread's buffer when the thread exits - some threads are short-lived (e.g. one per movie).
+    // If the buffer holds samples for a capture in progress, it's kept until the capture ends. Otherwise, it's deleted right away.
+    // The frame thread's buffer is never released, since the frame thread records samples right up until the program exits.
+    struct ThreadBufferReleaser
+    {
+        ThreadBuffer* buffer = nullptr;
+
+        ~ThreadBufferReleaser()
+        {
+            if(buffer == nullptr || buffer == frameThreadBuffer) { return; }
+
+            std::lock_guard<std::mutex> lock(GetBuffersMutex());
+            bool inUse = false;
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                buffer->exited = true;
+                inUse = !buffer->events.empty();
+            }
+            if(!inUse)
+            {
+                std::vector<ThreadBuffer*>& buffers = GetBuffers();
+                buffers.erase(std::find(buffers.begin(), buffers.end(), buffer));
+                delete buffer;
+            }
+            threadBuffer = nullptr;
+        }
+    };
+    thread_local ThreadBufferReleaser threadBufferReleaser;
+
+    ThreadBuffer* GetThreadBuffer()
+    {
+        if(threadBuffer == nullptr)
+        {
+            threadBuffer = new ThreadBuffer();
+            threadBuffer->events.reserve(1024);
+            threadBufferReleaser.buffer = threadBuffer;
+
+            std::lock_guard<std::mutex> lock(GetBuffersMutex());
+            GetBuffers().push_back(threadBuffer);
+            threadBuffer->threadId = nextThreadId++;
+            threadBuffer->threadName = "Thread " + std::to_string(threadBuffer->threadId);
+        }
+        return threadBuffer;
+    }
+    uint64_t frameStartTicks = 0;
+
+    // When the current capture began.
+    uint64_t captureStartTicks = 0;
+
+    void ClearAllBuffers()
+    {
+        // Buffers of exited threads were only kept around for their samples, so they can be deleted now.
+        std::lock_guard<std::mutex> lock(GetBuffersMutex());
+        std::vector<ThreadBuffer*>& buffers = GetBuffers();
+        for(auto it = buffers.begin(); it != buffers.end();)
+        {
+            ThreadBuffer* buffer = *it;
+            bool exited = false;
+            {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                buffer->events.clear();
+                exited = buffer->exited;
+            }
+            if(exited)
+            {
+                delete buffer;
+                it = buffers.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void WriteEscaped(std::stringstream& ss, const char* str)
+    {
+        for(const char* c = str; *c != '\0'; ++c)
+        {
+            if(*c == '"' || *c == '\\')
+            {
+                ss << '\\';
+            }
+            ss << *c;
+        }
+    }
+}
 
 Stopwatch::Stopwatch()
 {
@@ -17,7 +178,7 @@ Stopwatch::Stopwatch()
 
 void Stopwatch::Reset()
 {
-    mStartCounter = SDL_GetPerformanceCounter();
+    mStartCounter = GetTicks();
 }
 
 float Stopwatch::GetMilliseconds() const
@@ -28,12 +189,9 @@ float Stopwatch::GetMilliseconds() const
 
 float Stopwatch::GetSeconds() const
 {
-    // Get counter delta since stopwatch started.
-    uint64_t counter = SDL_GetPerformanceCounter();
-    uint64_t count = counter - mStartCounter;
-
-    // Convert to seconds.
-    return (static_cast<float>(count) / static_cast<float>(SDL_GetPerformanceFrequency()));
+    // Get nanoseconds since stopwatch started, and convert to seconds.
+    uint64_t count = GetTicks() - mStartCounter;
+    return static_cast<float>(count / 1000000000.0);
 }
 
 Sample::Sample(const char* name) :
@@ -47,31 +205,56 @@ Sample::~Sample()
     printf("[%s] %.2f ms\n", mName, mTimer.GetMilliseconds());
 }
 
-/*static*/ void Profiler::BeginFrame()
+/*static*/ void Profiler::SetEnabled(bool enabled)
 {
-    sActiveSamples.clear();
+    sEnabled = enabled;
+    if(!enabled)
+    {
+        sLastFrameSamples.clear();
+    }
+}
 
-    #if defined(ENV64)
-    printf("===== Begin Frame %lu =====\n", sFrameNumber);
-    #else
-    printf("===== Begin Frame %llu =====\n", sFrameNumber);
-    #endif
-    BeginSample("Total");
+/*static*/ void Profiler::BeginFrame()
+{
+    frameThreadBuffer = GetThreadBuffer();
+    frameStartTicks = GetTicks();
+    BeginSample("Frame");
 }
 
 /*static*/ void Profiler::EndFrame()
 {
-    // There should only be one sample active (from BeginFrame) at this point.
-    // If not, there are mismatched begin/end sample calls somewhere.
-    assert(sActiveSamples.size() == 1);
-
     // End overall frame sample.
     EndSample();
-    #if defined(ENV64)
-    printf("===== End Frame %lu =====\n", sFrameNumber);
-    #else
-    printf("===== End Frame %llu =====\n", sFrameNumber);
-    #endif
+
+    // Any samples still open at this point come from mismatched begin/end sample calls somewhere.
+    openSamples.clear();
+
+    // Save this frame's samples, in the order they began. Only samples that ended this frame are saved.
+    // Since samples are recorded as they end, scanning backwards finds them all without going through the whole buffer.
+    sLastFrameSamples.clear();
+    ThreadBuffer* buffer = frameThreadBuffer;
+    if(buffer != nullptr)
+    {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        for(auto it = buffer->events.rbegin(); it != buffer->events.rend() && it->endTicks >= frameStartTicks; ++it)
+        {
+            FrameSample sample;
+            sample.name = it->name;
+            sample.startMs = static_cast<float>((static_cast<int64_t>(it->startTicks) - static_cast<int64_t>(frameStartTicks)) / 1000000.0);
+            sample.durationMs = static_cast<float>((it->endTicks - it->startTicks) / 1000000.0);
+            sample.depth = it->depth;
+            sLastFrameSamples.push_back(sample);
+        }
+
+        // Outside of a capture, old samples are no longer needed.
+        if(!IsCapturing())
+        {
+            buffer->events.clear();
+        }
+    }
+    std::sort(sLastFrameSamples.begin(), sLastFrameSamples.end(), [](const FrameSample& a, const FrameSample& b) {
+        return a.startMs < b.startMs || (a.startMs == b.startMs && a.depth < b.depth);
+    });
 
     // Increment frame number at end of frame (if you do this at beginning, it just means there's no frame 0).
     sFrameNumber++;
@@ -79,12 +262,104 @@ Sample::~Sample()
 
 /*static*/ void Profiler::BeginSample(const char* name)
 {
-    // Put sample in stack.
-    sActiveSamples.emplace_back(name);
+    bool recording = IsEnabled();
+    openSamples.push_back({ name, recording ? GetTicks() : 0, recording });
 }
 
 /*static*/ void Profiler::EndSample()
 {
-    // Pop the sample off the stack (prints sample info to log).
-    sActiveSamples.pop_back();
+    // Ignore unmatched end calls.
+    if(openSamples.empty()) { return; }
+    OpenSample sample = openSamples.back();
+    openSamples.pop_back();
+
+    // Only record if profiling was enabled for the whole sample.
+    if(!sample.recording || !IsEnabled()) { return; }
+
+    // Outside of a capture, only the frame thread's samples are kept.
+    ThreadBuffer* buffer = GetThreadBuffer();
+    if(buffer != frameThreadBuffer && !IsCapturing()) { return; }
+
+    uint64_t endTicks = GetTicks();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    if(buffer->events.size() < kMaxEventsPerThread)
+    {
+        buffer->events.push_back({ sample.name, sample.startTicks, endTicks, static_cast<int>(openSamples.size()) });
+    }
+}
+
+/*static*/ const char* Profiler::InternName(const std::string& name)
+{
+    // Interned names are held in static samples and task graphs, so they must stay valid until the very end.
+    static Leaked<std::mutex> mutex;
+    static Leaked<std::unordered_set<std::string>> names;
+
+    std::lock_guard<std::mutex> lock(*mutex);
+    return names->insert(name).first->c_str();
+}
+
+/*static*/ void Profiler::SetThreadName(const std::string& name)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(GetBuffersMutex());
+    buffer->threadName = name;
+}
+
+/*static*/ void Profiler::BeginCapture()
+{
+    ClearAllBuffers();
+    captureStartTicks = GetTicks();
+    sCapturing = true;
+    sEnabled = true;
+}
+
+/*static*/ bool Profiler::EndCapture(const std::string& filePath)
+{
+    if(!IsCapturing()) { return false; }
+    sCapturing = false;
+
+    // Write out the capture, then throw away all recorded samples.
+    std::ofstream file(filePath);
+    if(file.good())
+    {
+        file << GetChromeTrace();
+    }
+    ClearAllBuffers();
+    return file.good();
+}
+
+/*static*/ std::string Profiler::GetChromeTrace()
+{
+    // See "Trace Event Format" documentation for details.
+    // Each sample is a "complete" event, with timestamps and durations in microseconds. Each thread gets its own track.
+    std::stringstream ss;
+    ss << "{\"traceEvents\":[";
+    bool firstEvent = true;
+
+    std::lock_guard<std::mutex> lock(GetBuffersMutex());
+    for(ThreadBuffer* buffer : GetBuffers())
+    {
+        // Name the thread's track.
+        ss << (firstEvent ? "\n" : ",\n");
+        firstEvent = false;
+        ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":\"";
+        WriteEscaped(ss, buffer->threadName.c_str());
+        ss << "\"}}";
+
+        // Add each of the thread's samples.
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        for(const Event& event : buffer->events)
+        {
+            if(event.startTicks < captureStartTicks) { continue; }
+
+            char times[64];
+            snprintf(times, sizeof(times), "\"ts\":%.3f,\"dur\":%.3f", (event.startTicks - captureStartTicks) / 1000.0,
+                     (event.endTicks - event.startTicks) / 1000.0);
+            ss << ",\n{\"name\":\"";
+            WriteEscaped(ss, event.name);
+            ss << "\",\"cat\":\"gk3\",\"ph\":\"X\"," << times << ",\"pid\":1,\"tid\":" << buffer->threadId << "}";
+        }
+    }
+    ss << "\n]}\n";
+    return ss.str();
 }
\ No newline at end of file
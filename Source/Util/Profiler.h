@@ -1,24 +1,40 @@
+//
+// Clark Kromenaker
+//
+// A hierarchical CPU profiler.
+//
+// Code marks named scopes (samples) with the PROFILER_* macros. Samples can nest, and can be made on any thread.
+// Each thread records finished samples into its own buffer, so threads rarely (if ever) contend with one another.
+//
+// Profiling is compiled in, but off until enabled at runtime - when off, a sample costs little more than a flag check.
+// When enabled, the main thread's samples for the last frame are kept for display (e.g. in tools).
+// During a capture, all threads' samples are kept, and can be saved as a Chrome trace (view in chrome://tracing or Perfetto).
+//
 #pragma once
+#include <atomic>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 class Profiler;
 class ScopedProfiler;
 
-//#define PROFILER_ENABLED
+#define PROFILER_ENABLED
 
 #if defined(PROFILER_ENABLED)
     #define PROFILER_BEGIN_FRAME() Profiler::BeginFrame();
     #define PROFILER_END_FRAME() Profiler::EndFrame();
     #define PROFILER_BEGIN_SAMPLE(x) Profiler::BeginSample(x);
     #define PROFILER_END_SAMPLE() Profiler::EndSample();
-    #define PROFILER_SCOPED(x) ScopedProfiler x(#x);
+    #define PROFILER_SCOPED(x) ScopedProfiler scopedProfiler##x(#x);
+    #define PROFILER_SCOPED_NAMED(name) ScopedProfiler scopedProfilerSample(name);
 #else
     #define PROFILER_BEGIN_FRAME()
     #define PROFILER_END_FRAME()
     #define PROFILER_BEGIN_SAMPLE(x)
     #define PROFILER_END_SAMPLE()
     #define PROFILER_SCOPED(x)
+    #define PROFILER_SCOPED_NAMED(name)
 #endif
 
 // These defines are ALWAYS available.
@@ -58,18 +74,58 @@ private:
 class Profiler
 {
 public:
+    // A finished sample on the main thread during the last frame.
+    struct FrameSample
+    {
+        const char* name = nullptr;
+
+        // Start time (relative to the frame's start) and duration of the sample.
+        float startMs = 0.0f;
+        float durationMs = 0.0f;
+
+        // How deeply nested the sample is (the frame itself is depth 0).
+        int depth = 0;
+    };
+
+    // Turns profiling on or off. Safe to call at any time (samples already in progress are discarded).
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled() { return sEnabled.load(std::memory_order_relaxed); }
+
     static void BeginFrame();
     static void EndFrame();
 
+    // Sample names are stored by pointer, so they must live as long as the profiler does.
+    // String literals are fine - for anything else, use InternName to get a long-lived copy.
     static void BeginSample(const char* name);
     static void EndSample();
+    static const char* InternName(const std::string& name);
+
+    // Names the calling thread (e.g. "Main", "Worker 1"), so it can be identified in captures.
+    static void SetThreadName(const std::string& name);
+
+    // A capture records samples from all threads until the capture ends.
+    // Beginning a capture also enables profiling. Ending it writes a Chrome trace file.
+    static void BeginCapture();
+    static bool EndCapture(const std::string& filePath);
+    static bool IsCapturing() { return sCapturing.load(std::memory_order_relaxed); }
+
+    // Converts all samples recorded since the capture began to Chrome trace JSON.
+    static std::string GetChromeTrace();
+
+    // Info about the last completed frame (if profiling was enabled during that frame).
+    static uint64_t GetFrameNumber() { return sFrameNumber; }
+    static const std::vector<FrameSample>& GetLastFrameSamples() { return sLastFrameSamples; }
 
 private:
     // Counts what frame we're on.
     static uint64_t sFrameNumber;
 
-    // Samples that are still in progress.
-    static std::vector<Sample> sActiveSamples;
+    // Is profiling enabled? Are we in the middle of a capture?
+    static std::atomic<bool> sEnabled;
+    static std::atomic<bool> sCapturing;
+
+    // The main thread's samples from the last frame.
+    static std::vector<FrameSample> sLastFrameSamples;
 };
 
 // Small class that just handles calling BeginSample/EndSample.
@@ -79,4 +135,4 @@ class ScopedProfiler
 public:
     ScopedProfiler(const char* name) { Profiler::BeginSample(name); }
     ~ScopedProfiler() { Profiler::EndSample(); }
-};
\ No newline at end of file
+};
@@ -0,0 +1,250 @@
+#include "JobSystem.h"
+
+#include "Leaked.h"
+#include "ObjectPool.h"
+#include "Profiler.h"
+
+namespace
+{
+    // If this thread is a worker thread, the job system it belongs to, and the index of its queue.
+    thread_local JobSystem* sWorkerSystem = nullptr;
+    thread_local size_t sWorkerIndex = 0;
+
+    // Shared by all job systems, since a job may be scheduled by a different system than the one that created it (see RunAfter).
+    // Static job systems (e.g. the thread pool) run their remaining jobs when destroyed, so the pool must outlive them.
+    ObjectPool& GetJobPool()
+    {
+        static Leaked<ObjectPool> pool("Job", sizeof(Job), alignof(Job), 256);
+        return *pool;
+    }
+}
+
+/*static*/ void* Job::operator new(size_t size)
+{
+    return GetJobPool().Allocate();
+}
+
+/*static*/ void Job::operator delete(void* memory, size_t size)
+{
+    GetJobPool().Deallocate(memory);
+}
+
+JobSystem::JobSystem(int workerCount)
+{
+    Start(workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+    Shutdown();
+}
+
+void JobSystem::Start(int workerCount, const std::string& name)
+{
+    if(workerCount <= 0 || !mThreads.empty()) { return; }
+    mShutdown = false;
+    mName = name;
+
+    // Create all queues before starting any threads, since workers steal from every queue.
+    for(int i = 0; i < workerCount; ++i)
+    {
+        mQueues.emplace_back(new WorkerQueue());
+    }
+    for(int i = 0; i < workerCount; ++i)
+    {
+        mThreads.emplace_back(&JobSystem::WorkerThread, this, i);
+    }
+}
+
+void JobSystem::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mShutdown = true;
+    }
+    mSleepCondVar.notify_all();
+
+    for(auto& thread : mThreads)
+    {
+        if(thread.joinable())
+        {
+            thread.join();
+        }
+    }
+    mThreads.clear();
+
+    // Any jobs that never ran are run here, so their counters finish (and anyone waiting on them is released).
+    // Jobs they schedule, or that were waiting on their counters, are queued and run here as well.
+    while(TryRunJob()) { }
+
+    // From here on, jobs run immediately on the calling thread.
+    mQueues.clear();
+    mQueuedJobCount = 0;
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+    while(counter.mCount.load() > 0)
+    {
+        if(TryRunJob()) { continue; }
+
+        // Nothing to run - sleep until the counter finishes, or more jobs are queued that could be helped with.
+        // This thread either sees the count reach zero, or is seen as waiting by whoever finishes the counter - so no wakeups are missed.
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        ++mWaitingThreadCount;
+        mWaitCondVar.wait(lock, [this, &counter]() {
+            return counter.mCount.load() == 0 || mQueuedJobCount.load() > 0;
+        });
+        --mWaitingThreadCount;
+    }
+
+    // The last job to finish may still hold the counter's lock - wait for it to let go, so the caller can safely destroy the counter.
+    std::lock_guard<std::mutex> lock(counter.mMutex);
+}
+
+bool JobSystem::TryRunJob()
+{
+    Job* job = TakeJob();
+    if(job != nullptr)
+    {
+        RunJob(job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::Schedule(Job* job)
+{
+    // Without any workers, just run the job right away.
+    if(mQueues.empty())
+    {
+        RunJob(job);
+        return;
+    }
+
+    // Workers add jobs to their own queue. Other threads spread jobs across all queues.
+    size_t queueIndex = sWorkerIndex;
+    if(sWorkerSystem != this)
+    {
+        queueIndex = mNextQueueIndex.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    }
+    {
+        WorkerQueue& queue = *mQueues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+
+    // Wake a worker, if any are sleeping, and any waiting threads, which can help out.
+    // A thread about to sleep either sees the new queued job count, or is seen as sleeping here - so no wakeups are missed.
+    mQueuedJobCount.fetch_add(1);
+    if(mSleepingWorkerCount.load() > 0 || mWaitingThreadCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mSleepCondVar.notify_one();
+        mWaitCondVar.notify_all();
+    }
+}
+
+Job* JobSystem::TakeJob()
+{
+    if(mQueuedJobCount.load(std::memory_order_relaxed) <= 0) { return nullptr; }
+
+    // Workers check their own queue first, taking the newest job.
+    size_t queueCount = mQueues.size();
+    size_t startIndex = 0;
+    if(sWorkerSystem == this)
+    {
+        WorkerQueue& queue = *mQueues[sWorkerIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.jobs.empty())
+        {
+            Job* job = queue.jobs.back();
+            queue.jobs.pop_back();
+            --mQueuedJobCount;
+            return job;
+        }
+        startIndex = sWorkerIndex + 1;
+    }
+
+    // Otherwise, steal the oldest job from some other queue.
+    for(size_t i = 0; i < queueCount; ++i)
+    {
+        WorkerQueue& queue = *mQueues[(startIndex + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if(!queue.jobs.empty())
+        {
+            Job* job = queue.jobs.front();
+            queue.jobs.pop_front();
+            --mQueuedJobCount;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::RunJob(Job* job)
+{
+    {
+        PROFILER_SCOPED_NAMED("Job");
+        job->Run();
+    }
+
+    JobCounter* counter = job->GetCounter();
+    delete job;
+    if(counter != nullptr)
+    {
+        FinishJob(counter);
+    }
+}
+
+void JobSystem::FinishJob(JobCounter* counter)
+{
+    // Decrement while holding the counter's lock, so nobody destroys the counter out from under us (see Wait).
+    // If this was the counter's last job, jobs depending on the counter can now run.
+    std::vector<Job*> readyJobs;
+    bool counterDone = false;
+    {
+        std::lock_guard<std::mutex> lock(counter->mMutex);
+        if(counter->mCount.fetch_sub(1) == 1)
+        {
+            readyJobs.swap(counter->mWaitingJobs);
+            counterDone = true;
+        }
+    }
+
+    // Wake any threads waiting on counters. The counter may be destroyed as soon as it's unlocked, so it isn't touched from here on.
+    if(counterDone && mWaitingThreadCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(mSleepMutex);
+        mWaitCondVar.notify_all();
+    }
+    for(Job* job : readyJobs)
+    {
+        Schedule(job);
+    }
+}
+
+void JobSystem::WorkerThread(int workerIndex)
+{
+    sWorkerSystem = this;
+    sWorkerIndex = static_cast<size_t>(workerIndex);
+    Profiler::SetThreadName(mName + " " + std::to_string(workerIndex + 1));
+    while(!mShutdown)
+    {
+        // Do a job, if there's one to do.
+        Job* job = TakeJob();
+        if(job != nullptr)
+        {
+            RunJob(job);
+            continue;
+        }
+
+        // Nothing to do - sleep until more jobs are added.
+        std::unique_lock<std::mutex> lock(mSleepMutex);
+        ++mSleepingWorkerCount;
+        mSleepCondVar.wait(lock, [this]() {
+            return mShutdown || mQueuedJobCount.load() > 0;
+        });
+        --mSleepingWorkerCount;
+    }
+}
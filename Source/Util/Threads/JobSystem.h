@@ -0,0 +1,254 @@
+//
+// Clark Kromenaker
+//
+// A job system runs small units of work ("jobs") on a set of worker threads.
+//
+// Each worker has its own queue. Workers run jobs from their own queue first (newest first, while data is still warm in cache),
+// and steal jobs from other workers' queues (oldest first) when their own queue runs dry.
+// There's no single lock that every thread fights over - each queue has its own lock, which is rarely contended.
+//
+// Jobs can be tracked with a JobCounter, which counts how many of its jobs are unfinished.
+// Jobs can depend on a counter (the job only runs once the counter's jobs are done), and any thread can wait on a counter.
+//
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class Job;
+
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    // Counters are referred to by pointer from jobs, so no copying or moving.
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    // True if all jobs tracked by this counter are done. Once done, it's safe to destroy the counter.
+    bool IsDone() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mCount.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class JobSystem;
+
+    // Number of unfinished jobs.
+    std::atomic<int> mCount { 0 };
+
+    // Jobs waiting for this counter to reach zero before they can run.
+    // The count is only decremented while holding the mutex, so whoever sees a zero count (and then locks) knows the counter is no longer in use.
+    mutable std::mutex mMutex;
+    std::vector<Job*> mWaitingJobs;
+};
+
+class Job
+{
+public:
+    template<typename Func> explicit Job(Func&& func, JobCounter* counter);
+    ~Job() { mDestroy(mStorage); }
+
+    // Jobs may store their function inline, so no copying or moving.
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+    // Jobs are created and destroyed constantly, so they're allocated from a pool rather than scattered around the heap.
+    static void* operator new(size_t size);
+    static void operator delete(void* memory, size_t size);
+
+    void Run() { mInvoke(mStorage); }
+    JobCounter* GetCounter() const { return mCounter; }
+
+private:
+    // Most job functions are small lambdas, which are stored right in the job - no separate allocation needed.
+    // Bigger functions are allocated on the heap, with a pointer stored here instead.
+    static const size_t kInlineSize = 64;
+    alignas(std::max_align_t) unsigned char mStorage[kInlineSize];
+
+    template<typename FuncType> struct FitsInline :
+        std::integral_constant<bool, sizeof(FuncType) <= kInlineSize && alignof(FuncType) <= alignof(std::max_align_t)> { };
+
+    // Stores the function inline or on the heap. Picked at compile time, so placement new is never compiled for a function that doesn't fit.
+    template<typename FuncType, typename Func> void Store(Func&& func, std::true_type /*inline*/);
+    template<typename FuncType, typename Func> void Store(Func&& func, std::false_type /*inline*/);
+
+    // Type-erased functions to call or destroy the stored function.
+    void (*mInvoke)(void* storage) = nullptr;
+    void (*mDestroy)(void* storage) = nullptr;
+
+    // Counter to decrement once this job is done, if any.
+    JobCounter* mCounter = nullptr;
+};
+
+template<typename Func>
+Job::Job(Func&& func, JobCounter* counter) :
+    mCounter(counter)
+{
+    typedef typename std::decay<Func>::type FuncType;
+    Store<FuncType>(std::forward<Func>(func), FitsInline<FuncType>());
+}
+
+template<typename FuncType, typename Func>
+void Job::Store(Func&& func, std::true_type)
+{
+    new(mStorage) FuncType(std::forward<Func>(func));
+    mInvoke = [](void* storage) { (*static_cast<FuncType*>(storage))(); };
+    mDestroy = [](void* storage) { static_cast<FuncType*>(storage)->~FuncType(); };
+}
+
+template<typename FuncType, typename Func>
+void Job::Store(Func&& func, std::false_type)
+{
+    *reinterpret_cast<FuncType**>(mStorage) = new FuncType(std::forward<Func>(func));
+    mInvoke = [](void* storage) { (**static_cast<FuncType**>(storage))(); };
+    mDestroy = [](void* storage) { delete *static_cast<FuncType**>(storage); };
+}
+
+class JobSystem
+{
+public:
+    JobSystem(int workerCount = 0);
+    ~JobSystem();
+
+    // Starts worker threads. Should only be called once, before any jobs are run.
+    // Until workers are started, jobs run immediately on the calling thread.
+    // Worker threads are named after the job system (e.g. "Worker 1", "Worker 2"), so they can be told apart in profiler captures.
+    void Start(int workerCount, const std::string& name = "Worker");
+    void Shutdown();
+
+    int GetWorkerCount() const { return static_cast<int>(mThreads.size()); }
+
+    // Runs a job on a worker thread.
+    // If a counter is provided, it is incremented right away, and decremented once the job is done.
+    template<typename Func> void Run(Func&& func, JobCounter* counter = nullptr);
+
+    // Runs a job once all jobs tracked by the dependency counter are done.
+    template<typename Func> void RunAfter(JobCounter& dependency, Func&& func, JobCounter* counter = nullptr);
+
+    // Calls func(index) for every index in [begin, end), spread across worker threads, and returns once all calls are done.
+    // The range is split into batches of at least minBatchSize indexes - use bigger batches when each call is very cheap.
+    // The calling thread runs a batch too, and helps with other jobs while waiting, so this is safe to call from within a job.
+    template<typename Func> void ParallelFor(size_t begin, size_t end, Func&& func, size_t minBatchSize = 1);
+
+    // Waits until all jobs tracked by the counter are done.
+    // Rather than sit idle, the waiting thread runs other jobs in the meantime, and only sleeps once there's nothing left to run.
+    void Wait(JobCounter& counter);
+
+    // Runs a single queued job on the calling thread. Returns false if there was nothing to run.
+    bool TryRunJob();
+
+private:
+    // Each worker has its own queue of jobs.
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<Job*> jobs;
+    };
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+
+    // Jobs added from outside the job system are spread across worker queues.
+    std::atomic<unsigned int> mNextQueueIndex { 0 };
+
+    // Number of jobs sitting in queues, and number of workers sleeping because there was nothing to do.
+    std::atomic<int> mQueuedJobCount { 0 };
+    std::atomic<int> mSleepingWorkerCount { 0 };
+
+    // Idle workers sleep on this condition variable.
+    std::mutex mSleepMutex;
+    std::condition_variable mSleepCondVar;
+
+    // Threads in Wait sleep on this one (guarded by the same mutex) until a counter finishes or more jobs are queued.
+    // Kept separate from the worker condition variable, so waking a waiting thread never uses up a worker's wakeup.
+    std::atomic<int> mWaitingThreadCount { 0 };
+    std::condition_variable mWaitCondVar;
+
+    // If true, the job system is shutting down. Worker threads will exit.
+    std::atomic<bool> mShutdown { false };
+
+    // Worker threads, and the name they're given.
+    std::vector<std::thread> mThreads;
+    std::string mName;
+
+    void Schedule(Job* job);
+    Job* TakeJob();
+    void RunJob(Job* job);
+    void FinishJob(JobCounter* counter);
+    void WorkerThread(int workerIndex);
+};
+
+template<typename Func>
+void JobSystem::Run(Func&& func, JobCounter* counter)
+{
+    if(counter != nullptr)
+    {
+        counter->mCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    Schedule(new Job(std::forward<Func>(func), counter));
+}
+
+template<typename Func>
+void JobSystem::RunAfter(JobCounter& dependency, Func&& func, JobCounter* counter)
+{
+    if(counter != nullptr)
+    {
+        counter->mCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    Job* job = new Job(std::forward<Func>(func), counter);
+
+    // If the dependency isn't done, it schedules the job when it is. Otherwise, the job can run right away.
+    // Checking the count under the dependency's lock ensures the job isn't missed if the dependency finishes at the same time.
+    {
+        std::lock_guard<std::mutex> lock(dependency.mMutex);
+        if(dependency.mCount.load(std::memory_order_acquire) > 0)
+        {
+            dependency.mWaitingJobs.push_back(job);
+            return;
+        }
+    }
+    Schedule(job);
+}
+
+template<typename Func>
+void JobSystem::ParallelFor(size_t begin, size_t end, Func&& func, size_t minBatchSize)
+{
+    if(begin >= end) { return; }
+
+    // Aim for a few batches per thread (workers + the calling thread), so threads that finish early can steal the rest.
+    size_t count = end - begin;
+    size_t maxBatchCount = (mQueues.size() + 1) * 4;
+    size_t batchSize = std::max(std::max(minBatchSize, static_cast<size_t>(1)), (count + maxBatchCount - 1) / maxBatchCount);
+
+    // Hand out all batches but the first one.
+    JobCounter counter;
+    for(size_t batchBegin = begin + batchSize; batchBegin < end; batchBegin += batchSize)
+    {
+        size_t batchEnd = std::min(batchBegin + batchSize, end);
+        Run([&func, batchBegin, batchEnd]() {
+            for(size_t i = batchBegin; i < batchEnd; ++i)
+            {
+                func(i);
+            }
+        }, &counter);
+    }
+
+    // This thread does the first batch itself, then helps out until the rest are done.
+    size_t firstBatchEnd = std::min(begin + batchSize, end);
+    for(size_t i = begin; i < firstBatchEnd; ++i)
+    {
+        func(i);
+    }
+    Wait(counter);
+}
@@ -0,0 +1,176 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "Profiler.h"
+
+int TaskGraph::AddStage(const std::string& name, std::function<void()> func, std::initializer_list<std::string> reads,
+                        std::initializer_list<std::string> writes, bool mainThread)
+{
+    int stageIndex = static_cast<int>(mStages.size());
+    mStages.emplace_back(new Stage());
+    mStages.back()->name = name;
+    mStages.back()->profilerName = Profiler::InternName(name);
+    mStages.back()->func = func;
+    mStages.back()->mainThread = mainThread;
+
+    // Reading data means waiting for the last stage that wrote it.
+    for(const std::string& read : reads)
+    {
+        DataAccess& access = GetDataAccess(read);
+        if(access.lastWriter >= 0)
+        {
+            AddDependency(access.lastWriter, stageIndex);
+        }
+        access.readers.push_back(stageIndex);
+    }
+
+    // Writing data means waiting for the last stage that wrote it, AND any stages reading what that stage wrote.
+    for(const std::string& write : writes)
+    {
+        DataAccess& access = GetDataAccess(write);
+        if(access.lastWriter >= 0)
+        {
+            AddDependency(access.lastWriter, stageIndex);
+        }
+        for(int reader : access.readers)
+        {
+            if(reader != stageIndex)
+            {
+                AddDependency(reader, stageIndex);
+            }
+        }
+        access.lastWriter = stageIndex;
+        access.readers.clear();
+    }
+    return stageIndex;
+}
+
+void TaskGraph::AddDependency(int beforeStageIndex, int afterStageIndex)
+{
+    // Only allowing dependencies on earlier stages guarantees there are no cycles.
+    assert(beforeStageIndex < afterStageIndex);
+    if(beforeStageIndex < 0 || beforeStageIndex >= afterStageIndex || afterStageIndex >= static_cast<int>(mStages.size())) { return; }
+
+    // Ignore duplicates (e.g. a stage that reads and writes the same data).
+    std::vector<int>& dependencies = mStages[afterStageIndex]->dependencies;
+    if(std::find(dependencies.begin(), dependencies.end(), beforeStageIndex) != dependencies.end()) { return; }
+    dependencies.push_back(beforeStageIndex);
+    mStages[beforeStageIndex]->dependents.push_back(afterStageIndex);
+}
+
+void TaskGraph::Execute(JobSystem& jobSystem)
+{
+    if(mStages.empty()) { return; }
+
+    // Every stage starts out waiting on all its dependencies.
+    mRemainingStageCount = static_cast<int>(mStages.size());
+    for(auto& stage : mStages)
+    {
+        stage->pendingDependencyCount = static_cast<int>(stage->dependencies.size());
+    }
+
+    // Kick off stages with no dependencies. Other stages are kicked off as their dependencies finish.
+    JobCounter counter;
+    for(size_t i = 0; i < mStages.size(); ++i)
+    {
+        if(mStages[i]->dependencies.empty())
+        {
+            OnStageReady(jobSystem, static_cast<int>(i), counter);
+        }
+    }
+
+    // Run main thread stages as they become ready. In between, help out with other jobs.
+    while(mRemainingStageCount > 0)
+    {
+        int mainThreadStageIndex = -1;
+        {
+            std::lock_guard<std::mutex> lock(mMainThreadStagesMutex);
+            if(!mMainThreadStages.empty())
+            {
+                mainThreadStageIndex = mMainThreadStages.front();
+                mMainThreadStages.erase(mMainThreadStages.begin());
+            }
+        }
+
+        if(mainThreadStageIndex >= 0)
+        {
+            RunStage(jobSystem, mainThreadStageIndex, counter);
+        }
+        else if(!jobSystem.TryRunJob())
+        {
+            // Nothing to help with - the remaining stages are running on workers. Sleep until there's more for this thread to do.
+            std::unique_lock<std::mutex> lock(mMainThreadStagesMutex);
+            mMainThreadStagesCondVar.wait(lock, [this]() {
+                return !mMainThreadStages.empty() || mRemainingStageCount.load() == 0;
+            });
+        }
+    }
+
+    // All stages are done, but stage jobs may still be wrapping up - wait for them before the counter goes away.
+    jobSystem.Wait(counter);
+}
+
+void TaskGraph::Clear()
+{
+    mStages.clear();
+    mDataAccesses.clear();
+}
+
+TaskGraph::DataAccess& TaskGraph::GetDataAccess(const std::string& name)
+{
+    for(DataAccess& access : mDataAccesses)
+    {
+        if(access.name == name)
+        {
+            return access;
+        }
+    }
+    mDataAccesses.emplace_back();
+    mDataAccesses.back().name = name;
+    return mDataAccesses.back();
+}
+
+void TaskGraph::OnStageReady(JobSystem& jobSystem, int stageIndex, JobCounter& counter)
+{
+    if(mStages[stageIndex]->mainThread)
+    {
+        std::lock_guard<std::mutex> lock(mMainThreadStagesMutex);
+        mMainThreadStages.push_back(stageIndex);
+        mMainThreadStagesCondVar.notify_one();
+    }
+    else
+    {
+        jobSystem.Run([this, &jobSystem, stageIndex, &counter]() {
+            RunStage(jobSystem, stageIndex, counter);
+        }, &counter);
+    }
+}
+
+void TaskGraph::RunStage(JobSystem& jobSystem, int stageIndex, JobCounter& counter)
+{
+    Stage& stage = *mStages[stageIndex];
+    if(stage.func != nullptr)
+    {
+        PROFILER_SCOPED_NAMED(stage.profilerName);
+        stage.func();
+    }
+
+    // Any dependents waiting only on this stage are now ready to go.
+    for(int dependent : stage.dependents)
+    {
+        if(mStages[dependent]->pendingDependencyCount.fetch_sub(1) == 1)
+        {
+            OnStageReady(jobSystem, dependent, counter);
+        }
+    }
+
+    // Count the stage as done last, so Execute doesn't return while dependents are still being kicked off.
+    // If this was the last stage, wake the main thread. Notifying under the lock means it can't miss the wakeup between checking the count and sleeping.
+    if(mRemainingStageCount.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock(mMainThreadStagesMutex);
+        mMainThreadStagesCondVar.notify_one();
+    }
+}
@@ -0,0 +1,84 @@
+//
+// Clark Kromenaker
+//
+// A task graph is a set of "stages" of work, along with the order they must run in.
+// It's built once (say, at startup) and then executed as often as needed (say, once per frame).
+//
+// Each stage declares the data it reads and writes, using any name for the data (e.g. "Actors").
+// A stage runs after earlier stages that write data it reads or writes, and after earlier stages that read data it writes.
+// Stages that don't touch the same data can run at the same time on different threads.
+//
+// Stages that must run on the main thread (e.g. anything touching the graphics API or running scripts) are flagged as such.
+// Within a stage, a JobSystem's ParallelFor can be used to split work across threads.
+//
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "JobSystem.h"
+
+class TaskGraph
+{
+public:
+    // Adds a stage, returning its index. Dependencies on previously added stages are worked out from the reads/writes.
+    int AddStage(const std::string& name, std::function<void()> func, std::initializer_list<std::string> reads,
+                 std::initializer_list<std::string> writes, bool mainThread = false);
+
+    // Adds a dependency that isn't expressed by reads/writes: the "after" stage waits for the "before" stage.
+    // The before stage must have been added first.
+    void AddDependency(int beforeStageIndex, int afterStageIndex);
+
+    // Runs all stages, in dependency order, and returns once they're all done.
+    // Must be called from the main thread, which runs main thread stages and helps with other stages.
+    // The main thread runs any job queued on the job system while it helps, so it's best to use a job system that only runs frame work.
+    void Execute(JobSystem& jobSystem);
+
+    // Removes all stages.
+    void Clear();
+
+    size_t GetStageCount() const { return mStages.size(); }
+    const std::string& GetStageName(int stageIndex) const { return mStages[stageIndex]->name; }
+
+private:
+    struct Stage
+    {
+        std::string name;
+        const char* profilerName = nullptr;
+        std::function<void()> func;
+        bool mainThread = false;
+
+        // Stages that must finish before this one can start, and stages that depend on this one.
+        std::vector<int> dependencies;
+        std::vector<int> dependents;
+
+        // During execution, the number of dependencies that haven't finished yet.
+        std::atomic<int> pendingDependencyCount { 0 };
+    };
+    std::vector<std::unique_ptr<Stage>> mStages;
+
+    // For each piece of data, the last stage to write it, and stages that have read it since.
+    struct DataAccess
+    {
+        std::string name;
+        int lastWriter = -1;
+        std::vector<int> readers;
+    };
+    std::vector<DataAccess> mDataAccesses;
+
+    // During execution, main thread stages that are ready to run, and the number of stages not yet done.
+    // When there's nothing to do, the main thread sleeps until a main thread stage is ready or all stages are done.
+    std::mutex mMainThreadStagesMutex;
+    std::condition_variable mMainThreadStagesCondVar;
+    std::vector<int> mMainThreadStages;
+    std::atomic<int> mRemainingStageCount { 0 };
+
+    DataAccess& GetDataAccess(const std::string& name);
+    void OnStageReady(JobSystem& jobSystem, int stageIndex, JobCounter& counter);
+    void RunStage(JobSystem& jobSystem, int stageIndex, JobCounter& counter);
+};
@@ -1,111 +1,42 @@
 #include "ThreadPool.h"
 
-#include <thread>
+JobSystem ThreadPool::sJobSystem;
+JobSystem ThreadPool::sFrameJobSystem;
 
-ThreadedTaskQueue::ThreadedTaskQueue(int threadCount)
+void ThreadPool::Init(int threadCount, int frameThreadCount)
 {
-    AddThreads(threadCount);
+    sJobSystem.Start(threadCount, "Worker");
+    sFrameJobSystem.Start(frameThreadCount, "Frame Worker");
 }
 
-ThreadedTaskQueue::~ThreadedTaskQueue()
-{
-    Shutdown();
-}
-
-void ThreadedTaskQueue::AddThreads(int count)
+void ThreadPool::Shutdown()
 {
-    for(int i = 0; i < count; i++)
-    {
-        mThreads.emplace_back(std::bind(&ThreadedTaskQueue::TaskThread, this));
-    }
+    sFrameJobSystem.Shutdown();
+    sJobSystem.Shutdown();
 }
 
-void ThreadedTaskQueue::Shutdown()
+void ThreadPool::AddTask(std::function<void()> task, std::function<void()> callback)
 {
-    mMutex.lock();
-    mShutdown = true;
-    mMutex.unlock();
-
-    mCondVar.notify_all();
+    if(task == nullptr) { return; }
+    sJobSystem.Run([task, callback]() {
+        task();
 
-    for(auto& thread : mThreads)
-    {
-        if(thread.joinable())
+        // Only bother the main thread if there's actually a callback to run.
+        if(callback != nullptr)
         {
-            thread.join();
+            ThreadUtil::RunOnMainThread(callback);
         }
-    }
+    });
 }
 
-void ThreadedTaskQueue::AddTask(std::function<void()> task, std::function<void()> callback)
-{
-    // Wrap the task in a void(void*) lambda so it can be stored in the list successfully.
-    AddTask([task](void* arg) {
-        task();
-    }, nullptr, callback);
-}
-
-void ThreadedTaskQueue::AddTask(std::function<void(void*)> task, void* context, std::function<void()> callback)
-{
-    if(task != nullptr)
-    {
-        mMutex.lock();
-        mTasks.emplace(task, context, callback);
-        mMutex.unlock();
-
-        mCondVar.notify_one();
-    }
-}
-
-void ThreadedTaskQueue::TaskThread()
+void ThreadPool::AddTask(std::function<void(void*)> task, void* context, std::function<void()> callback)
 {
-    while(true)
-    {
-        // Lock mutex to check task list.
-        std::unique_lock<std::mutex> lock(mMutex);
-
-        // If task queue is empty (and not shutting down), wait.
-        while(mTasks.empty() && !mShutdown)
+    if(task == nullptr) { return; }
+    sJobSystem.Run([task, context, callback]() {
+        task(context);
+        if(callback != nullptr)
         {
-            mCondVar.wait(lock);
+            ThreadUtil::RunOnMainThread(callback);
         }
-
-        // If shutting down, just return.
-        if(mShutdown) { return; }
-
-        // Grab a task off the list.
-        Task task = mTasks.front();
-        mTasks.pop();
-
-        // Done with task list for now.
-        lock.unlock();
-
-        // Do the task.
-        task.task(task.context);
-
-        // After the task is done, run callback on main thread.
-        ThreadUtil::RunOnMainThread(task.callback);
-    }
-}
-
-ThreadedTaskQueue ThreadPool::sTaskQueue;
-
-void ThreadPool::Init(int threadCount)
-{
-    sTaskQueue.AddThreads(threadCount);
-}
-
-void ThreadPool::Shutdown()
-{
-    sTaskQueue.Shutdown();
+    });
 }
-
-void ThreadPool::AddTask(std::function<void()> task, std::function<void()> callback)
-{
-    sTaskQueue.AddTask(task, callback);
-}
-
-void ThreadPool::AddTask(std::function<void(void*)> task, void* context, std::function<void()> callback)
-{
-    sTaskQueue.AddTask(task, context, callback);
-}
\ No newline at end of file
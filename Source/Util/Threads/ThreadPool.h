@@ -4,73 +4,35 @@
 // A thread pool provides a generalized/simple way to run code on background threads.
 // Just add a task and the next available thread will do the work.
 //
+// Under the hood, tasks are jobs in a job system. Code that needs finer control
+// (job counters, dependencies, waiting on jobs) can use the job system directly.
+//
 #pragma once
-#include <condition_variable>
 #include <functional>
-#include <mutex>
-#include <queue>
-#include <vector>
 
+#include "JobSystem.h"
 #include "ThreadUtil.h"
 
-class ThreadedTaskQueue
-{
-public:
-    ThreadedTaskQueue(int threadCount = 0);
-    ~ThreadedTaskQueue();
-    
-    void AddThreads(int count);
-    void Shutdown();
-
-    void AddTask(std::function<void()> task, std::function<void()> callback = nullptr);
-    void AddTask(std::function<void(void*)> task, void* context = nullptr, std::function<void()> callback = nullptr);
-
-private:
-    struct Task
-    {
-        // The task and task context.
-        std::function<void(void*)> task;
-        void* context = nullptr;
-
-        // A callback for when the task completes.
-        std::function<void()> callback;
-
-        Task(std::function<void(void*)> task, void* context, std::function<void()> callback) :
-            task(task),
-            context(context),
-            callback(callback)
-        {
-
-        }
-    };
-
-    // Tasks waiting to be completed.
-    std::queue<Task> mTasks;
-
-    // If true, task queue is shutting down. Worker threads will exit.
-    bool mShutdown = false;
-
-    // Mutex/condition variable to deal with multi-threaded access to shared data.
-    std::mutex mMutex;
-    std::condition_variable mCondVar;
-
-    // Threads spawned for this task queue.
-    std::vector<std::thread> mThreads;
-
-    void TaskThread();
-};
-
 class ThreadPool
 {
 public:
-    static void Init(int threadCount);
+    // Frame threads only do work that's part of a frame (see GetFrameJobSystem). Without any, that work runs on the calling thread.
+    static void Init(int threadCount, int frameThreadCount = 0);
     static void Shutdown();
 
+    // Adds a task to run on a background thread. If provided, the callback runs on the main thread once the task is done.
     static void AddTask(std::function<void()> task, std::function<void()> callback = nullptr);
     static void AddTask(std::function<void(void*)> task, void* context = nullptr, std::function<void()> callback = nullptr);
 
+    static int GetThreadCount() { return sJobSystem.GetWorkerCount(); }
+    static JobSystem& GetJobSystem() { return sJobSystem; }
+
+    // Jobs that are part of a frame (e.g. per-frame update stages) go to their own job system.
+    // A thread waiting on frame work helps with any queued jobs - if those were background tasks, it could pick up (say) a whole asset load mid-frame.
+    static JobSystem& GetFrameJobSystem() { return sFrameJobSystem; }
+
 private:
-    // Just uses a threaded task queue internally.
-    // The thread pool is really just a static instance of a task queue!
-    static ThreadedTaskQueue sTaskQueue;
-};
\ No newline at end of file
+    // The thread pool is really just a static instance of a job system!
+    static JobSystem sJobSystem;
+    static JobSystem sFrameJobSystem;
+};
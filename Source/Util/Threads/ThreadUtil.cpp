@@ -1,9 +1,17 @@
 #include "ThreadUtil.h"
 
+#include "Profiler.h"
+
 std::thread::id ThreadUtil::sMainThreadId;
 
-std::vector<std::function<void()>> ThreadUtil::sMainThreadFuncs;
-std::mutex ThreadUtil::sMutex;
+MPSCQueue<std::function<void()>, ThreadUtil::kMainThreadFuncCapacity> ThreadUtil::sMainThreadFuncs;
+
+std::deque<std::function<void()>> ThreadUtil::sOverflowFuncs;
+std::mutex ThreadUtil::sOverflowMutex;
+std::atomic<uint32_t> ThreadUtil::sOverflowFuncCount { 0 };
+
+uint32_t ThreadUtil::sDeferredFuncCount = 0;
+uint64_t ThreadUtil::sTotalDeferredFuncCount = 0;
 
 void ThreadUtil::Init()
 {
@@ -24,22 +32,48 @@ void ThreadUtil::RunOnMainThread(std::function<void()> func)
         {
             func();
         }
-        else
+        else if(sOverflowFuncCount.load() > 0 || !sMainThreadFuncs.TryPush(std::move(func)))
         {
-            sMutex.lock();
-            sMainThreadFuncs.push_back(func);
-            sMutex.unlock();
+            std::lock_guard<std::mutex> lock(sOverflowMutex);
+            sOverflowFuncs.push_back(std::move(func));
+            ++sOverflowFuncCount;
         }
     }
 }
 
-void ThreadUtil::RunFunctionsOnMainThread()
+void ThreadUtil::RunFunctionsOnMainThread(float budgetMs)
 {
-    sMutex.lock();
-    for(auto& func : sMainThreadFuncs)
+    Stopwatch stopwatch;
+    bool outOfTime = false;
+
+    // Run functions from the queue first.
+    std::function<void()> func;
+    while(!outOfTime && sMainThreadFuncs.TryPop(func))
+    {
+        func();
+        outOfTime = stopwatch.GetMilliseconds() >= budgetMs;
+    }
+
+    // Then, any that overflowed (these were added when the queue was full, so they come after those in the queue).
+    while(!outOfTime)
     {
+        {
+            std::lock_guard<std::mutex> lock(sOverflowMutex);
+            if(sOverflowFuncs.empty()) { break; }
+            func = std::move(sOverflowFuncs.front());
+            sOverflowFuncs.pop_front();
+            --sOverflowFuncCount;
+        }
         func();
+        outOfTime = stopwatch.GetMilliseconds() >= budgetMs;
     }
-    sMainThreadFuncs.clear();
-    sMutex.unlock();
-}
\ No newline at end of file
+
+    // Keep track of how many functions have to wait until next time.
+    sDeferredFuncCount = 0;
+    if(outOfTime)
+    {
+        std::lock_guard<std::mutex> lock(sOverflowMutex);
+        sDeferredFuncCount = sMainThreadFuncs.Size() + static_cast<uint32_t>(sOverflowFuncs.size());
+        sTotalDeferredFuncCount += sDeferredFuncCount;
+    }
+}
@@ -4,10 +4,14 @@
 // Misc thread utilities.
 //
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <thread>
-#include <vector>
+
+#include "MPSCQueue.h"
 
 class ThreadUtil
 {
@@ -20,13 +24,33 @@ public:
 
     // A centralized way to allow threads to call back to the main thread.
     static void RunOnMainThread(std::function<void()> func);
-    static void RunFunctionsOnMainThread();
+
+    // Runs functions queued for the main thread, in the order they were queued.
+    // Stops once the time budget is used up (though at least one function always runs) - the rest wait until next time.
+    // This way, a burst of functions (e.g. many async loads finishing at once) is spread over several frames, rather than causing a hitch.
+    static void RunFunctionsOnMainThread(float budgetMs = 2.0f);
+
+    // Number of functions left waiting the last time functions were run on the main thread, and the total since startup.
+    static uint32_t GetDeferredFunctionCount() { return sDeferredFuncCount; }
+    static uint64_t GetTotalDeferredFunctionCount() { return sTotalDeferredFuncCount; }
 
 private:
     // The main thread's ID. Used to determine if functions are running on main thread.
     static std::thread::id sMainThreadId;
 
     // Functions that we want to run on main thread.
-    static std::vector<std::function<void()>> sMainThreadFuncs;
-    static std::mutex sMutex;
+    // Any thread can add to this queue without locking, so threads finishing work don't block each other (or the main thread).
+    static const uint32_t kMainThreadFuncCapacity = 4096;
+    static MPSCQueue<std::function<void()>, kMainThreadFuncCapacity> sMainThreadFuncs;
+
+    // In the rare case that the queue fills up, functions overflow to this list instead.
+    // Threads should never wait on the main thread to make room, since the main thread may be waiting on them.
+    // Until the overflow is drained, new functions are added to it as well - otherwise they'd jump ahead of older overflowed functions.
+    static std::deque<std::function<void()>> sOverflowFuncs;
+    static std::mutex sOverflowMutex;
+    static std::atomic<uint32_t> sOverflowFuncCount;
+
+    // Tracks functions deferred to a later frame due to the time budget.
+    static uint32_t sDeferredFuncCount;
+    static uint64_t sTotalDeferredFuncCount;
 };
@@ -3,10 +3,12 @@
 //
 // Thread for decoding audio data to the audio frame queue.
 //
+#include "Profiler.h"
 #include "VideoState.h"
 
 int DecodeAudioThread(void* arg)
 {
+    Profiler::SetThreadName("Video Audio Decode");
     VideoState* is = static_cast<VideoState*>(arg);
     
     // Allocate frame or fail.
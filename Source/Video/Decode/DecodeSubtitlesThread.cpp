@@ -3,10 +3,12 @@
 //
 // Thread for decoding subtitle data to the subtitle frame queue.
 //
+#include "Profiler.h"
 #include "VideoState.h"
 
 int DecodeSubtitlesThread(void* arg)
 {
+    Profiler::SetThreadName("Video Subtitle Decode");
     VideoState* is = static_cast<VideoState*>(arg);
     
     // Loop, decoding subtitles and putting in frame queue.
@@ -3,6 +3,7 @@
 //
 // Thread for decoding video data to the video frame queue.
 //
+#include "Profiler.h"
 #include "VideoState.h"
 
 static int get_video_frame(VideoState *is, AVFrame *frame)
@@ -46,6 +47,7 @@ static int get_video_frame(VideoState *is, AVFrame *frame)
 
 int DecodeVideoThread(void* arg)
 {
+    Profiler::SetThreadName("Video Decode");
     VideoState* is = static_cast<VideoState*>(arg);
     
     // Allocate frame or fail.
@@ -1,6 +1,7 @@
 #include "Decoder.h"
 
 #include "FrameQueue.h"
+#include "Profiler.h"
 #include "PacketQueue.h"
 #include "VideoState.h"
 
@@ -97,7 +98,9 @@ int Decoder::DecodeFrame(AVFrame* frame, AVSubtitle* sub)
                 // Attempt to receive a frame.
                 // Returns 0 when a frame is returned.
                 // Returns EAGAIN when there's no data to receive (meaning we must send it some packets first).
+                PROFILER_BEGIN_SAMPLE("Decoder Receive Frame");
                 ret = avcodec_receive_frame(mCodecContext, frame);
+                PROFILER_END_SAMPLE();
                 
                 // Get a decoded frame!
                 if(ret >= 0)
@@ -246,7 +249,10 @@ int Decoder::DecodeFrame(AVFrame* frame, AVSubtitle* sub)
             {
                 // Send packet to the decoder.
                 // If it tells us EAGAIN for some reason, put as pending packet to try again on next loop.
-                if(avcodec_send_packet(mCodecContext, &avPacket) == AVERROR(EAGAIN))
+                PROFILER_BEGIN_SAMPLE("Decoder Send Packet");
+                int sendResult = avcodec_send_packet(mCodecContext, &avPacket);
+                PROFILER_END_SAMPLE();
+                if(sendResult == AVERROR(EAGAIN))
                 {
                     av_log(mCodecContext, AV_LOG_ERROR, "Receive_frame and send_packet both returned EAGAIN, which is an API violation.\n");
                     mPacketPending = true;
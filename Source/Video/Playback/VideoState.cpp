@@ -8,6 +8,7 @@ extern "C"
 }
 
 #include "AudioPlaybackSDL.h"
+#include "Profiler.h"
 #include "VideoPlayback.h"
 
 #define MAX_QUEUE_SIZE (15 * 1024 * 1024)
@@ -421,6 +422,7 @@ static bool stream_has_enough_packets(AVStream *st, int stream_id, PacketQueue*
 // In other words, performs "demuxing" of video data.
 /*static*/ int VideoState::ReadThread(void* arg)
 {
+    Profiler::SetThreadName("Video Read");
     VideoState* is = static_cast<VideoState*>(arg);
     
     // Create wait mutex or fail.
@@ -521,7 +523,9 @@ static bool stream_has_enough_packets(AVStream *st, int stream_id, PacketQueue*
         }
         
         // Attempt to read the next packet.
+        PROFILER_BEGIN_SAMPLE("Video Read Packet");
         int ret = av_read_frame(is->format, &avPacket);
+        PROFILER_END_SAMPLE();
         if(ret < 0)
         {
             // If reached end of file, enqueue EOF packets in each packet queue.
@@ -2,6 +2,7 @@
 
 #include "Actor.h"
 #include "AssetManager.h"
+#include "MemoryTracker.h"
 #include "ReportManager.h"
 #include "Texture.h"
 #include "UICanvas.h"
@@ -56,6 +57,8 @@ void VideoPlayer::Initialize()
 
 void VideoPlayer::Update()
 {
+    MemoryTagScope memoryTag(MemoryTag::Video);
+
     // Update video playback and video texture.
     if(mVideo != nullptr)
     {
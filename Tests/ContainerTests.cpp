@@ -5,6 +5,10 @@
 //
 #include "catch.hh"
 
+#include <thread>
+#include <vector>
+
+#include "MPSCQueue.h"
 #include "Queue.h"
 #include "ResizableQueue.h"
 #include "Stack.h"
@@ -185,4 +189,67 @@ TEST_CASE("Queue (resizable) works")
 TEST_CASE("Stack (fixed size) works")
 {
     Stack<TestObject, 10> stack;
-}
\ No newline at end of file
+}
+
+TEST_CASE("Queue (multiple producer, single consumer) works")
+{
+    // Test pushing and popping on a single thread, including filling it up and wrapping around.
+    MPSCQueue<int, 8> queue;
+    REQUIRE(queue.Size() == 0);
+    REQUIRE(queue.Capacity() == 8);
+    int value = -1;
+    REQUIRE(!queue.TryPop(value));
+    for(int lap = 0; lap < 3; ++lap)
+    {
+        for(int i = 0; i < 8; ++i)
+        {
+            REQUIRE(queue.TryPush(int(i)));
+        }
+        REQUIRE(queue.Size() == 8);
+        REQUIRE(!queue.TryPush(100));
+        for(int i = 0; i < 8; ++i)
+        {
+            REQUIRE(queue.TryPop(value));
+            REQUIRE(value == i);
+        }
+        REQUIRE(!queue.TryPop(value));
+    }
+
+    // Push from many threads while popping on this one. Each thread's values should come out in order, with none lost.
+    MPSCQueue<int, 64> sharedQueue;
+    const int kThreadCount = 4;
+    const int kValuesPerThread = 10000;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < kThreadCount; ++t)
+    {
+        threads.emplace_back([&sharedQueue, t]() {
+            for(int i = 0; i < kValuesPerThread; ++i)
+            {
+                while(!sharedQueue.TryPush(t * kValuesPerThread + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> nextValues(kThreadCount, 0);
+    int poppedCount = 0;
+    bool inOrder = true;
+    while(poppedCount < kThreadCount * kValuesPerThread)
+    {
+        if(sharedQueue.TryPop(value))
+        {
+            int thread = value / kValuesPerThread;
+            inOrder &= (value % kValuesPerThread) == nextValues[thread];
+            ++nextValues[thread];
+            ++poppedCount;
+        }
+    }
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(inOrder);
+    REQUIRE(!sharedQueue.TryPop(value));
+}
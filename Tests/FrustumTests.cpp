@@ -0,0 +1,68 @@
+//
+// FrustumTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for Frustum class.
+//
+#include "catch.hh"
+#include "AABB.h"
+#include "Frustum.h"
+#include "GMath.h"
+#include "RenderTransforms.h"
+
+TEST_CASE("Frustum contains points")
+{
+    // An orthographic frustum is just a box: 20 units wide/tall, from 1 to 100 units along the view direction (+Z).
+    Frustum frustum(RenderTransforms::MakeOrthographic(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 100.0f));
+    REQUIRE(frustum.ContainsPoint(Vector3(0.0f, 0.0f, 50.0f)));
+    REQUIRE(frustum.ContainsPoint(Vector3(-9.0f, 9.0f, 2.0f)));
+    REQUIRE_FALSE(frustum.ContainsPoint(Vector3(0.0f, 0.0f, 0.0f)));
+    REQUIRE_FALSE(frustum.ContainsPoint(Vector3(0.0f, 0.0f, 101.0f)));
+    REQUIRE_FALSE(frustum.ContainsPoint(Vector3(11.0f, 0.0f, 50.0f)));
+    REQUIRE_FALSE(frustum.ContainsPoint(Vector3(0.0f, -11.0f, 50.0f)));
+}
+
+TEST_CASE("Frustum intersects AABBs")
+{
+    Frustum frustum(RenderTransforms::MakeOrthographic(-10.0f, 10.0f, -10.0f, 10.0f, 1.0f, 100.0f));
+
+    // Fully inside.
+    REQUIRE(frustum.IntersectsAABB(AABB(Vector3(-1.0f, -1.0f, 10.0f), Vector3(1.0f, 1.0f, 12.0f))));
+
+    // Partially inside, crossing a side or the near plane.
+    REQUIRE(frustum.IntersectsAABB(AABB(Vector3(8.0f, -1.0f, 10.0f), Vector3(12.0f, 1.0f, 12.0f))));
+    REQUIRE(frustum.IntersectsAABB(AABB(Vector3(-1.0f, -1.0f, -5.0f), Vector3(1.0f, 1.0f, 5.0f))));
+
+    // Contains the entire frustum.
+    REQUIRE(frustum.IntersectsAABB(AABB(Vector3(-500.0f, -500.0f, -500.0f), Vector3(500.0f, 500.0f, 500.0f))));
+
+    // Fully outside on various sides.
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(11.0f, -1.0f, 10.0f), Vector3(12.0f, 1.0f, 12.0f))));
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(-1.0f, -15.0f, 10.0f), Vector3(1.0f, -11.0f, 12.0f))));
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(-1.0f, -1.0f, -10.0f), Vector3(1.0f, 1.0f, 0.0f))));
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(-1.0f, -1.0f, 150.0f), Vector3(1.0f, 1.0f, 160.0f))));
+}
+
+TEST_CASE("Perspective frustum intersects AABBs")
+{
+    // A world space frustum, for a camera at (0, 0, -10) looking down +X with a 90 degree field of view.
+    Matrix4 viewMatrix = RenderTransforms::MakeLookAt(Vector3(0.0f, 0.0f, -10.0f), Vector3(10.0f, 0.0f, -10.0f), Vector3::UnitY);
+    Matrix4 projectionMatrix = RenderTransforms::MakePerspective(Math::kPiOver2, 1.0f, 1.0f, 100.0f);
+    Frustum frustum(projectionMatrix * viewMatrix);
+
+    // In front of the camera.
+    REQUIRE(frustum.IntersectsAABB(AABB(Vector3(20.0f, -1.0f, -11.0f), Vector3(22.0f, 1.0f, -9.0f))));
+
+    // Off to the side, but still within the (widening) field of view further away.
+    REQUIRE(frustum.IntersectsAABB(AABB(Vector3(50.0f, -1.0f, 20.0f), Vector3(52.0f, 1.0f, 22.0f))));
+
+    // Behind the camera.
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(-22.0f, -1.0f, -11.0f), Vector3(-20.0f, 1.0f, -9.0f))));
+
+    // Off to the side, outside the field of view.
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(5.0f, -1.0f, 20.0f), Vector3(7.0f, 1.0f, 22.0f))));
+
+    // Beyond the far plane.
+    REQUIRE_FALSE(frustum.IntersectsAABB(AABB(Vector3(120.0f, -1.0f, -11.0f), Vector3(122.0f, 1.0f, -9.0f))));
+}
@@ -0,0 +1,192 @@
+//
+// Clark Kromenaker
+//
+// Tests for the job system and task graph.
+//
+#include "catch.hh"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "JobSystem.h"
+#include "TaskGraph.h"
+
+TEST_CASE("Job system runs all jobs before a wait on their counter returns")
+{
+    JobSystem jobSystem(4);
+
+    std::atomic<int> sum { 0 };
+    JobCounter counter;
+    for(int i = 1; i <= 1000; ++i)
+    {
+        jobSystem.Run([&sum, i]() { sum += i; }, &counter);
+    }
+    jobSystem.Wait(counter);
+    REQUIRE(counter.IsDone());
+    REQUIRE(sum == 500500);
+}
+
+TEST_CASE("Job system runs jobs inline without workers")
+{
+    // No workers started, so jobs run right away on this thread.
+    JobSystem jobSystem;
+    REQUIRE(jobSystem.GetWorkerCount() == 0);
+
+    int value = 0;
+    JobCounter counter;
+    jobSystem.Run([&value]() { value = 42; }, &counter);
+    REQUIRE(value == 42);
+    REQUIRE(counter.IsDone());
+}
+
+TEST_CASE("Job system runs dependent jobs after their dependencies")
+{
+    JobSystem jobSystem(4);
+
+    // Jobs in the first group write values, jobs in the second group read them.
+    std::vector<int> values(64, 0);
+    std::atomic<int> correctCount { 0 };
+    JobCounter writeCounter;
+    JobCounter readCounter;
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        jobSystem.Run([&values, i]() { values[i] = static_cast<int>(i) * 2; }, &writeCounter);
+    }
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+        jobSystem.RunAfter(writeCounter, [&values, &correctCount, i]() {
+            if(values[i] == static_cast<int>(i) * 2)
+            {
+                ++correctCount;
+            }
+        }, &readCounter);
+    }
+    jobSystem.Wait(readCounter);
+    REQUIRE(writeCounter.IsDone());
+    REQUIRE(correctCount == static_cast<int>(values.size()));
+
+    // Depending on a counter that's already done runs the job right away.
+    JobCounter lateCounter;
+    bool ran = false;
+    jobSystem.RunAfter(writeCounter, [&ran]() { ran = true; }, &lateCounter);
+    jobSystem.Wait(lateCounter);
+    REQUIRE(ran);
+}
+
+TEST_CASE("Job system supports jobs that spawn jobs and large functions")
+{
+    JobSystem jobSystem(2);
+
+    // Functions too big to store inline in a job are allocated separately.
+    struct BigData { int values[64]; };
+    BigData bigData;
+    for(int i = 0; i < 64; ++i)
+    {
+        bigData.values[i] = i;
+    }
+
+    std::atomic<int> sum { 0 };
+    JobCounter counter;
+    jobSystem.Run([&jobSystem, &sum, &counter, bigData]() {
+        for(int i = 0; i < 64; ++i)
+        {
+            int value = bigData.values[i];
+            jobSystem.Run([&sum, value]() { sum += value; }, &counter);
+        }
+    }, &counter);
+    jobSystem.Wait(counter);
+    REQUIRE(sum == 2016);
+}
+
+TEST_CASE("Job system runs queued jobs on shutdown")
+{
+    JobSystem jobSystem(1);
+
+    // Keep the only worker busy, so the other jobs are still queued when shutting down.
+    std::atomic<int> sum { 0 };
+    JobCounter counter;
+    JobCounter afterCounter;
+    jobSystem.Run([]() { std::this_thread::sleep_for(std::chrono::milliseconds(20)); }, &counter);
+    for(int i = 1; i <= 100; ++i)
+    {
+        jobSystem.Run([&sum, i]() { sum += i; }, &counter);
+    }
+    jobSystem.RunAfter(counter, [&sum]() { sum += 1000; }, &afterCounter);
+    jobSystem.Shutdown();
+
+    // Every job ran, so both counters are released - nobody waiting on them would be stuck.
+    REQUIRE(counter.IsDone());
+    REQUIRE(afterCounter.IsDone());
+    REQUIRE(sum == 6050);
+    jobSystem.Wait(afterCounter);
+}
+
+TEST_CASE("Parallel for visits every index exactly once")
+{
+    JobSystem jobSystem(4);
+
+    std::vector<int> visitCounts(1000, 0);
+    jobSystem.ParallelFor(0, visitCounts.size(), [&visitCounts](size_t i) {
+        ++visitCounts[i];
+    });
+    for(size_t i = 0; i < visitCounts.size(); ++i)
+    {
+        REQUIRE(visitCounts[i] == 1);
+    }
+
+    // Sub-ranges, big batches, and empty ranges work too.
+    std::atomic<int> sum { 0 };
+    jobSystem.ParallelFor(10, 20, [&sum](size_t i) { sum += static_cast<int>(i); }, 100);
+    REQUIRE(sum == 145);
+    jobSystem.ParallelFor(5, 5, [&sum](size_t i) { sum = -1; });
+    REQUIRE(sum == 145);
+}
+
+TEST_CASE("Task graph orders stages by their reads and writes")
+{
+    JobSystem jobSystem(4);
+
+    std::vector<int> values(256, 0);
+    std::atomic<int> sumA { 0 };
+    std::atomic<int> sumB { 0 };
+    std::thread::id mainThreadId = std::this_thread::get_id();
+    bool finalStageOnMainThread = false;
+    int total = 0;
+
+    TaskGraph graph;
+    graph.AddStage("Write", [&]() {
+        jobSystem.ParallelFor(0, values.size(), [&values](size_t i) { values[i] = 1; });
+    }, {}, { "Values" });
+
+    // These two only read, so they can run at the same time.
+    graph.AddStage("Read A", [&]() {
+        for(int value : values) { sumA += value; }
+    }, { "Values" }, { "SumA" });
+    graph.AddStage("Read B", [&]() {
+        for(int value : values) { sumB += value * 2; }
+    }, { "Values" }, { "SumB" });
+
+    // Writing the values must wait for both readers. Combining the sums must wait for everything.
+    graph.AddStage("Rewrite", [&]() {
+        for(int& value : values) { value = 0; }
+    }, {}, { "Values" });
+    int finalStage = graph.AddStage("Combine", [&]() {
+        finalStageOnMainThread = std::this_thread::get_id() == mainThreadId;
+        total = sumA + sumB;
+        for(int value : values) { total += value; }
+    }, { "SumA", "SumB", "Values" }, {}, true);
+    REQUIRE(graph.GetStageCount() == 5);
+    REQUIRE(graph.GetStageName(finalStage) == "Combine");
+
+    // Graphs can be executed repeatedly.
+    for(int i = 0; i < 3; ++i)
+    {
+        sumA = 0;
+        sumB = 0;
+        graph.Execute(jobSystem);
+        REQUIRE(total == 768);
+        REQUIRE(finalStageOnMainThread);
+    }
+}
@@ -5,11 +5,17 @@
 //
 #include "catch.hh"
 
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "PtrMath.h"
 #include "LinearAllocator.h"
 #include "FreestyleAllocator.h"
+#include "FrameAllocator.h"
+#include "MemoryTracker.h"
+#include "PoolAllocator.h"
+#include "ObjectPool.h"
 
 TEST_CASE("Pointer Add/Subtract/Diff are correct")
 {
@@ -265,3 +271,221 @@ TEST_CASE("Freestyle allocator basic alloc/dealloc works correctly")
     REQUIRE(allocator.GetFreeBlockSize(1) == 0); // there is no second free block
     #endif
 }
+
+TEST_CASE("Frame allocator works")
+{
+    FrameAllocator::Init(1024);
+    REQUIRE(FrameAllocator::GetCapacity() == 1024);
+    REQUIRE(FrameAllocator::GetAllocatedSize() == 0);
+
+    // Allocations come from the frame memory block, with the requested alignment.
+    void* alloc1 = FrameAllocator::Allocate(10, 1);
+    void* alloc2 = FrameAllocator::Allocate(8, 8);
+    REQUIRE(FrameAllocator::Owns(alloc1));
+    REQUIRE(FrameAllocator::Owns(alloc2));
+    REQUIRE(reinterpret_cast<uintptr_t>(alloc2) % 8 == 0);
+    REQUIRE(FrameAllocator::GetAllocatedSize() >= 18);
+
+    // Allocations that don't fit fail (and are counted).
+    REQUIRE(FrameAllocator::Allocate(2048) == nullptr);
+    REQUIRE(FrameAllocator::GetOverflowCount() == 1);
+
+    // Other threads don't get frame memory.
+    void* otherThreadAlloc = &alloc1;
+    std::thread otherThread([&otherThreadAlloc]() {
+        otherThreadAlloc = FrameAllocator::Allocate(4);
+    });
+    otherThread.join();
+    REQUIRE(otherThreadAlloc == nullptr);
+
+    // Resetting frees everything, and keeps track of what was used.
+    size_t allocatedSize = FrameAllocator::GetAllocatedSize();
+    FrameAllocator::Reset();
+    REQUIRE(FrameAllocator::GetAllocatedSize() == 0);
+    REQUIRE(FrameAllocator::GetLastFrameAllocatedSize() == allocatedSize);
+    REQUIRE(FrameAllocator::GetPeakAllocatedSize() == allocatedSize);
+
+    // Containers use frame memory when it fits, and the heap when it doesn't.
+    {
+        FrameVector<int> smallVector;
+        smallVector.reserve(16);
+        for(int i = 0; i < 16; ++i)
+        {
+            smallVector.push_back(i);
+        }
+        REQUIRE(FrameAllocator::Owns(smallVector.data()));
+        REQUIRE(smallVector[15] == 15);
+
+        FrameVector<int> bigVector(1000, 7);
+        REQUIRE(!FrameAllocator::Owns(bigVector.data()));
+        REQUIRE(bigVector[999] == 7);
+    }
+    FrameAllocator::Shutdown();
+    REQUIRE(FrameAllocator::GetCapacity() == 0);
+}
+
+TEST_CASE("Pool allocator works correctly")
+{
+    // Four 16-byte blocks (plus a bit extra, in case the buffer isn't aligned).
+    uint8_t memory[72];
+    PoolAllocator allocator(memory, sizeof(memory), 16, 8);
+    REQUIRE(allocator.GetBlockSize() == 16);
+    REQUIRE(allocator.GetBlockCount() >= 4);
+    size_t blockCount = allocator.GetBlockCount();
+
+    // Allocate every block - each is aligned and distinct.
+    std::vector<void*> blocks;
+    for(size_t i = 0; i < blockCount; ++i)
+    {
+        void* block = allocator.Allocate();
+        REQUIRE(block != nullptr);
+        REQUIRE(reinterpret_cast<uintptr_t>(block) % 8 == 0);
+        REQUIRE(allocator.Owns(block));
+        blocks.push_back(block);
+    }
+    REQUIRE(allocator.GetAllocationCount() == blockCount);
+    REQUIRE(allocator.Allocate() == nullptr);
+
+    // Freed blocks are reused, most recently freed first.
+    allocator.Deallocate(blocks[1]);
+    allocator.Deallocate(blocks[2]);
+    REQUIRE(allocator.GetAllocationCount() == blockCount - 2);
+    REQUIRE(allocator.Allocate() == blocks[2]);
+    REQUIRE(allocator.Allocate() == blocks[1]);
+
+    // Memory outside the pool (or not at the start of a block) isn't owned.
+    REQUIRE(!allocator.Owns(&allocator));
+    REQUIRE(!allocator.Owns(static_cast<uint8_t*>(blocks[0]) + 1));
+
+    // Reset frees everything.
+    allocator.Reset();
+    REQUIRE(allocator.GetAllocationCount() == 0);
+    REQUIRE(allocator.Allocate() == blocks[0]);
+}
+
+TEST_CASE("Object pool grows with stable addresses")
+{
+    struct TestObject
+    {
+        TestObject(int value) : value(value) { }
+        int value = 0;
+        std::string name = "Test";
+    };
+
+    ObjectPool pool("TestObject", sizeof(TestObject), alignof(TestObject), 4);
+    REQUIRE(pool.GetChunkCount() == 0);
+
+    // Filling the first chunk and then some adds more chunks - existing objects don't move.
+    std::vector<TestObject*> objects;
+    for(int i = 0; i < 10; ++i)
+    {
+        objects.push_back(pool.New<TestObject>(i));
+    }
+    REQUIRE(pool.GetChunkCount() == 3);
+    REQUIRE(pool.GetCapacity() == 12);
+    REQUIRE(pool.GetLiveCount() == 10);
+    for(int i = 0; i < 10; ++i)
+    {
+        REQUIRE(objects[i]->value == i);
+        REQUIRE(pool.Owns(objects[i]));
+    }
+
+    // Deleted objects free up blocks for new ones, without adding chunks.
+    TestObject* deleted = objects[5];
+    pool.Delete(deleted);
+    TestObject* replacement = pool.New<TestObject>(42);
+    REQUIRE(replacement == deleted);
+    REQUIRE(pool.GetChunkCount() == 3);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        pool.Delete(i == 5 ? replacement : objects[i]);
+    }
+    REQUIRE(pool.GetLiveCount() == 0);
+    REQUIRE(pool.GetPeakCount() == 10);
+    REQUIRE(pool.GetTotalAllocationCount() == 11);
+
+    // Pool shows up in stats output.
+    REQUIRE(ObjectPool::DumpAll().find("TestObject") != std::string::npos);
+}
+
+TEST_CASE("Sized object pools work")
+{
+    SizedObjectPools pools("TestSized", 64);
+
+    // Allocations of similar sizes share a pool.
+    void* small1 = pools.Allocate(10);
+    void* small2 = pools.Allocate(16);
+    void* medium = pools.Allocate(40);
+    REQUIRE(small1 != nullptr);
+    REQUIRE(small2 != nullptr);
+    REQUIRE(medium != nullptr);
+    REQUIRE(ObjectPool::DumpAll().find("TestSized/16") != std::string::npos);
+    REQUIRE(ObjectPool::DumpAll().find("TestSized/48") != std::string::npos);
+
+    // Too big for a pool - uses the heap.
+    void* big = pools.Allocate(100);
+    REQUIRE(big != nullptr);
+
+    pools.Deallocate(small1, 10);
+    pools.Deallocate(small2, 16);
+    pools.Deallocate(medium, 40);
+    pools.Deallocate(big, 100);
+
+    // Freed memory is reused.
+    REQUIRE(pools.Allocate(12) == small2);
+    pools.Deallocate(small2, 12);
+}
+
+TEST_CASE("Memory tracker counts allocations per tag")
+{
+    // Allocations are tagged with the innermost scope's tag.
+    REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::General);
+    {
+        MemoryTagScope outerScope(MemoryTag::Assets);
+        {
+            MemoryTagScope innerScope(MemoryTag::Video);
+            REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::Video);
+        }
+        REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::Assets);
+    }
+    REQUIRE(MemoryTracker::GetCurrentTag() == MemoryTag::General);
+
+    // Current, peak, and per-frame stats are tracked.
+    MemoryTracker::TagStats before = MemoryTracker::GetTagStats(MemoryTag::Audio);
+    MemoryTracker::OnAllocate(100, MemoryTag::Audio, nullptr);
+    MemoryTracker::OnAllocate(50, MemoryTag::Audio, nullptr);
+    MemoryTracker::OnDeallocate(100, MemoryTag::Audio);
+    MemoryTracker::EndFrame();
+
+    MemoryTracker::TagStats after = MemoryTracker::GetTagStats(MemoryTag::Audio);
+    REQUIRE(after.currentBytes == before.currentBytes + 50);
+    REQUIRE(after.peakBytes >= before.currentBytes + 150);
+    REQUIRE(after.currentAllocations == before.currentAllocations + 1);
+    REQUIRE(after.totalAllocations == before.totalAllocations + 2);
+    REQUIRE(after.lastFrameAllocations == 2);
+    MemoryTracker::OnDeallocate(50, MemoryTag::Audio);
+
+    // Call sites are only counted while tracking is enabled.
+    int callSite = 0;
+    MemoryTracker::ClearCallSites();
+    MemoryTracker::OnAllocate(8, MemoryTag::Audio, &callSite);
+    REQUIRE(MemoryTracker::GetTopCallSites(10).empty());
+
+    MemoryTracker::SetCallSiteTrackingEnabled(true);
+    for(int i = 0; i < 3; ++i)
+    {
+        MemoryTracker::OnAllocate(8, MemoryTag::Audio, &callSite);
+    }
+    MemoryTracker::SetCallSiteTrackingEnabled(false);
+    std::vector<MemoryTracker::CallSite> callSites = MemoryTracker::GetTopCallSites(10);
+    REQUIRE(callSites.size() == 1);
+    REQUIRE(callSites[0].address == &callSite);
+    REQUIRE(callSites[0].allocations == 3);
+    REQUIRE(callSites[0].bytes == 24);
+    for(int i = 0; i < 4; ++i)
+    {
+        MemoryTracker::OnDeallocate(8, MemoryTag::Audio);
+    }
+    REQUIRE(MemoryTracker::Dump().find("Audio") != std::string::npos);
+}
@@ -0,0 +1,93 @@
+//
+// Clark Kromenaker
+//
+// Tests for the profiler.
+//
+#include "catch.hh"
+
+#include <string>
+#include <thread>
+
+#include "Profiler.h"
+
+TEST_CASE("Profiler records nested samples per frame")
+{
+    // Nothing is recorded while the profiler is disabled.
+    Profiler::SetEnabled(false);
+    Profiler::BeginFrame();
+    {
+        PROFILER_SCOPED_NAMED("Disabled");
+    }
+    Profiler::EndFrame();
+    REQUIRE(Profiler::GetLastFrameSamples().empty());
+
+    // When enabled, the frame's samples are kept in the order they began, with nesting depth.
+    Profiler::SetEnabled(true);
+    uint64_t frameNumber = Profiler::GetFrameNumber();
+    Profiler::BeginFrame();
+    {
+        PROFILER_SCOPED_NAMED("Outer");
+        Profiler::BeginSample("Inner");
+        Profiler::EndSample();
+    }
+    Profiler::BeginSample("Second");
+    Profiler::EndSample();
+    Profiler::EndFrame();
+    REQUIRE(Profiler::GetFrameNumber() == frameNumber + 1);
+
+    const std::vector<Profiler::FrameSample>& samples = Profiler::GetLastFrameSamples();
+    REQUIRE(samples.size() == 4);
+    REQUIRE(std::string(samples[0].name) == "Frame");
+    REQUIRE(samples[0].depth == 0);
+    REQUIRE(std::string(samples[1].name) == "Outer");
+    REQUIRE(samples[1].depth == 1);
+    REQUIRE(std::string(samples[2].name) == "Inner");
+    REQUIRE(samples[2].depth == 2);
+    REQUIRE(std::string(samples[3].name) == "Second");
+    REQUIRE(samples[3].depth == 1);
+    REQUIRE(samples[0].durationMs >= samples[1].durationMs);
+    REQUIRE(samples[1].durationMs >= samples[2].durationMs);
+    Profiler::SetEnabled(false);
+}
+
+TEST_CASE("Profiler captures samples from all threads")
+{
+    Profiler::BeginCapture();
+    REQUIRE(Profiler::IsCapturing());
+    REQUIRE(Profiler::IsEnabled());
+
+    Profiler::BeginFrame();
+    {
+        PROFILER_SCOPED_NAMED("Main \"Work\"");
+    }
+    std::thread workerThread([]() {
+        Profiler::SetThreadName("Test Worker");
+        PROFILER_SCOPED_NAMED(Profiler::InternName(std::string("Worker") + "Sample"));
+    });
+    workerThread.join();
+    Profiler::EndFrame();
+
+    // All threads' samples show up in the trace, on named tracks.
+    std::string trace = Profiler::GetChromeTrace();
+    REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"Main \\\"Work\\\"\",\"cat\":\"gk3\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"WorkerSample\"") != std::string::npos);
+    REQUIRE(trace.find("\"args\":{\"name\":\"Test Worker\"}") != std::string::npos);
+
+    // Interned names are shared.
+    REQUIRE(Profiler::InternName("WorkerSample") == Profiler::InternName(std::string("WorkerSample")));
+
+    // Ending the capture clears out samples. Threads that have exited no longer need a track at all.
+    REQUIRE(!Profiler::EndCapture(""));
+    REQUIRE(!Profiler::IsCapturing());
+    REQUIRE(Profiler::GetChromeTrace().find("WorkerSample") == std::string::npos);
+    REQUIRE(Profiler::GetChromeTrace().find("Test Worker") == std::string::npos);
+
+    // Outside of a capture, a thread's track goes away as soon as the thread exits.
+    std::thread shortThread([]() {
+        Profiler::SetThreadName("Short Thread");
+    });
+    shortThread.join();
+    REQUIRE(Profiler::GetChromeTrace().find("Short Thread") == std::string::npos);
+    Profiler::SetEnabled(false);
+}
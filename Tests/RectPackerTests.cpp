@@ -0,0 +1,105 @@
+//
+// RectPackerTests.cpp
+//
+// Clark Kromenaker
+//
+// Tests for RectPacker.
+//
+#include "catch.hh"
+#include "RectPacker.h"
+
+#include <vector>
+
+namespace
+{
+    struct PackedRect
+    {
+        uint32_t x = 0;
+        uint32_t y = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+    };
+
+    bool Overlaps(const PackedRect& a, const PackedRect& b)
+    {
+        return a.x < b.x + b.width && b.x < a.x + a.width &&
+               a.y < b.y + b.height && b.y < a.y + a.height;
+    }
+}
+
+TEST_CASE("RectPacker places rects on shelves")
+{
+    RectPacker packer(64, 64);
+    uint32_t x = 0;
+    uint32_t y = 0;
+
+    // First rect starts a shelf in the corner.
+    REQUIRE(packer.Insert(32, 16, x, y));
+    REQUIRE(x == 0);
+    REQUIRE(y == 0);
+    REQUIRE(packer.GetUsedHeight() == 16);
+
+    // A shorter rect fits next to it on the same shelf.
+    REQUIRE(packer.Insert(16, 8, x, y));
+    REQUIRE(x == 32);
+    REQUIRE(y == 0);
+    REQUIRE(packer.GetUsedHeight() == 16);
+
+    // A rect too wide for the remaining shelf space starts a new shelf.
+    REQUIRE(packer.Insert(32, 8, x, y));
+    REQUIRE(x == 0);
+    REQUIRE(y == 16);
+    REQUIRE(packer.GetUsedHeight() == 24);
+
+    // A small rect goes on the shelf that wastes the least height.
+    REQUIRE(packer.Insert(8, 8, x, y));
+    REQUIRE(x == 32);
+    REQUIRE(y == 16);
+}
+
+TEST_CASE("RectPacker rejects rects that don't fit")
+{
+    RectPacker packer(32, 32);
+    uint32_t x = 0;
+    uint32_t y = 0;
+
+    // Bigger than the whole area.
+    REQUIRE_FALSE(packer.Insert(33, 1, x, y));
+    REQUIRE_FALSE(packer.Insert(1, 33, x, y));
+
+    // Exactly fills the area - after that, nothing else fits.
+    REQUIRE(packer.Insert(32, 32, x, y));
+    REQUIRE_FALSE(packer.Insert(1, 1, x, y));
+}
+
+TEST_CASE("RectPacker never overlaps rects")
+{
+    RectPacker packer(128, 128);
+
+    // Insert tallest first, as recommended.
+    std::vector<PackedRect> rects;
+    for(uint32_t height = 32; height >= 4; height -= 4)
+    {
+        for(uint32_t width = 4; width <= 24; width += 10)
+        {
+            PackedRect rect;
+            rect.width = width;
+            rect.height = height;
+            if(packer.Insert(width, height, rect.x, rect.y))
+            {
+                REQUIRE(rect.x + rect.width <= 128);
+                REQUIRE(rect.y + rect.height <= 128);
+                rects.push_back(rect);
+            }
+        }
+    }
+    REQUIRE(rects.size() == 24);
+
+    for(size_t i = 0; i < rects.size(); ++i)
+    {
+        for(size_t j = i + 1; j < rects.size(); ++j)
+        {
+            REQUIRE_FALSE(Overlaps(rects[i], rects[j]));
+        }
+    }
+}
@@ -0,0 +1,39 @@
+//
+// Clark Kromenaker
+//
+// Tests for render queue sort keys.
+//
+#include "catch.hh"
+
+#include "RenderQueue.h"
+
+TEST_CASE("Render queue sort keys order passes, state, and depth")
+{
+    // Fake (but suitably aligned) pointers - the keys only use the pointer values.
+    const Shader* shaderA = reinterpret_cast<const Shader*>(0x1000);
+    const Shader* shaderB = reinterpret_cast<const Shader*>(0x2000);
+    const Texture* textureA = reinterpret_cast<const Texture*>(0x3000);
+    const Texture* textureB = reinterpret_cast<const Texture*>(0x4000);
+
+    // All opaque draws come before all translucent draws.
+    uint64_t opaqueFar = RenderQueue::MakeSortKey(RenderQueue::Pass::Opaque, shaderB, textureB, 1000.0f);
+    uint64_t translucentNear = RenderQueue::MakeSortKey(RenderQueue::Pass::Translucent, shaderA, textureA, 1.0f);
+    REQUIRE(opaqueFar < translucentNear);
+
+    // Opaque draws group by shader, then texture, then go front-to-back.
+    uint64_t opaqueA = RenderQueue::MakeSortKey(RenderQueue::Pass::Opaque, shaderA, textureB, 1000.0f);
+    REQUIRE(opaqueA < opaqueFar);
+    uint64_t opaqueTextureA = RenderQueue::MakeSortKey(RenderQueue::Pass::Opaque, shaderB, textureA, 1000.0f);
+    REQUIRE(opaqueTextureA < opaqueFar);
+    uint64_t opaqueNear = RenderQueue::MakeSortKey(RenderQueue::Pass::Opaque, shaderB, textureB, 10.0f);
+    REQUIRE(opaqueNear < opaqueFar);
+    REQUIRE(RenderQueue::MakeSortKey(RenderQueue::Pass::Opaque, shaderB, textureB, 0.0f) < opaqueNear);
+
+    // Translucent draws go back-to-front, regardless of shader or texture.
+    uint64_t translucentFar = RenderQueue::MakeSortKey(RenderQueue::Pass::Translucent, shaderB, textureB, 1000.0f);
+    REQUIRE(translucentFar < translucentNear);
+
+    // With equal depth, translucent draws still group by shader.
+    uint64_t translucentNearB = RenderQueue::MakeSortKey(RenderQueue::Pass::Translucent, shaderB, textureA, 1.0f);
+    REQUIRE(translucentNear < translucentNearB);
+}